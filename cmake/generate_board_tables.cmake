@@ -0,0 +1,225 @@
+# Generates board_tables.hpp from assets/boards/*.json
+# Usage: cmake -DBOARD_DIR=<assets/boards> -DOUTPUT=<board_tables.hpp> -P generate_board_tables.cmake
+#
+# Every table is packed into plain integer arrays so the compiler only has to read them, the richer types in
+# board_data.hpp are built from these with a single cheap cast. Indices in the JSON start at 1
+
+cmake_minimum_required(VERSION 3.19)
+
+if(NOT DEFINED BOARD_DIR OR NOT DEFINED OUTPUT)
+    message(FATAL_ERROR "BOARD_DIR and OUTPUT must be set")
+endif()
+
+# Same order as BoardType
+set(boardNames autumn winter lake mountain)
+set(totalClearings 12)
+set(totalForests 12)
+math(EXPR lastClearing "${totalClearings} - 1")
+
+# Same values as clearing_data::ClearingType and landmark_data::Landmark
+set(clearingType_random 0)
+set(clearingType_mouse 1)
+set(clearingType_fox 2)
+set(clearingType_rabbit 3)
+
+set(landmark_blackMarket 1)
+set(landmark_ferry 2)
+set(landmark_legendaryForge 3)
+set(landmark_lostCity 4)
+set(landmark_tower 5)
+
+function(add_bit maskVar index)
+    math(EXPR mask "${${maskVar}} | (1 << ${index})" OUTPUT_FORMAT HEXADECIMAL)
+    set(${maskVar} ${mask} PARENT_SCOPE)
+endfunction()
+
+function(has_bit outVar mask index)
+    math(EXPR bit "(${mask} >> ${index}) & 1")
+    set(${outVar} ${bit} PARENT_SCOPE)
+endfunction()
+
+# Reads a 1 based index from the JSON and returns it 0 based, failing if it is not below limit
+function(get_index outVar limit what)
+    math(EXPR zeroBased "${ARGN} - 1")
+    if(zeroBased LESS 0 OR zeroBased GREATER_EQUAL limit)
+        message(FATAL_ERROR "${boardName}: ${what} index ${ARGN} is out of range")
+    endif()
+    set(${outVar} ${zeroBased} PARENT_SCOPE)
+endfunction()
+
+foreach(table land water closedPaths clearingForests forestClearings slotCounts landmarks clearingTypes ruins)
+    set(${table}Rows "")
+endforeach()
+
+foreach(boardName IN LISTS boardNames)
+    file(READ "${BOARD_DIR}/${boardName}.json" json)
+
+    string(JSON clearingCount LENGTH "${json}" Clearings)
+    if(NOT clearingCount EQUAL totalClearings)
+        message(FATAL_ERROR "${boardName}: expected ${totalClearings} clearings, found ${clearingCount}")
+    endif()
+
+    set(ruinMask 0)
+    foreach(clearing RANGE ${lastClearing})
+        set(land_${clearing} 0)
+        set(water_${clearing} 0)
+        set(closedPaths_${clearing} 0)
+        set(clearingForests_${clearing} 0)
+        set(forestClearings_${clearing} 0)
+    endforeach()
+
+    set(slotCountRow "")
+    set(landmarkRow "")
+    set(clearingTypeRow "")
+    foreach(clearing RANGE ${lastClearing})
+        string(JSON typeName GET "${json}" Clearings ${clearing} clearingType)
+        if(NOT DEFINED clearingType_${typeName})
+            message(FATAL_ERROR "${boardName}: clearing ${clearing} has unknown type ${typeName}")
+        endif()
+        list(APPEND clearingTypeRow ${clearingType_${typeName}})
+
+        string(JSON slotCount GET "${json}" Clearings ${clearing} buildingSlots)
+        list(APPEND slotCountRow ${slotCount})
+
+        string(JSON hasRuin GET "${json}" Clearings ${clearing} startingRuin)
+        if(hasRuin)
+            add_bit(ruinMask ${clearing})
+        endif()
+
+        string(JSON connectionCount LENGTH "${json}" Clearings ${clearing} clearingConnections)
+        if(connectionCount GREATER 0)
+            math(EXPR lastConnection "${connectionCount} - 1")
+            foreach(connection RANGE ${lastConnection})
+                string(JSON rawIndex GET "${json}" Clearings ${clearing} clearingConnections ${connection} index)
+                string(JSON connectionType GET "${json}" Clearings ${clearing} clearingConnections ${connection} type)
+                get_index(destination ${totalClearings} "clearing" ${rawIndex})
+                if(destination EQUAL clearing)
+                    message(FATAL_ERROR "${boardName}: clearing ${clearing} connects to itself")
+                endif()
+
+                if(connectionType STREQUAL "normal")
+                    add_bit(land_${clearing} ${destination})
+                elseif(connectionType STREQUAL "water")
+                    add_bit(water_${clearing} ${destination})
+                elseif(connectionType STREQUAL "blocked")
+                    add_bit(closedPaths_${clearing} ${destination})
+                else()
+                    message(FATAL_ERROR "${boardName}: clearing ${clearing} has unknown connection type ${connectionType}")
+                endif()
+            endforeach()
+        endif()
+
+        string(JSON forestCount LENGTH "${json}" Clearings ${clearing} forestConnections)
+        if(forestCount GREATER 0)
+            math(EXPR lastForest "${forestCount} - 1")
+            foreach(forestEntry RANGE ${lastForest})
+                string(JSON rawIndex GET "${json}" Clearings ${clearing} forestConnections ${forestEntry})
+                get_index(forest ${totalForests} "forest" ${rawIndex})
+                add_bit(clearingForests_${clearing} ${forest})
+            endforeach()
+        endif()
+
+        string(JSON landmarkCount LENGTH "${json}" Clearings ${clearing} startingLandmarks)
+        if(landmarkCount EQUAL 0)
+            list(APPEND landmarkRow 0)
+        elseif(landmarkCount EQUAL 1)
+            string(JSON landmarkName GET "${json}" Clearings ${clearing} startingLandmarks 0)
+            if(NOT DEFINED landmark_${landmarkName})
+                message(FATAL_ERROR "${boardName}: clearing ${clearing} has unknown landmark ${landmarkName}")
+            endif()
+            list(APPEND landmarkRow ${landmark_${landmarkName}})
+        else()
+            message(FATAL_ERROR "${boardName}: clearing ${clearing} starts with more than one landmark")
+        endif()
+    endforeach()
+
+    string(JSON forestCount LENGTH "${json}" Forests)
+    if(forestCount GREATER totalForests)
+        message(FATAL_ERROR "${boardName}: expected at most ${totalForests} forests, found ${forestCount}")
+    endif()
+    if(forestCount GREATER 0)
+        math(EXPR lastForest "${forestCount} - 1")
+        foreach(forest RANGE ${lastForest})
+            string(JSON borderCount LENGTH "${json}" Forests ${forest} clearingConnections)
+            if(borderCount GREATER 0)
+                math(EXPR lastBorder "${borderCount} - 1")
+                foreach(border RANGE ${lastBorder})
+                    string(JSON rawIndex GET "${json}" Forests ${forest} clearingConnections ${border})
+                    get_index(clearing ${totalClearings} "clearing" ${rawIndex})
+                    add_bit(forestClearings_${forest} ${clearing})
+                endforeach()
+            endif()
+        endforeach()
+    endif()
+
+    # Both ends of every connection and both forest lists have to agree, otherwise the tables would depend on
+    # which side the engine happened to look from
+    foreach(origin RANGE ${lastClearing})
+        foreach(destination RANGE ${lastClearing})
+            foreach(kind land water closedPaths)
+                has_bit(forward ${${kind}_${origin}} ${destination})
+                has_bit(backward ${${kind}_${destination}} ${origin})
+                if(NOT forward EQUAL backward)
+                    message(FATAL_ERROR "${boardName}: ${kind} connection between clearings ${origin} and ${destination} is only listed from one side")
+                endif()
+            endforeach()
+
+            has_bit(fromClearing ${clearingForests_${origin}} ${destination})
+            has_bit(fromForest ${forestClearings_${destination}} ${origin})
+            if(NOT fromClearing EQUAL fromForest)
+                message(FATAL_ERROR "${boardName}: clearing ${origin} and forest ${destination} disagree about bordering each other")
+            endif()
+        endforeach()
+    endforeach()
+
+    foreach(table land water closedPaths clearingForests forestClearings)
+        set(row "")
+        foreach(clearing RANGE ${lastClearing})
+            list(APPEND row ${${table}_${clearing}})
+        endforeach()
+        list(JOIN row ", " row)
+        string(APPEND ${table}Rows "    {${row}}, // ${boardName}\n")
+    endforeach()
+
+    list(JOIN slotCountRow ", " slotCountRow)
+    list(JOIN landmarkRow ", " landmarkRow)
+    list(JOIN clearingTypeRow ", " clearingTypeRow)
+    string(APPEND slotCountsRows "    {${slotCountRow}}, // ${boardName}\n")
+    string(APPEND landmarksRows "    {${landmarkRow}}, // ${boardName}\n")
+    string(APPEND clearingTypesRows "    {${clearingTypeRow}}, // ${boardName}\n")
+    string(APPEND ruinsRows "    ${ruinMask}, // ${boardName}\n")
+endforeach()
+
+list(LENGTH boardNames totalBoards)
+
+set(header "// Generated by cmake/generate_board_tables.cmake from assets/boards, do not edit\n")
+string(APPEND header "#pragma once\n\n#include <array>\n#include <cstdint>\n\n")
+string(APPEND header "namespace game_data\n{\nnamespace board_data\n{\nnamespace generated\n{\n\n")
+string(APPEND header "template <typename T>\nusing BoardRows = std::array<std::array<T, ${totalClearings}>, ${totalBoards}>;\n\n")
+
+string(APPEND header "// Bit i set = clearing i\n")
+string(APPEND header "static constexpr BoardRows<uint16_t> kLandMasks{{\n${landRows}}};\n\n")
+string(APPEND header "static constexpr BoardRows<uint16_t> kWaterMasks{{\n${waterRows}}};\n\n")
+string(APPEND header "// Paths that start closed, not part of kLandMasks\n")
+string(APPEND header "static constexpr BoardRows<uint16_t> kClosedPathMasks{{\n${closedPathsRows}}};\n\n")
+string(APPEND header "// Bit i set = forest i\n")
+string(APPEND header "static constexpr BoardRows<uint16_t> kClearingForestMasks{{\n${clearingForestsRows}}};\n\n")
+string(APPEND header "// Indexed by forest, bit i set = clearing i\n")
+string(APPEND header "static constexpr BoardRows<uint16_t> kForestClearingMasks{{\n${forestClearingsRows}}};\n\n")
+string(APPEND header "static constexpr BoardRows<uint8_t> kBuildingSlotCounts{{\n${slotCountsRows}}};\n\n")
+string(APPEND header "// landmark_data::Landmark values\n")
+string(APPEND header "static constexpr BoardRows<uint8_t> kLandmarks{{\n${landmarksRows}}};\n\n")
+string(APPEND header "// ClearingType values\n")
+string(APPEND header "static constexpr BoardRows<uint8_t> kClearingTypes{{\n${clearingTypesRows}}};\n\n")
+string(APPEND header "// Bit i set = clearing i starts with a ruin\n")
+string(APPEND header "static constexpr std::array<uint16_t, ${totalBoards}> kRuinMasks{{\n${ruinsRows}}};\n")
+string(APPEND header "} // generated\n} // board_data\n} // game_data\n")
+
+# Leave an unchanged header alone so everything including it is not rebuilt
+if(EXISTS "${OUTPUT}")
+    file(READ "${OUTPUT}" previous)
+    if(previous STREQUAL header)
+        return()
+    endif()
+endif()
+file(WRITE "${OUTPUT}" "${header}")
@@ -0,0 +1,230 @@
+#pragma once
+
+#include "game_data.hpp"
+#include "card_data.hpp"
+#include "clearing_data.hpp"
+#include "board_data.hpp"
+
+#include <algorithm>
+#include <array>
+#include <compare>
+#include <cstdint>
+#include <cstddef>
+#include <expected>
+#include <span>
+#include <string_view>
+#include <type_traits>
+
+namespace game_data
+{
+namespace action
+{
+
+namespace card_data = ::game_data::card_data;
+namespace board_data = ::game_data::board_data;
+namespace building_data = ::game_data::board_data::clearing_data::building_data;
+using ::game_data::faction_data::FactionID;
+
+struct ActionError {
+    enum class Code : uint8_t {
+        kListFull,
+        kUnknownError
+    } code;
+
+    static constexpr std::array<std::string_view, 2> kMessages = {
+        "Action list cannot hold another action",
+        "Unknown error"
+    };
+
+    [[nodiscard]] static std::string_view to_string(Code code) {
+        uint8_t idx = static_cast<uint8_t>(code);
+        [[likely]] if (idx < kMessages.size()) return kMessages[idx];
+        return kMessages.back();
+    }
+
+    [[nodiscard]] inline std::string_view message() const { return to_string(code); }
+};
+
+// What an action does. Verbs for the other factions join as their move generators do
+enum class Verb : uint8_t
+{
+    // Ends the current step or phase without doing anything else in it
+    kPass,
+    // Setup
+    kChooseFaction,
+    kPlaceKeep,
+    kPlaceStartingBuilding,
+    // Shared by every faction
+    kMove,
+    kBattle,
+    kRecruit,
+    kBuild,
+    kCraft,
+    kDiscard,
+    kActivateDominance,
+    // Marquise de Cat
+    kPlaceWood,
+    kMarch,
+    kOverwork,
+    kMaxVerb // for bounds checking
+};
+
+/*
+    Every field an action can need in one 32 bit word, from the high bits down:
+
+        faction 4 | verb 5 | origin 4 | destination 4 | count 5 | card 6 | building 4
+
+    Fields an action does not use hold their none value, so an action has exactly one encoding and equal actions
+    compare equal as words. Comparing the words orders actions by faction, then verb, then the remaining fields, which
+    is the stable order ActionList::sort puts legal moves in.
+
+    Ruins are never built, so the building field holds the building minus one. All 16 values are buildings, leaving
+    no none value: a Workshop and no building both encode as 0. Only kBuild and kPlaceStartingBuilding carry a
+    building, get_building reports kRuin for every other verb
+*/
+class Action
+{
+public:
+    static constexpr uint8_t kFactionBits = 4;
+    static constexpr uint8_t kVerbBits = 5;
+    static constexpr uint8_t kClearingBits = 4;
+    static constexpr uint8_t kCountBits = 5;
+    static constexpr uint8_t kCardBits = card_data::kCardIDBits;
+    static constexpr uint8_t kBuildingBits = 4;
+
+    static constexpr uint8_t kBuildingShift = 0;
+    static constexpr uint8_t kCardShift = kBuildingShift + kBuildingBits;
+    static constexpr uint8_t kCountShift = kCardShift + kCardBits;
+    static constexpr uint8_t kDestinationShift = kCountShift + kCountBits;
+    static constexpr uint8_t kOriginShift = kDestinationShift + kClearingBits;
+    static constexpr uint8_t kVerbShift = kOriginShift + kClearingBits;
+    static constexpr uint8_t kFactionShift = kVerbShift + kVerbBits;
+    static_assert(kFactionShift + kFactionBits == 32, "Action fields have to fill exactly one word");
+
+    static constexpr uint8_t kNoClearing = (1U << kClearingBits) - 1;
+    static constexpr uint8_t kNoCard = (1U << kCardBits) - 1;
+    static constexpr uint8_t kMaxCount = (1U << kCountBits) - 1;
+
+    static_assert(board_data::kTotalClearings < kNoClearing, "Clearing indices have to fit below the none value");
+    static_assert(static_cast<uint8_t>(card_data::CardID::kFaithfulRetainer) < kNoCard, "Card IDs have to fit below the none value");
+    static_assert(static_cast<uint8_t>(FactionID::kKeepersInIron) < (1U << kFactionBits), "Faction IDs have to fit");
+    static_assert(static_cast<uint8_t>(Verb::kMaxVerb) <= (1U << kVerbBits), "Verbs have to fit");
+    static_assert(static_cast<uint8_t>(building_data::Building::kMaxBuildingIndex) - 1 <= (1U << kBuildingBits), "Buildings have to fit");
+
+    // Trivial so lists of actions start uninitialized. Action{} is all zero bits, which no generator produces, so it
+    // can stand for no action
+    Action() = default;
+
+    [[nodiscard]] static constexpr Action make(
+        FactionID faction,
+        Verb verb,
+        uint8_t origin = kNoClearing,
+        uint8_t destination = kNoClearing,
+        uint8_t count = 0,
+        uint8_t card = kNoCard,
+        building_data::Building building = building_data::Building::kRuin)
+    {
+        const uint8_t buildingField = building == building_data::Building::kRuin ? 0 : static_cast<uint8_t>(building) - 1;
+        return Action(
+            (uint32_t(faction) << kFactionShift) |
+            (uint32_t(verb) << kVerbShift) |
+            (uint32_t(origin & kNoClearing) << kOriginShift) |
+            (uint32_t(destination & kNoClearing) << kDestinationShift) |
+            (uint32_t(count & kMaxCount) << kCountShift) |
+            (uint32_t(card & kNoCard) << kCardShift) |
+            (uint32_t(buildingField) << kBuildingShift));
+    }
+
+    [[nodiscard]] static constexpr Action make_with_card(FactionID faction, Verb verb, card_data::CardID card, uint8_t origin = kNoClearing)
+    {
+        return make(faction, verb, origin, kNoClearing, 0, static_cast<uint8_t>(card));
+    }
+
+    // Battles name the defender in the count field, a battle has no count of its own
+    [[nodiscard]] static constexpr Action make_battle(FactionID faction, uint8_t clearing, FactionID defender)
+    {
+        return make(faction, Verb::kBattle, clearing, kNoClearing, static_cast<uint8_t>(defender));
+    }
+
+    [[nodiscard]] static constexpr Action from_packed(uint32_t packed) { return Action(packed); }
+    [[nodiscard]] constexpr uint32_t get_packed() const { return packed; }
+
+    [[nodiscard]] constexpr FactionID get_faction() const { return static_cast<FactionID>(get_field<kFactionShift, kFactionBits>()); }
+    [[nodiscard]] constexpr Verb get_verb() const { return static_cast<Verb>(get_field<kVerbShift, kVerbBits>()); }
+    [[nodiscard]] constexpr uint8_t get_origin() const { return get_field<kOriginShift, kClearingBits>(); }
+    [[nodiscard]] constexpr uint8_t get_destination() const { return get_field<kDestinationShift, kClearingBits>(); }
+    [[nodiscard]] constexpr uint8_t get_count() const { return get_field<kCountShift, kCountBits>(); }
+    [[nodiscard]] constexpr FactionID get_defender() const { return static_cast<FactionID>(get_count()); }
+    [[nodiscard]] constexpr bool has_card() const { return get_field<kCardShift, kCardBits>() != kNoCard; }
+    [[nodiscard]] constexpr card_data::CardID get_card() const { return static_cast<card_data::CardID>(get_field<kCardShift, kCardBits>()); }
+    [[nodiscard]] constexpr bool has_building() const
+    {
+        return get_verb() == Verb::kBuild || get_verb() == Verb::kPlaceStartingBuilding;
+    }
+    [[nodiscard]] constexpr building_data::Building get_building() const
+    {
+        [[unlikely]] if (!has_building())
+            return building_data::Building::kRuin;
+        return static_cast<building_data::Building>(get_field<kBuildingShift, kBuildingBits>() + 1);
+    }
+
+    [[nodiscard]] constexpr auto operator<=>(const Action &other) const = default;
+
+private:
+    constexpr explicit Action(uint32_t packed) : packed(packed) {}
+
+    template <uint8_t shift, uint8_t width>
+    [[nodiscard]] constexpr uint8_t get_field() const
+    {
+        return static_cast<uint8_t>((packed >> shift) & ((1U << width) - 1));
+    }
+
+    uint32_t packed;
+};
+static_assert(sizeof(Action) == sizeof(uint32_t) && std::is_trivially_default_constructible_v<Action>, "Actions have to stay one plain word");
+
+// Most legal moves any position can have. Marches dominate: every warrior stack times every path times every count
+static constexpr size_t kMaxLegalActions = 1024;
+
+/*
+    Fixed capacity list the move generators fill. It lives on the stack of whoever asks for moves, so generating
+    them never allocates
+*/
+template <size_t capacity>
+class ActionListOf
+{
+public:
+    [[nodiscard]] inline std::expected<void, ActionError> push_back(Action newAction)
+    {
+        [[unlikely]] if (actionCount == capacity)
+            return std::unexpected(ActionError{ActionError::Code::kListFull});
+        actions[actionCount++] = newAction;
+        return {};
+    }
+
+    // Puts the actions in packed order, so the same position always lists its moves the same way
+    inline void sort() { std::sort(actions.begin(), actions.begin() + actionCount); }
+
+    [[nodiscard]] inline bool contains(Action action) const
+    {
+        return std::find(begin(), end(), action) != end();
+    }
+
+    inline void clear() { actionCount = 0; }
+
+    [[nodiscard]] inline size_t size() const { return actionCount; }
+    [[nodiscard]] inline bool empty() const { return actionCount == 0; }
+    [[nodiscard]] inline Action operator[](size_t index) const { return actions[index]; }
+
+    [[nodiscard]] inline const Action *begin() const { return actions.data(); }
+    [[nodiscard]] inline const Action *end() const { return actions.data() + actionCount; }
+    [[nodiscard]] inline std::span<const Action> get_actions() const { return {actions.data(), actionCount}; }
+
+private:
+    std::array<Action, capacity> actions;
+    size_t actionCount = 0;
+};
+
+using ActionList = ActionListOf<kMaxLegalActions>;
+} // action
+} // game_data
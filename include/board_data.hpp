@@ -3,6 +3,10 @@
 #include "game_data.hpp"
 #include "clearing_data.hpp"
 #include "forest_data.hpp"
+#include "pawn_histogram.hpp"
+#include "suit_setup.hpp"
+#include "board_tables.hpp"
+#include "zobrist.hpp"
 
 #include <cstdint>
 #include <array>
@@ -14,6 +18,8 @@
 #include <algorithm>
 #include <span>
 #include <variant>
+#include <bit>
+#include <utility>
 
 namespace game_data
 {
@@ -22,200 +28,7 @@ namespace board_data
 
 static constexpr uint8_t kTotalBoardTypes = 4;
 
-static constexpr std::array<std::bitset<kTotalClearings * kTotalForests>, kTotalBoardTypes> clearingForestConnections 
-{[]{
-    std::array<std::bitset<kTotalClearings * kTotalForests>, kTotalBoardTypes> result{};
-
-    using enum BoardType;
-    result[static_cast<size_t>(kAutumn)].set(0 * kTotalForests + 0, true);
-    result[static_cast<size_t>(kAutumn)].set(0 * kTotalForests + 0, true);
-    result[static_cast<size_t>(kAutumn)].set(0 * kTotalForests + 2, true);
-
-    result[static_cast<size_t>(kAutumn)].set(1 * kTotalForests + 0, true);
-
-    result[static_cast<size_t>(kAutumn)].set(2 * kTotalForests + 0, true);
-    result[static_cast<size_t>(kAutumn)].set(2 * kTotalForests + 2, true);
-
-    result[static_cast<size_t>(kAutumn)].set(3 * kTotalForests + 0, true);
-    result[static_cast<size_t>(kAutumn)].set(3 * kTotalForests + 1, true);
-    result[static_cast<size_t>(kAutumn)].set(3 * kTotalForests + 2, true);
-
-    result[static_cast<size_t>(kAutumn)].set(4 * kTotalForests + 1, true);
-    result[static_cast<size_t>(kAutumn)].set(4 * kTotalForests + 3, true);
-
-    result[static_cast<size_t>(kAutumn)].set(5 * kTotalForests + 2, true);
-    result[static_cast<size_t>(kAutumn)].set(5 * kTotalForests + 4, true);
-    result[static_cast<size_t>(kAutumn)].set(5 * kTotalForests + 5, true);
-
-    result[static_cast<size_t>(kAutumn)].set(6 * kTotalForests + 2, true);
-    result[static_cast<size_t>(kAutumn)].set(6 * kTotalForests + 4, true);
-
-    result[static_cast<size_t>(kAutumn)].set(7 * kTotalForests + 1, true);
-    result[static_cast<size_t>(kAutumn)].set(7 * kTotalForests + 2, true);
-    result[static_cast<size_t>(kAutumn)].set(7 * kTotalForests + 3, true);
-    result[static_cast<size_t>(kAutumn)].set(7 * kTotalForests + 5, true);
-    result[static_cast<size_t>(kAutumn)].set(7 * kTotalForests + 6, true);
-
-    result[static_cast<size_t>(kAutumn)].set(8 * kTotalForests + 5, true);
-    result[static_cast<size_t>(kAutumn)].set(8 * kTotalForests + 6, true);
-
-    result[static_cast<size_t>(kAutumn)].set(9 * kTotalForests + 3, true);
-    result[static_cast<size_t>(kAutumn)].set(9 * kTotalForests + 6, true);
-
-    result[static_cast<size_t>(kAutumn)].set(10 * kTotalForests + 4, true);
-    result[static_cast<size_t>(kAutumn)].set(10 * kTotalForests + 5, true);
-
-    result[static_cast<size_t>(kAutumn)].set(11 * kTotalForests + 6, true);
-
-
-
-    result[static_cast<size_t>(kWinter)].set(0 * kTotalForests + 0, true);
-    result[static_cast<size_t>(kWinter)].set(0 * kTotalForests + 1, true);
-
-    result[static_cast<size_t>(kWinter)].set(1 * kTotalForests + 0, true);
-
-    result[static_cast<size_t>(kWinter)].set(2 * kTotalForests + 0, true);
-    result[static_cast<size_t>(kWinter)].set(2 * kTotalForests + 2, true);
-
-    result[static_cast<size_t>(kWinter)].set(3 * kTotalForests + 0, true);
-
-    result[static_cast<size_t>(kWinter)].set(4 * kTotalForests + 1, true);
-    result[static_cast<size_t>(kWinter)].set(4 * kTotalForests + 4, true);
-
-    result[static_cast<size_t>(kWinter)].set(5 * kTotalForests + 0, true);
-    result[static_cast<size_t>(kWinter)].set(5 * kTotalForests + 2, true);
-    result[static_cast<size_t>(kWinter)].set(5 * kTotalForests + 3, true);
-    result[static_cast<size_t>(kWinter)].set(5 * kTotalForests + 5, true);
-    result[static_cast<size_t>(kWinter)].set(5 * kTotalForests + 6, true);
-
-    result[static_cast<size_t>(kWinter)].set(6 * kTotalForests + 0, true);
-    result[static_cast<size_t>(kWinter)].set(6 * kTotalForests + 1, true);
-    result[static_cast<size_t>(kWinter)].set(6 * kTotalForests + 3, true);
-    result[static_cast<size_t>(kWinter)].set(6 * kTotalForests + 4, true);
-    result[static_cast<size_t>(kWinter)].set(6 * kTotalForests + 7, true);
-
-    result[static_cast<size_t>(kWinter)].set(7 * kTotalForests + 2, true);
-    result[static_cast<size_t>(kWinter)].set(7 * kTotalForests + 6, true);
-
-    result[static_cast<size_t>(kWinter)].set(8 * kTotalForests + 3, true);
-    result[static_cast<size_t>(kWinter)].set(8 * kTotalForests + 5, true);
-
-    result[static_cast<size_t>(kWinter)].set(9 * kTotalForests + 4, true);
-    result[static_cast<size_t>(kWinter)].set(9 * kTotalForests + 7, true);
-
-    result[static_cast<size_t>(kWinter)].set(10 * kTotalForests + 5, true);
-    result[static_cast<size_t>(kWinter)].set(10 * kTotalForests + 6, true);
-
-    result[static_cast<size_t>(kWinter)].set(11 * kTotalForests + 3, true);
-    result[static_cast<size_t>(kWinter)].set(11 * kTotalForests + 7, true);    
-
-
-
-    result[static_cast<size_t>(kLake)].set(0 * kTotalForests + 0, true);
-    result[static_cast<size_t>(kLake)].set(0 * kTotalForests + 1, true);
-    result[static_cast<size_t>(kLake)].set(0 * kTotalForests + 2, true);
-
-    result[static_cast<size_t>(kLake)].set(1 * kTotalForests + 0, true);
-    result[static_cast<size_t>(kLake)].set(1 * kTotalForests + 4, true);
-
-    result[static_cast<size_t>(kLake)].set(2 * kTotalForests + 1, true);
-    result[static_cast<size_t>(kLake)].set(2 * kTotalForests + 3, true);
-
-    result[static_cast<size_t>(kLake)].set(3 * kTotalForests + 3, true);
-
-    result[static_cast<size_t>(kLake)].set(4 * kTotalForests + 0, true);
-    result[static_cast<size_t>(kLake)].set(4 * kTotalForests + 2, true);
-    result[static_cast<size_t>(kLake)].set(4 * kTotalForests + 4, true);
-    result[static_cast<size_t>(kLake)].set(4 * kTotalForests + 5, true);
-
-    result[static_cast<size_t>(kLake)].set(5 * kTotalForests + 1, true);
-    result[static_cast<size_t>(kLake)].set(5 * kTotalForests + 2, true);
-    result[static_cast<size_t>(kLake)].set(5 * kTotalForests + 3, true);
-    result[static_cast<size_t>(kLake)].set(5 * kTotalForests + 6, true);
-
-    result[static_cast<size_t>(kLake)].set(6 * kTotalForests + 4, true);
-    result[static_cast<size_t>(kLake)].set(6 * kTotalForests + 5, true);
-
-    result[static_cast<size_t>(kLake)].set(7 * kTotalForests + 3, true);
-    result[static_cast<size_t>(kLake)].set(7 * kTotalForests + 6, true);
-
-    result[static_cast<size_t>(kLake)].set(8 * kTotalForests + 5, true);
-    result[static_cast<size_t>(kLake)].set(8 * kTotalForests + 7, true);
-    result[static_cast<size_t>(kLake)].set(8 * kTotalForests + 8, true);
-
-    result[static_cast<size_t>(kLake)].set(9 * kTotalForests + 5, true);
-    result[static_cast<size_t>(kLake)].set(9 * kTotalForests + 8, true);
-
-    result[static_cast<size_t>(kLake)].set(10 * kTotalForests + 6, true);
-    result[static_cast<size_t>(kLake)].set(10 * kTotalForests + 7, true);
-
-    result[static_cast<size_t>(kLake)].set(11 * kTotalForests + 7, true);
-    result[static_cast<size_t>(kLake)].set(11 * kTotalForests + 8, true);
-
-
-
-    result[static_cast<size_t>(kMountain)].set(0 * kTotalForests + 0, true);
-    result[static_cast<size_t>(kMountain)].set(0 * kTotalForests + 1, true);
-    result[static_cast<size_t>(kMountain)].set(0 * kTotalForests + 2, true);
-
-    result[static_cast<size_t>(kMountain)].set(1 * kTotalForests + 3, true);
-
-    result[static_cast<size_t>(kMountain)].set(2 * kTotalForests + 0, true);
-    result[static_cast<size_t>(kMountain)].set(2 * kTotalForests + 4, true);
-
-    result[static_cast<size_t>(kMountain)].set(3 * kTotalForests + 1, true);
-    result[static_cast<size_t>(kMountain)].set(3 * kTotalForests + 3, true);
-    result[static_cast<size_t>(kMountain)].set(3 * kTotalForests + 5, true);
-    result[static_cast<size_t>(kMountain)].set(3 * kTotalForests + 6, true);
-
-    result[static_cast<size_t>(kMountain)].set(4 * kTotalForests + 1, true);
-    result[static_cast<size_t>(kMountain)].set(4 * kTotalForests + 2, true);
-    result[static_cast<size_t>(kMountain)].set(4 * kTotalForests + 5, true);
-    result[static_cast<size_t>(kMountain)].set(4 * kTotalForests + 7, true);
-
-    result[static_cast<size_t>(kMountain)].set(5 * kTotalForests + 4, true);
-    result[static_cast<size_t>(kMountain)].set(5 * kTotalForests + 8, true);
-
-    result[static_cast<size_t>(kMountain)].set(6 * kTotalForests + 3, true);
-    result[static_cast<size_t>(kMountain)].set(6 * kTotalForests + 6, true);
-
-    result[static_cast<size_t>(kMountain)].set(7 * kTotalForests + 0, true);
-    result[static_cast<size_t>(kMountain)].set(7 * kTotalForests + 2, true);
-    result[static_cast<size_t>(kMountain)].set(7 * kTotalForests + 4, true);
-    result[static_cast<size_t>(kMountain)].set(7 * kTotalForests + 7, true);
-    result[static_cast<size_t>(kMountain)].set(7 * kTotalForests + 8, true);
-    result[static_cast<size_t>(kMountain)].set(7 * kTotalForests + 9, true);
-
-    result[static_cast<size_t>(kMountain)].set(8 * kTotalForests + 5, true);
-    result[static_cast<size_t>(kMountain)].set(8 * kTotalForests + 6, true);
-    result[static_cast<size_t>(kMountain)].set(8 * kTotalForests + 7, true);
-    result[static_cast<size_t>(kMountain)].set(8 * kTotalForests + 9, true);
-
-    result[static_cast<size_t>(kMountain)].set(9 * kTotalForests + 8, true);
-    result[static_cast<size_t>(kMountain)].set(9 * kTotalForests + 9, true);
-
-    result[static_cast<size_t>(kMountain)].set(10 * kTotalForests + 6, true);
-
-    result[static_cast<size_t>(kMountain)].set(11 * kTotalForests + 10, true);
-    
-
-    return result;
-}()};
-
-static constexpr std::array<std::bitset<kTotalClearings * kTotalForests>, kTotalBoardTypes> forestClearingConnections{[]{
-    std::array<std::bitset<kTotalClearings * kTotalForests>, kTotalBoardTypes> result{};
-
-    for (uint8_t board = 0; board < kTotalBoardTypes; ++board) {
-        for (uint8_t clearing = 0; clearing < kTotalClearings; ++clearing) {
-            for (uint8_t forest = 0; forest < kTotalForests; ++forest) {    
-                if (clearingForestConnections[board][clearing * kTotalForests + forest]) {
-                    result[board].set(forest * kTotalClearings + clearing, true);
-                }
-            }
-        }
-    }
-    return result;
-}()};
+static_assert(generated::kLandMasks.size() == kTotalBoardTypes, "Generated board tables must cover every board");
 
 enum class ClearingClearingConnectionType : uint8_t
 {
@@ -224,309 +37,59 @@ enum class ClearingClearingConnectionType : uint8_t
     kWater,
 };
 
-static constexpr std::array<std::array<std::array<ClearingClearingConnectionType, kTotalClearings>, kTotalClearings>, kTotalBoardTypes> clearingClearingConnections{[]{
-    using enum ClearingClearingConnectionType;
-
-    static_assert(static_cast<std::underlying_type_t<ClearingClearingConnectionType>>(kNoConnection) == 0, "kNoConnection must equal 0");
-
-    std::array<std::array<std::array<ClearingClearingConnectionType, kTotalClearings>, kTotalClearings>, kTotalBoardTypes> result{};
-
-    using enum BoardType;
-    result[static_cast<size_t>(kAutumn)][0][1] = kLand;
-    result[static_cast<size_t>(kAutumn)][0][3] = kLand;
-    result[static_cast<size_t>(kAutumn)][0][4] = kLand;
-
-    result[static_cast<size_t>(kAutumn)][1][0] = kLand;
-    result[static_cast<size_t>(kAutumn)][1][2] = kLand;
-    result[static_cast<size_t>(kAutumn)][1][3] = kWater;
-
-    result[static_cast<size_t>(kAutumn)][2][1] = kLand;
-    result[static_cast<size_t>(kAutumn)][2][3] = kLand;
-    result[static_cast<size_t>(kAutumn)][2][6] = kLand;
-
-    result[static_cast<size_t>(kAutumn)][3][0] = kLand;
-    result[static_cast<size_t>(kAutumn)][3][1] = kWater;
-    result[static_cast<size_t>(kAutumn)][3][2] = kLand;
-    result[static_cast<size_t>(kAutumn)][3][5] = kWater;
-    result[static_cast<size_t>(kAutumn)][3][7] = kLand;
-
-    result[static_cast<size_t>(kAutumn)][4][0] = kLand;
-    result[static_cast<size_t>(kAutumn)][4][7] = kLand;
-    result[static_cast<size_t>(kAutumn)][4][9] = kLand;
-
-    result[static_cast<size_t>(kAutumn)][5][3] = kWater;
-    result[static_cast<size_t>(kAutumn)][5][6] = kLand;
-    result[static_cast<size_t>(kAutumn)][5][7] = kLand;
-    result[static_cast<size_t>(kAutumn)][5][8] = kWater;
-    result[static_cast<size_t>(kAutumn)][5][10] = kLand;
-
-    result[static_cast<size_t>(kAutumn)][6][2] = kLand;
-    result[static_cast<size_t>(kAutumn)][6][5] = kLand;
-    result[static_cast<size_t>(kAutumn)][6][10] = kLand;
-
-    result[static_cast<size_t>(kAutumn)][7][3] = kLand;
-    result[static_cast<size_t>(kAutumn)][7][4] = kLand;
-    result[static_cast<size_t>(kAutumn)][7][5] = kLand;
-    result[static_cast<size_t>(kAutumn)][7][8] = kLand;
-    result[static_cast<size_t>(kAutumn)][7][9] = kLand;
-
-    result[static_cast<size_t>(kAutumn)][8][5] = kWater;
-    result[static_cast<size_t>(kAutumn)][8][7] = kLand;
-    result[static_cast<size_t>(kAutumn)][8][9] = kWater;
-    result[static_cast<size_t>(kAutumn)][8][10] = kLand;
-    result[static_cast<size_t>(kAutumn)][8][11] = kLand;
-
-    result[static_cast<size_t>(kAutumn)][9][4] = kLand;
-    result[static_cast<size_t>(kAutumn)][9][7] = kLand;
-    result[static_cast<size_t>(kAutumn)][9][8] = kWater;
-    result[static_cast<size_t>(kAutumn)][9][11] = kLand;
-
-    result[static_cast<size_t>(kAutumn)][10][5] = kLand;
-    result[static_cast<size_t>(kAutumn)][10][6] = kLand;
-    result[static_cast<size_t>(kAutumn)][10][8] = kLand;
-
-    result[static_cast<size_t>(kAutumn)][11][8] = kLand;
-    result[static_cast<size_t>(kAutumn)][11][9] = kLand;
-    
-
-
-    result[static_cast<size_t>(kWinter)][0][1] = kLand;
-    result[static_cast<size_t>(kWinter)][0][4] = kLand;
-    result[static_cast<size_t>(kWinter)][0][6] = kLand;
-
-    result[static_cast<size_t>(kWinter)][1][0] = kLand;
-    result[static_cast<size_t>(kWinter)][1][3] = kLand;
-
-    result[static_cast<size_t>(kWinter)][2][3] = kLand;
-    result[static_cast<size_t>(kWinter)][2][5] = kLand;
-    result[static_cast<size_t>(kWinter)][2][7] = kLand;
-
-    result[static_cast<size_t>(kWinter)][3][1] = kLand;
-    result[static_cast<size_t>(kWinter)][3][2] = kLand;
-
-    result[static_cast<size_t>(kWinter)][4][0] = kLand;
-    result[static_cast<size_t>(kWinter)][4][6] = kWater;
-    result[static_cast<size_t>(kWinter)][4][9] = kLand;
-
-    result[static_cast<size_t>(kWinter)][5][2] = kLand;
-    result[static_cast<size_t>(kWinter)][5][6] = kWater;
-    result[static_cast<size_t>(kWinter)][5][7] = kWater;
-    result[static_cast<size_t>(kWinter)][5][8] = kLand;
-    result[static_cast<size_t>(kWinter)][5][10] = kLand;
-
-    result[static_cast<size_t>(kWinter)][6][0] = kLand;
-    result[static_cast<size_t>(kWinter)][6][4] = kWater;
-    result[static_cast<size_t>(kWinter)][6][5] = kWater;
-    result[static_cast<size_t>(kWinter)][6][9] = kLand;
-    result[static_cast<size_t>(kWinter)][6][11] = kLand;
-
-    result[static_cast<size_t>(kWinter)][7][2] = kLand;
-    result[static_cast<size_t>(kWinter)][7][5] = kWater;
-    result[static_cast<size_t>(kWinter)][7][10] = kLand;
-
-    result[static_cast<size_t>(kWinter)][8][5] = kLand;
-    result[static_cast<size_t>(kWinter)][8][10] = kLand;
-    result[static_cast<size_t>(kWinter)][8][11] = kLand;
-
-    result[static_cast<size_t>(kWinter)][9][4] = kLand;
-    result[static_cast<size_t>(kWinter)][9][6] = kLand;
-    result[static_cast<size_t>(kWinter)][9][11] = kLand;
-
-    result[static_cast<size_t>(kWinter)][10][5] = kLand;
-    result[static_cast<size_t>(kWinter)][10][7] = kLand;
-    result[static_cast<size_t>(kWinter)][10][8] = kLand;
-
-    result[static_cast<size_t>(kWinter)][11][8] = kLand;
-    result[static_cast<size_t>(kWinter)][11][9] = kLand;
-
-
-
-    result[static_cast<size_t>(kLake)][0][1] = kLand;
-    result[static_cast<size_t>(kLake)][0][2] = kLand;
-    result[static_cast<size_t>(kLake)][0][4] = kLand;
-    result[static_cast<size_t>(kLake)][0][5] = kLand;
-
-    result[static_cast<size_t>(kLake)][1][0] = kLand;
-    result[static_cast<size_t>(kLake)][1][4] = kLand;
-    result[static_cast<size_t>(kLake)][1][6] = kLand;
-
-    result[static_cast<size_t>(kLake)][2][0] = kLand;
-    result[static_cast<size_t>(kLake)][2][3] = kLand;
-    result[static_cast<size_t>(kLake)][2][5] = kLand;
-
-    result[static_cast<size_t>(kLake)][3][2] = kLand;
-    result[static_cast<size_t>(kLake)][3][7] = kLand;
-
-    result[static_cast<size_t>(kLake)][4][0] = kLand;
-    result[static_cast<size_t>(kLake)][4][1] = kLand;
-    result[static_cast<size_t>(kLake)][4][5] = kWater;
-    result[static_cast<size_t>(kLake)][4][6] = kLand;
-    result[static_cast<size_t>(kLake)][4][8] = kWater;
-    result[static_cast<size_t>(kLake)][4][10] = kWater;
-
-    result[static_cast<size_t>(kLake)][5][0] = kLand;
-    result[static_cast<size_t>(kLake)][5][2] = kLand;
-    result[static_cast<size_t>(kLake)][5][4] = kWater;
-    result[static_cast<size_t>(kLake)][5][7] = kLand;
-    result[static_cast<size_t>(kLake)][5][8] = kWater;
-    result[static_cast<size_t>(kLake)][5][10] = kWater;
-
-    result[static_cast<size_t>(kLake)][6][1] = kLand;
-    result[static_cast<size_t>(kLake)][6][4] = kLand;
-    result[static_cast<size_t>(kLake)][6][9] = kLand;
-
-    result[static_cast<size_t>(kLake)][7][3] = kLand;
-    result[static_cast<size_t>(kLake)][7][5] = kLand;
-    result[static_cast<size_t>(kLake)][7][10] = kLand;
-
-    result[static_cast<size_t>(kLake)][8][4] = kWater;
-    result[static_cast<size_t>(kLake)][8][5] = kWater;
-    result[static_cast<size_t>(kLake)][8][9] = kLand;
-    result[static_cast<size_t>(kLake)][8][10] = kWater;
-    result[static_cast<size_t>(kLake)][8][11] = kLand;
-
-    result[static_cast<size_t>(kLake)][9][6] = kLand;
-    result[static_cast<size_t>(kLake)][9][8] = kLand;
-    result[static_cast<size_t>(kLake)][9][11] = kLand;
-
-    result[static_cast<size_t>(kLake)][10][4] = kWater;
-    result[static_cast<size_t>(kLake)][10][5] = kWater;
-    result[static_cast<size_t>(kLake)][10][7] = kLand;
-    result[static_cast<size_t>(kLake)][10][8] = kWater;
-    result[static_cast<size_t>(kLake)][10][11] = kLand;
-
-    result[static_cast<size_t>(kLake)][11][8] = kLand;
-    result[static_cast<size_t>(kLake)][11][9] = kLand;
-    result[static_cast<size_t>(kLake)][11][10] = kLand;
-
-
-
-    result[static_cast<size_t>(kMountain)][0][4] = kLand;
-    result[static_cast<size_t>(kMountain)][0][7] = kLand;
-
-    result[static_cast<size_t>(kMountain)][1][3] = kLand;
-    result[static_cast<size_t>(kMountain)][1][6] = kLand;
-
-    result[static_cast<size_t>(kMountain)][2][4] = kWater;
-    result[static_cast<size_t>(kMountain)][2][5] = kLand;
-    result[static_cast<size_t>(kMountain)][2][7] = kLand;
-
-    result[static_cast<size_t>(kMountain)][3][1] = kLand;
-    result[static_cast<size_t>(kMountain)][3][4] = kLand;
+using AdjacencyMasks = std::array<ClearingMask, kTotalClearings>;
 
-    result[static_cast<size_t>(kMountain)][3][8] = kLand;
-
-    result[static_cast<size_t>(kMountain)][4][0] = kLand;
-    result[static_cast<size_t>(kMountain)][4][2] = kWater;
-    result[static_cast<size_t>(kMountain)][4][3] = kLand;
-    result[static_cast<size_t>(kMountain)][4][7] = kLand;
-    result[static_cast<size_t>(kMountain)][4][8] = kLand;
-    result[static_cast<size_t>(kMountain)][4][10] = kWater;
-
-    result[static_cast<size_t>(kMountain)][5][2] = kLand;
-    result[static_cast<size_t>(kMountain)][5][9] = kLand;
-
-    result[static_cast<size_t>(kMountain)][6][1] = kLand;
-    result[static_cast<size_t>(kMountain)][6][10] = kLand;
-
-    result[static_cast<size_t>(kMountain)][7][0] = kLand;
-    result[static_cast<size_t>(kMountain)][7][2] = kLand;
-    result[static_cast<size_t>(kMountain)][7][4] = kLand;
-    result[static_cast<size_t>(kMountain)][7][9] = kLand;
-
-    result[static_cast<size_t>(kMountain)][8][3] = kLand;
-    result[static_cast<size_t>(kMountain)][8][4] = kLand;
-    result[static_cast<size_t>(kMountain)][8][10] = kLand;
-    result[static_cast<size_t>(kMountain)][8][11] = kLand;
-
-    result[static_cast<size_t>(kMountain)][9][5] = kLand;
-    result[static_cast<size_t>(kMountain)][9][7] = kLand;
-
-    result[static_cast<size_t>(kMountain)][10][4] = kWater;
-    result[static_cast<size_t>(kMountain)][10][6] = kLand;
-    result[static_cast<size_t>(kMountain)][10][8] = kLand;
-
-    result[static_cast<size_t>(kMountain)][11][8] = kLand;
+struct BoardAdjacency
+{
+    AdjacencyMasks land;
+    AdjacencyMasks water;
+    AdjacencyMasks any;
+};
 
+// One mask per clearing and connection type, so adjacency checks are a single AND
+static constexpr std::array<BoardAdjacency, kTotalBoardTypes> clearingAdjacency{[]{
+    std::array<BoardAdjacency, kTotalBoardTypes> result{};
+    for (uint8_t board = 0; board < kTotalBoardTypes; ++board) {
+        result[board].land = generated::kLandMasks[board];
+        result[board].water = generated::kWaterMasks[board];
+        for (uint8_t clearing = 0; clearing < kTotalClearings; ++clearing)
+            result[board].any[clearing] = result[board].land[clearing] | result[board].water[clearing];
+    }
     return result;
 }()};
 
-static constexpr std::array<std::array<uint8_t, kTotalClearings>, kTotalBoardTypes> startingBuildingSlotCounts{{
-    // Autumn
-    {1, 2, 2, 2, 1, 3, 2, 2, 2, 1, 1, 2},
-
-    // Winter
-    {1, 2, 1, 2, 1, 3, 3, 1, 2, 2, 2, 2},
-
-    // Lake
-    {1, 1, 2, 1, 3, 3, 1, 3, 3, 1, 2, 1},
-
-    // Mountain
-    {1, 2, 2, 3, 2, 1, 1, 3, 3, 2, 2, 1}
-}};
-
-consteval inline void add_ruin(
-    std::array<std::bitset<kTotalClearings>, kTotalBoardTypes>& result,
-    const BoardType boardType,
-    const uint8_t clearingIndex
-) {
-    result[static_cast<size_t>(boardType)].set(clearingIndex, true);
+[[nodiscard]] inline constexpr ClearingClearingConnectionType get_connection_type(const BoardAdjacency &adjacency, uint8_t originIndex, uint8_t destinationIndex)
+{
+    using enum ClearingClearingConnectionType;
+    if ((adjacency.land[originIndex] >> destinationIndex) & 1)
+        return kLand;
+    if ((adjacency.water[originIndex] >> destinationIndex) & 1)
+        return kWater;
+    return kNoConnection;
 }
 
+static constexpr std::array<std::array<uint8_t, kTotalClearings>, kTotalBoardTypes> startingBuildingSlotCounts = generated::kBuildingSlotCounts;
+
 static constexpr std::array<std::bitset<kTotalClearings>, kTotalBoardTypes> startingRuins{[]{
     std::array<std::bitset<kTotalClearings>, kTotalBoardTypes> result{};
-
-    using enum BoardType;
-    result[static_cast<size_t>(kAutumn)].set(3, true);
-    result[static_cast<size_t>(kAutumn)].set(5, true);
-    result[static_cast<size_t>(kAutumn)].set(6, true);
-    result[static_cast<size_t>(kAutumn)].set(7, true);
-    
-    result[static_cast<size_t>(kWinter)].set(5, true);
-    result[static_cast<size_t>(kWinter)].set(6, true);
-    result[static_cast<size_t>(kWinter)].set(8, true);
-    result[static_cast<size_t>(kWinter)].set(11, true);
-
-    result[static_cast<size_t>(kLake)].set(4, true);
-    result[static_cast<size_t>(kLake)].set(5, true);
-    result[static_cast<size_t>(kLake)].set(7, true);
-    result[static_cast<size_t>(kLake)].set(8, true);
-
-    result[static_cast<size_t>(kMountain)].set(3, true);
-    result[static_cast<size_t>(kMountain)].set(4, true);
-    result[static_cast<size_t>(kMountain)].set(7, true);
-    result[static_cast<size_t>(kMountain)].set(8, true);
-
+    for (uint8_t board = 0; board < kTotalBoardTypes; ++board)
+        result[board] = std::bitset<kTotalClearings>{generated::kRuinMasks[board]};
     return result;
 }()};
 
 static constexpr std::array<std::array<clearing_data::landmark_data::Landmark, kTotalClearings>, kTotalBoardTypes> startingLandmarks{[]{
-    using Landmark = clearing_data::landmark_data::Landmark;
-    using enum Landmark;
-
-    static_assert(static_cast<std::underlying_type_t<Landmark>>(kNone) == 0);
-    std::array<std::array<Landmark, kTotalClearings>, kTotalBoardTypes> result{};
-
-    using enum BoardType;
-
-    result[static_cast<size_t>(kLake)][10] = kFerry;
-    result[static_cast<size_t>(kMountain)][4] = kTower;
-
+    std::array<std::array<clearing_data::landmark_data::Landmark, kTotalClearings>, kTotalBoardTypes> result{};
+    for (uint8_t board = 0; board < kTotalBoardTypes; ++board)
+        for (uint8_t clearing = 0; clearing < kTotalClearings; ++clearing)
+            result[board][clearing] = static_cast<clearing_data::landmark_data::Landmark>(generated::kLandmarks[board][clearing]);
     return result;
 }()};
 
 static constexpr std::array<std::array<clearing_data::ClearingType, kTotalClearings>, kTotalBoardTypes> clearingTypes{[]{
-    using ClearingType = clearing_data::ClearingType;
-    using enum ClearingType;
-
-    static_assert(static_cast<std::underlying_type_t<ClearingType>>(kRandom) == 0);
-
-    std::array<std::array<ClearingType, kTotalClearings>, kTotalBoardTypes> result{};
-
-    using enum BoardType;
-    result[static_cast<size_t>(kAutumn)] = 
-        {kFox, kRabbit, kMouse, kRabbit, kMouse, kMouse, kFox, kFox, kMouse, kRabbit, kRabbit, kFox};
-
+    std::array<std::array<clearing_data::ClearingType, kTotalClearings>, kTotalBoardTypes> result{};
+    for (uint8_t board = 0; board < kTotalBoardTypes; ++board)
+        for (uint8_t clearing = 0; clearing < kTotalClearings; ++clearing)
+            result[board][clearing] = static_cast<clearing_data::ClearingType>(generated::kClearingTypes[board][clearing]);
     return result;
 }()};
 
@@ -536,15 +99,17 @@ struct ConnectionError {
         kNotEnoughDataWrite,
         kInvalidConnectionType,
         kIndexExceededNodeCount,
-        kDuplicateIndices
+        kDuplicateIndices,
+        kNotAPath
     } code;
 
-    static constexpr std::array<std::string_view, 6> kMessages = {
+    static constexpr std::array<std::string_view, 7> kMessages = {
         "Not enough data to read requested bits",
         "Not enough data to write requested bits",
         "Invalid connection type",
         "Index exceeded node count",
         "Duplicate indices are not allowed",
+        "Only the printed paths can be blocked or cleared",
         "Unknown Error"
     };
 
@@ -568,6 +133,61 @@ enum class BasicConnectionType : uint8_t {
     kForestClearing
 };
 
+struct ForestIncidence
+{
+    std::array<ForestMask, kTotalClearings> clearingForests;
+    std::array<ClearingMask, kTotalForests> forestClearings;
+};
+
+// Both directions of the clearing-forest borders as masks, so a clearing's forests or a forest's clearings are one load
+static constexpr std::array<ForestIncidence, kTotalBoardTypes> forestIncidence{[]{
+    std::array<ForestIncidence, kTotalBoardTypes> result{};
+    for (uint8_t board = 0; board < kTotalBoardTypes; ++board) {
+        result[board].clearingForests = generated::kClearingForestMasks[board];
+        result[board].forestClearings = generated::kForestClearingMasks[board];
+    }
+    return result;
+}()};
+
+static constexpr ForestMask kAllForestsMask = static_cast<ForestMask>((1U << kTotalForests) - 1);
+
+template <BoardType boardType>
+[[nodiscard]] inline constexpr ForestMask get_forests_adjacent_to(ClearingMask clearings)
+{
+    const ForestIncidence &incidence = forestIncidence[static_cast<size_t>(boardType)];
+
+    ForestMask result = 0;
+    for (uint8_t clearing = 0; clearing < kTotalClearings; ++clearing)
+        result |= incidence.clearingForests[clearing] & static_cast<ForestMask>(-((clearings >> clearing) & 1));
+    return result;
+}
+
+template <BoardType boardType>
+[[nodiscard]] inline constexpr ClearingMask get_clearings_adjacent_to(ForestMask forests)
+{
+    const ForestIncidence &incidence = forestIncidence[static_cast<size_t>(boardType)];
+
+    ClearingMask result = 0;
+    for (uint8_t forest = 0; forest < kTotalForests; ++forest)
+        result |= incidence.forestClearings[forest] & static_cast<ClearingMask>(-((forests >> forest) & 1));
+    return result;
+}
+
+// Forests whose every bordering clearing is in clearings, e.g. forests surrounded by clearings a faction rules.
+// Forest slots a board does not use border no clearings and are never returned
+template <BoardType boardType>
+[[nodiscard]] inline constexpr ForestMask get_forests_bordered_only_by(ClearingMask clearings)
+{
+    const ForestIncidence &incidence = forestIncidence[static_cast<size_t>(boardType)];
+
+    ForestMask result = 0;
+    for (uint8_t forest = 0; forest < kTotalForests; ++forest) {
+        const ClearingMask border = incidence.forestClearings[forest];
+        result |= static_cast<ForestMask>(border != 0 && (border & ~clearings) == 0) << forest;
+    }
+    return result;
+}
+
 template <
     BoardType boardType,
     BasicConnectionType connectionType
@@ -577,20 +197,20 @@ std::expected<bool, ConnectionError> get_basic_connection(
     const uint8_t originIndex,
     const uint8_t destinationIndex
 ) {
-    [[unlikely]] if (originIndex == destinationIndex)
-        return std::unexpected(ConnectionError{ConnectionError::Code::kDuplicateIndices});
-
     using enum BasicConnectionType;
+    const ForestIncidence &incidence = forestIncidence[static_cast<size_t>(boardType)];
+
+    // Clearings and forests are numbered separately, so equal indices are not a duplicate
     if constexpr (connectionType == kClearingForest) {
-        [[unlikely]] if (originIndex >= kTotalForests || destinationIndex >= kTotalForests)
+        [[unlikely]] if (originIndex >= kTotalClearings || destinationIndex >= kTotalForests)
             return std::unexpected(ConnectionError{ConnectionError::Code::kIndexExceededNodeCount});
 
-        return clearingForestConnections[static_cast<size_t>(boardType)][originIndex * kTotalForests + destinationIndex];
+        return (incidence.clearingForests[originIndex] >> destinationIndex) & 1;
     } else if constexpr (connectionType == kForestClearing) {
-        [[unlikely]] if (originIndex >= kTotalClearings || destinationIndex >= kTotalClearings)
+        [[unlikely]] if (originIndex >= kTotalForests || destinationIndex >= kTotalClearings)
             return std::unexpected(ConnectionError{ConnectionError::Code::kIndexExceededNodeCount});
 
-        return forestClearingConnections[static_cast<size_t>(boardType)][originIndex * kTotalForests + destinationIndex];
+        return (incidence.forestClearings[originIndex] >> destinationIndex) & 1;
     } else {
         return std::unexpected(ConnectionError{ConnectionError::Code::kInvalidConnectionType});
     }
@@ -604,19 +224,18 @@ template <
 >
 [[nodiscard]] inline consteval
 bool get_basic_connection() {
-    static_assert(originIndex != destinationIndex, "Duplicate indices are not allowed");
-
     using enum BasicConnectionType;
     static_assert(connectionType == kClearingForest || connectionType == kForestClearing, "Invalid connection type");
 
+    const ForestIncidence &incidence = forestIncidence[static_cast<size_t>(boardType)];
     if constexpr (connectionType == kClearingForest) {
-        static_assert(originIndex < kTotalForests || destinationIndex < kTotalForests, "Index exceeded node count");
+        static_assert(originIndex < kTotalClearings && destinationIndex < kTotalForests, "Index exceeded node count");
 
-        return clearingForestConnections[static_cast<size_t>(boardType)][originIndex * kTotalForests + destinationIndex];
+        return (incidence.clearingForests[originIndex] >> destinationIndex) & 1;
     } else if constexpr (connectionType == kForestClearing) {
-        static_assert(originIndex < kTotalClearings || destinationIndex < kTotalClearings, "Index exceeded node count");
+        static_assert(originIndex < kTotalForests && destinationIndex < kTotalClearings, "Index exceeded node count");
 
-        return forestClearingConnections[static_cast<size_t>(boardType)][originIndex * kTotalForests + destinationIndex];
+        return (incidence.forestClearings[originIndex] >> destinationIndex) & 1;
     }
 }
 
@@ -643,15 +262,15 @@ std::expected<std::bitset<get_max_connections_from_type<connectionType>()>, Conn
     static_assert(connectionType == kClearingForest || connectionType == kForestClearing, "Invalid connection type");
 
     if constexpr (connectionType == kClearingForest) {
-        [[unlikely]] if (desiredIndex >= kTotalForests)
+        [[unlikely]] if (desiredIndex >= kTotalClearings)
             return std::unexpected(ConnectionError{ConnectionError::Code::kIndexExceededNodeCount});
 
-        return std::bitset<kTotalForests>{(clearingForestConnections[static_cast<size_t>(boardType)] >> (desiredIndex * kTotalForests)).to_ulong()};
+        return std::bitset<kTotalForests>{forestIncidence[static_cast<size_t>(boardType)].clearingForests[desiredIndex]};
     } else if constexpr (connectionType == kForestClearing) {
-        [[unlikely]] if (desiredIndex >= kTotalClearings)
+        [[unlikely]] if (desiredIndex >= kTotalForests)
             return std::unexpected(ConnectionError{ConnectionError::Code::kIndexExceededNodeCount});
 
-        return std::bitset<kTotalClearings>{(forestClearingConnections[static_cast<size_t>(boardType)] >> (desiredIndex * kTotalClearings)).to_ulong()};
+        return std::bitset<kTotalClearings>{forestIncidence[static_cast<size_t>(boardType)].forestClearings[desiredIndex]};
     }
 }
 
@@ -667,11 +286,11 @@ std::expected<std::bitset<get_max_connections_from_type<connectionType>()>, Conn
     static_assert(connectionType == kClearingForest || connectionType == kForestClearing, "Invalid connection type");
 
     if constexpr (connectionType == kClearingForest) {
-        static_assert(desiredIndex < kTotalForests, "Index exceeded node count");
-        return std::bitset<kTotalForests>{(clearingForestConnections[static_cast<size_t>(boardType)] >> (desiredIndex * kTotalForests)).to_ulong()};
-    } else if constexpr (connectionType == kForestClearing) {
         static_assert(desiredIndex < kTotalClearings, "Index exceeded node count");
-        return std::bitset<kTotalClearings>{(forestClearingConnections[static_cast<size_t>(boardType)] >> (desiredIndex * kTotalClearings)).to_ulong()};
+        return std::bitset<kTotalForests>{forestIncidence[static_cast<size_t>(boardType)].clearingForests[desiredIndex]};
+    } else if constexpr (connectionType == kForestClearing) {
+        static_assert(desiredIndex < kTotalForests, "Index exceeded node count");
+        return std::bitset<kTotalClearings>{forestIncidence[static_cast<size_t>(boardType)].forestClearings[desiredIndex]};
     }
 }
 
@@ -687,7 +306,7 @@ std::expected<ClearingClearingConnectionType, ConnectionError> get_clearing_clea
     [[unlikely]] if (originIndex >= kTotalClearings || destinationIndex >= kTotalClearings)
         return std::unexpected(ConnectionError{ConnectionError::Code::kIndexExceededNodeCount});
 
-    return std::expected<ClearingClearingConnectionType, ConnectionError>{clearingClearingConnections[static_cast<size_t>(boardType)][originIndex][destinationIndex]};
+    return get_connection_type(clearingAdjacency[static_cast<size_t>(boardType)], originIndex, destinationIndex);
 }
 
 template <
@@ -698,9 +317,9 @@ template <
 [[nodiscard]] inline consteval
 ClearingClearingConnectionType get_clearing_clearing_connection() {
     static_assert(originIndex != destinationIndex, "Duplicate indices are not allowed");
-    static_assert(originIndex < kTotalClearings || destinationIndex < kTotalClearings, "Index exceeded node count");
+    static_assert(originIndex < kTotalClearings && destinationIndex < kTotalClearings, "Index exceeded node count");
 
-    return clearingClearingConnections[static_cast<size_t>(boardType)][originIndex][destinationIndex];
+    return get_connection_type(clearingAdjacency[static_cast<size_t>(boardType)], originIndex, destinationIndex);
 }
 
 template <BoardType boardType>
@@ -710,7 +329,10 @@ get_clearing_clearing_connections(const uint8_t desiredIndex) {
     [[unlikely]] if (desiredIndex >= kTotalClearings)
         return std::unexpected(ConnectionError{ConnectionError::Code::kIndexExceededNodeCount});
 
-    return clearingClearingConnections[static_cast<size_t>(boardType)][desiredIndex];
+    std::array<ClearingClearingConnectionType, kTotalClearings> result;
+    for (uint8_t destination = 0; destination < kTotalClearings; ++destination)
+        result[destination] = get_connection_type(clearingAdjacency[static_cast<size_t>(boardType)], desiredIndex, destination);
+    return result;
 }
 
 template <
@@ -720,7 +342,11 @@ template <
 [[nodiscard]] inline consteval
 std::array<ClearingClearingConnectionType, kTotalClearings> get_clearing_clearing_connections() {
     static_assert(desiredIndex < kTotalClearings, "Index exceeded node count");
-    return clearingClearingConnections[static_cast<size_t>(boardType)][desiredIndex];
+
+    std::array<ClearingClearingConnectionType, kTotalClearings> result;
+    for (uint8_t destination = 0; destination < kTotalClearings; ++destination)
+        result[destination] = get_connection_type(clearingAdjacency[static_cast<size_t>(boardType)], desiredIndex, destination);
+    return result;
 }
 
 struct ClearingClearingConnectionList {
@@ -737,6 +363,85 @@ struct ClearingClearingConnectionList {
     }
 };
 
+template <BoardType boardType, ClearingClearingConnectionType connectionType>
+[[nodiscard]] inline consteval const AdjacencyMasks &get_adjacency_masks()
+{
+    using enum ClearingClearingConnectionType;
+    static_assert(connectionType != kNoConnection, "kNoConnection has no adjacency masks");
+
+    if constexpr (connectionType == kLand)
+        return clearingAdjacency[static_cast<size_t>(boardType)].land;
+    else
+        return clearingAdjacency[static_cast<size_t>(boardType)].water;
+}
+
+static constexpr ClearingMask kAllClearingsMask = static_cast<ClearingMask>((1U << kTotalClearings) - 1);
+
+// Union of the neighbours of every clearing in clearings
+[[nodiscard]] inline constexpr ClearingMask get_neighbours(ClearingMask clearings, const AdjacencyMasks &adjacency)
+{
+    ClearingMask result = 0;
+    for (uint8_t clearing = 0; clearing < kTotalClearings; ++clearing)
+        result |= adjacency[clearing] & static_cast<ClearingMask>(-((clearings >> clearing) & 1));
+    return result;
+}
+
+// Every clearing reachable from origins in at most steps moves, only passing through passable clearings.
+// Origins are always included
+[[nodiscard]] inline constexpr ClearingMask get_reachable_within(
+    ClearingMask origins,
+    uint8_t steps,
+    const AdjacencyMasks &adjacency,
+    ClearingMask passable = kAllClearingsMask
+) {
+    ClearingMask reached = origins;
+    ClearingMask frontier = origins;
+    for (uint8_t step = 0; step < steps && frontier != 0; ++step) {
+        frontier = get_neighbours(frontier, adjacency) & passable & ~reached;
+        reached |= frontier;
+    }
+    return reached;
+}
+
+// Every clearing reachable from origins in any number of moves through passable clearings
+[[nodiscard]] inline constexpr ClearingMask flood_fill(
+    ClearingMask origins,
+    const AdjacencyMasks &adjacency,
+    ClearingMask passable = kAllClearingsMask
+) {
+    return get_reachable_within(origins, kTotalClearings, adjacency, passable);
+}
+
+struct ComponentList
+{
+    std::array<ClearingMask, kTotalClearings> components;
+    uint8_t count = 0;
+};
+
+// Splits the clearings in members into groups connected through other members, ordered by their lowest clearing
+[[nodiscard]] inline constexpr ComponentList get_connected_components(const AdjacencyMasks &adjacency, ClearingMask members = kAllClearingsMask)
+{
+    ComponentList result{};
+    ClearingMask remaining = members & kAllClearingsMask;
+    while (remaining != 0) {
+        const ClearingMask lowest = remaining & static_cast<ClearingMask>(-remaining);
+        const ClearingMask component = flood_fill(lowest, adjacency, members);
+        result.components[result.count++] = component;
+        remaining &= ~component;
+    }
+    return result;
+}
+
+[[nodiscard]] inline constexpr ClearingClearingConnectionList to_connection_list(ClearingMask clearings)
+{
+    ClearingClearingConnectionList result{};
+    while (clearings != 0) {
+        result.nodes[result.count++] = static_cast<uint8_t>(std::countr_zero(clearings));
+        clearings &= clearings - 1;
+    }
+    return result;
+}
+
 template <
     BoardType boardType,
     ClearingClearingConnectionType connectionType
@@ -746,22 +451,7 @@ std::expected<ClearingClearingConnectionList, ConnectionError> get_clearing_clea
     [[unlikely]] if (desiredIndex >= kTotalClearings) 
         return std::unexpected(ConnectionError{ConnectionError::Code::kIndexExceededNodeCount});
 
-    ClearingClearingConnectionList matchingConnectionList;
-    auto unroll = [&desiredIndex, &matchingConnectionList]<size_t... i>(std::index_sequence<i...>)
-    {
-        (([&desiredIndex, &matchingConnectionList] {
-            if (
-                i != desiredIndex &&
-                clearingClearingConnections[static_cast<size_t>(boardType)][desiredIndex][i] == connectionType
-            )
-            {
-                ++matchingConnectionList.count;
-                matchingConnectionList.nodes[matchingConnectionList.count] = i;
-            }
-        }()), ...);
-    }(std::make_index_sequence<kTotalClearings>{});
-
-    return matchingConnectionList;
+    return to_connection_list(get_adjacency_masks<boardType, connectionType>()[desiredIndex]);
 }
 
 template  <
@@ -773,47 +463,467 @@ template  <
 ClearingClearingConnectionList get_clearing_clearing_connections_filtered() {
     static_assert(desiredIndex < kTotalClearings, "Index exceeded node count");
 
-    ClearingClearingConnectionList matchingConnectionList;
-    auto unroll = [&matchingConnectionList]<size_t... i>(std::index_sequence<i...>)
-    {
-        (([&matchingConnectionList] {
-            if constexpr (i != desiredIndex)
-            {
-                if constexpr (clearingClearingConnections[static_cast<size_t>(boardType)][desiredIndex][i] == connectionType) {
-                    ++matchingConnectionList.count;
-                    matchingConnectionList.nodes[matchingConnectionList.count] = i;
+    return to_connection_list(get_adjacency_masks<boardType, connectionType>()[desiredIndex]);
+}
+
+enum class PathGraph : uint8_t {
+    kLand,
+    kLandAndWater,
+    kWater,
+    // Rivers are already their own edges between clearings, so treating them as roads is the combined graph
+    kRiversAreRoads = kLandAndWater
+};
+static constexpr uint8_t kTotalPathGraphs = 3;
+
+/*
+    64 Bits: Packed Path Row {
+        4 Bits: Value for destination clearing i
+    } x 12 for each clearing, upper 16 bits unused
+
+    A distance of kUnreachable means no path exists, and the next hop of such a pair is kUnreachable too
+*/
+using PathRow = uint64_t;
+
+static constexpr uint8_t kPathNibbleBits = 4;
+static constexpr uint8_t kUnreachable = 0xF;
+static_assert(kTotalClearings * kPathNibbleBits <= sizeof(PathRow) * 8, "Path row must fit every clearing");
+static_assert(kTotalClearings < kUnreachable, "Longest path must stay below the unreachable marker");
+
+struct PathTable
+{
+    std::array<PathRow, kTotalClearings> distances;
+    std::array<PathRow, kTotalClearings> nextHops;
+};
+
+[[nodiscard]] inline constexpr uint8_t get_path_nibble(PathRow row, uint8_t clearing)
+{
+    return static_cast<uint8_t>((row >> (clearing * kPathNibbleBits)) & kUnreachable);
+}
+
+// Breadth first search from origin one frontier mask at a time
+[[nodiscard]] inline constexpr PathRow compute_distance_row(uint8_t origin, const AdjacencyMasks &adjacency)
+{
+    constexpr PathRow kAllUnreachable = (PathRow(1) << (kTotalClearings * kPathNibbleBits)) - 1;
+
+    PathRow row = kAllUnreachable & ~(PathRow(kUnreachable) << (origin * kPathNibbleBits));
+    ClearingMask reached = static_cast<ClearingMask>(1U << origin);
+    ClearingMask frontier = reached;
+
+    for (uint8_t distance = 1; frontier != 0; ++distance) {
+        frontier = get_neighbours(frontier, adjacency) & ~reached;
+        reached |= frontier;
+        for (ClearingMask remaining = frontier; remaining != 0; remaining &= remaining - 1) {
+            const uint8_t clearing = static_cast<uint8_t>(std::countr_zero(remaining));
+            row &= ~(PathRow(kUnreachable) << (clearing * kPathNibbleBits));
+            row |= PathRow(distance) << (clearing * kPathNibbleBits);
+        }
+    }
+    return row;
+}
+
+// Next hops go to the lowest numbered neighbour on a shortest path, so equal boards always route the same way.
+// Needs the distance rows of origin and all of its neighbours to be current
+[[nodiscard]] inline constexpr PathRow compute_next_hop_row(
+    uint8_t origin,
+    const std::array<PathRow, kTotalClearings> &distances,
+    const AdjacencyMasks &adjacency
+) {
+    PathRow row = 0;
+    for (uint8_t destination = 0; destination < kTotalClearings; ++destination) {
+        const uint8_t distance = get_path_nibble(distances[origin], destination);
+
+        uint8_t hop = kUnreachable;
+        if (destination == origin) {
+            hop = origin;
+        } else if (distance != kUnreachable) {
+            for (ClearingMask neighbours = adjacency[origin]; neighbours != 0; neighbours &= neighbours - 1) {
+                const uint8_t neighbour = static_cast<uint8_t>(std::countr_zero(neighbours));
+                if (get_path_nibble(distances[neighbour], destination) == distance - 1) {
+                    hop = neighbour;
+                    break;
                 }
             }
-        }()), ...);
-    }(std::make_index_sequence<kTotalClearings>{});
+        }
+        row |= PathRow(hop) << (destination * kPathNibbleBits);
+    }
+    return row;
+}
+
+[[nodiscard]] inline constexpr PathTable compute_path_table(const AdjacencyMasks &adjacency)
+{
+    PathTable result{};
+    for (uint8_t origin = 0; origin < kTotalClearings; ++origin)
+        result.distances[origin] = compute_distance_row(origin, adjacency);
+    for (uint8_t origin = 0; origin < kTotalClearings; ++origin)
+        result.nextHops[origin] = compute_next_hop_row(origin, result.distances, adjacency);
+    return result;
+}
+
+/*
+    Rebuilds only the rows an added or removed edge between a and b can change, adjacency must already include the
+    change. An origin whose distances to a and b differ by at least two gains a shortcut when the edge opens, and one
+    whose distances differ by exactly one may lose its shortest path when it closes. Every other row keeps its
+    distances, and next hops only move for those rows, their neighbours and the two endpoints
+*/
+inline constexpr void update_path_table(PathTable &table, const AdjacencyMasks &adjacency, uint8_t a, uint8_t b, bool edgeAdded)
+{
+    ClearingMask changedRows = 0;
+    for (uint8_t origin = 0; origin < kTotalClearings; ++origin) {
+        const uint8_t toA = get_path_nibble(table.distances[origin], a);
+        const uint8_t toB = get_path_nibble(table.distances[origin], b);
+        const uint8_t gap = (toA > toB) ? toA - toB : toB - toA;
+
+        if (edgeAdded ? gap >= 2 : (gap == 1 && toA != kUnreachable && toB != kUnreachable))
+            changedRows |= static_cast<ClearingMask>(1U << origin);
+    }
+
+    for (ClearingMask rows = changedRows; rows != 0; rows &= rows - 1) {
+        const uint8_t origin = static_cast<uint8_t>(std::countr_zero(rows));
+        table.distances[origin] = compute_distance_row(origin, adjacency);
+    }
 
-    return matchingConnectionList;
+    const ClearingMask staleHops = changedRows | get_neighbours(changedRows, adjacency) | static_cast<ClearingMask>((1U << a) | (1U << b));
+    for (ClearingMask rows = staleHops; rows != 0; rows &= rows - 1) {
+        const uint8_t origin = static_cast<uint8_t>(std::countr_zero(rows));
+        table.nextHops[origin] = compute_next_hop_row(origin, table.distances, adjacency);
+    }
 }
 
+static constexpr std::array<std::array<PathTable, kTotalPathGraphs>, kTotalBoardTypes> pathTables{[]{
+    std::array<std::array<PathTable, kTotalPathGraphs>, kTotalBoardTypes> result{};
+    for (uint8_t board = 0; board < kTotalBoardTypes; ++board) {
+        result[board][static_cast<uint8_t>(PathGraph::kLand)] = compute_path_table(clearingAdjacency[board].land);
+        result[board][static_cast<uint8_t>(PathGraph::kLandAndWater)] = compute_path_table(clearingAdjacency[board].any);
+        result[board][static_cast<uint8_t>(PathGraph::kWater)] = compute_path_table(clearingAdjacency[board].water);
+    }
+    return result;
+}()};
+
+// Unchecked lookups for hot loops, both indices must be below kTotalClearings
+template <BoardType boardType, PathGraph graph = PathGraph::kLand>
+[[nodiscard]] inline constexpr uint8_t get_distance(uint8_t originIndex, uint8_t destinationIndex)
+{
+    return get_path_nibble(pathTables[static_cast<size_t>(boardType)][static_cast<size_t>(graph)].distances[originIndex], destinationIndex);
+}
+
+template <BoardType boardType, PathGraph graph = PathGraph::kLand>
+[[nodiscard]] inline constexpr uint8_t get_next_hop(uint8_t originIndex, uint8_t destinationIndex)
+{
+    return get_path_nibble(pathTables[static_cast<size_t>(boardType)][static_cast<size_t>(graph)].nextHops[originIndex], destinationIndex);
+}
+
+// Distance to the closest clearing in targets, kUnreachable if none can be reached
+template <BoardType boardType, PathGraph graph = PathGraph::kLand>
+[[nodiscard]] inline constexpr uint8_t get_distance_to_nearest(uint8_t originIndex, ClearingMask targets)
+{
+    const PathRow row = pathTables[static_cast<size_t>(boardType)][static_cast<size_t>(graph)].distances[originIndex];
+
+    uint8_t result = kUnreachable;
+    for (; targets != 0; targets &= targets - 1)
+        result = std::min(result, get_path_nibble(row, static_cast<uint8_t>(std::countr_zero(targets))));
+    return result;
+}
+
+template <BoardType boardType, PathGraph graph = PathGraph::kLand>
+[[nodiscard]] inline constexpr std::expected<uint8_t, ConnectionError> get_distance_checked(uint8_t originIndex, uint8_t destinationIndex)
+{
+    [[unlikely]] if (originIndex >= kTotalClearings || destinationIndex >= kTotalClearings)
+        return std::unexpected(ConnectionError{ConnectionError::Code::kIndexExceededNodeCount});
+
+    return get_distance<boardType, graph>(originIndex, destinationIndex);
+}
+
+struct FeatureError {
+    enum class Code : uint8_t {
+        kIndexExceededClearingCount,
+        kNoLandmarkGiven,
+        kNoRuinInClearing,
+        kLandmarkUpdateFailed,
+        kBuildingUpdateFailed,
+        kUnknownError
+    } code;
+
+    static constexpr std::array<std::string_view, 6> kMessages = {
+        "Index exceeded clearing count",
+        "Landmark::kNone is not a landmark that can be placed",
+        "No ruin left in that clearing",
+        "Could not update the landmarks of the clearing",
+        "Could not update the buildings of the clearing",
+        "Unknown error"
+    };
+
+    [[nodiscard]] static std::string_view to_string(Code code) {
+        uint8_t idx = static_cast<uint8_t>(code);
+        if (idx < kMessages.size()) return kMessages[idx];
+        return kMessages.back();
+    }
+
+    [[nodiscard]] std::string_view message() const { return to_string(code); }
+};
+
+// Stands in for a clearing index when a feature is not on the board
+static constexpr uint8_t kNoClearing = kTotalClearings;
+
+// Where the landmarks, ruins and Elder Treetop are, so effects tied to a feature don't have to scan every clearing.
+// Only the Board setters that move these features keep it in sync with the clearing data
+struct FeatureIndex
+{
+    // Indexed by Landmark - 1, since kNone is never placed
+    std::array<uint8_t, clearing_data::landmark_data::kTotalLandmarks> landmarkClearings;
+    // Bit i set = ruin in clearing i
+    uint16_t ruinsMask;
+    uint8_t treetopClearing;
+};
+
+[[nodiscard]] consteval FeatureIndex make_starting_feature_index(BoardType boardType)
+{
+    using clearing_data::landmark_data::Landmark;
+
+    FeatureIndex result{};
+    result.landmarkClearings.fill(kNoClearing);
+    result.ruinsMask = 0;
+    result.treetopClearing = kNoClearing;
+
+    for (uint8_t clearing = 0; clearing < kTotalClearings; ++clearing) {
+        const Landmark landmark = startingLandmarks[static_cast<size_t>(boardType)][clearing];
+        if (landmark != Landmark::kNone)
+            result.landmarkClearings[static_cast<uint8_t>(landmark) - 1] = clearing;
+
+        if (startingRuins[static_cast<size_t>(boardType)][clearing])
+            result.ruinsMask |= 1U << clearing;
+    }
+    return result;
+}
+
+template <BoardType boardType, size_t clearingIndex>
+using BoardClearing = clearing_data::Clearing<
+    clearingTypes[static_cast<size_t>(boardType)][clearingIndex],
+    startingBuildingSlotCounts[static_cast<size_t>(boardType)][clearingIndex],
+    startingRuins[static_cast<size_t>(boardType)][clearingIndex],
+    startingLandmarks[static_cast<size_t>(boardType)][clearingIndex]
+>;
+
+static_assert(kTotalClearings == zobrist::kClearings, "Every clearing needs its own Zobrist keys");
+
+template <size_t clearingIndex, typename ClearingType>
+struct ClearingSlot
+{
+    ClearingType clearing;
+
+    [[nodiscard]] bool operator==(const ClearingSlot &other) const = default;
+};
+
+// Stands in for std::tuple, whose user provided copy assignment would keep Board from being trivially copyable
+template <typename Indices, typename... Clearings>
+struct ClearingTuple;
+
+template <size_t... I, typename... Clearings>
+struct ClearingTuple<std::index_sequence<I...>, Clearings...> : ClearingSlot<I, Clearings>...
+{
+    [[nodiscard]] bool operator==(const ClearingTuple &other) const = default;
+};
+
+template <size_t clearingIndex, typename ClearingType>
+[[nodiscard]] inline constexpr ClearingType &get_clearing(ClearingSlot<clearingIndex, ClearingType> &slot) { return slot.clearing; }
+
+template <size_t clearingIndex, typename ClearingType>
+[[nodiscard]] inline constexpr const ClearingType &get_clearing(const ClearingSlot<clearingIndex, ClearingType> &slot) { return slot.clearing; }
+
 template<BoardType boardType>
 class Board
 {
-private:
-    r123::Threefry2x32_R<12>::ctr_type ctr;
-    const r123::Threefry2x32_R<12>::key_type &key;
 public:
     std::array<forest_data::Forest, kTotalForests> forests;
 
-    decltype([]<std::size_t... I>(r123::Threefry2x32_R<12>::ctr_type& ctr, const r123::Threefry2x32_R<12>::key_type& key, std::index_sequence<I...>) {
-        return std::make_tuple(
-            clearing_data::Clearing<
-                clearingTypes[static_cast<size_t>(boardType)][I],
-                startingBuildingSlotCounts[static_cast<size_t>(boardType)][I],
-                startingRuins[static_cast<size_t>(boardType)][I]
-            >(ctr, key)...
-        );
-    }(
-        ctr, key, std::make_index_sequence<kTotalClearings>{}
-    )) clearings;
+private:
+    static constexpr auto kMakeClearings = []<std::size_t... I>(std::index_sequence<I...>) {
+        return ClearingTuple<std::index_sequence<I...>, BoardClearing<boardType, I>...>{
+            {BoardClearing<boardType, I>(static_cast<uint8_t>(I))}...
+        };
+    };
+public:
+    decltype(kMakeClearings(std::make_index_sequence<kTotalClearings>{})) clearings;
+
+    // Printed suits only, clearings without one hold kRandom until apply_suit_setup deals them a suit
+    consteval Board() : forests{}, clearings(kMakeClearings(std::make_index_sequence<kTotalClearings>{})) {}
+
+    // Folds the per forest and per clearing hashes in index order
+    [[nodiscard]] inline uint64_t get_hash(uint64_t seed = ::game_data::kHashSeed) const
+    {
+        uint64_t hash = seed;
+        for (const forest_data::Forest &forest : forests)
+            hash = ::game_data::hash_combine(hash, forest.get_hash());
+
+        [this, &hash]<std::size_t... I>(std::index_sequence<I...>) {
+            ((hash = ::game_data::hash_combine(hash, get_clearing<I>(clearings).get_hash())), ...);
+        }(std::make_index_sequence<kTotalClearings>{});
+        return hash;
+    }
+
+    // Clearings keep their own Zobrist keys current and key by their index, so the board's is their plain sum
+    [[nodiscard]] inline uint64_t get_zobrist_key() const
+    {
+        uint64_t key = 0;
+        [this, &key]<std::size_t... I>(std::index_sequence<I...>) {
+            ((key += get_clearing<I>(clearings).get_zobrist_key()), ...);
+        }(std::make_index_sequence<kTotalClearings>{});
+        return key;
+    }
+
+    [[nodiscard]] inline bool operator==(const Board &other) const
+    {
+        return forests == other.forests && clearings == other.clearings;
+    }
+
+    // Gives every clearing without a printed suit its suit from a balanced setup, printed suits are left alone
+    inline void apply_suit_setup(suit_setup::PackedSuitSetup setup)
+    {
+        [this, setup]<std::size_t... I>(std::index_sequence<I...>) {
+            ((clearingTypes[static_cast<size_t>(boardType)][I] == clearing_data::ClearingType::kRandom
+                ? void(get_clearing<I>(clearings).clearingType = suit_setup::get_clearing_type(setup, I))
+                : void()), ...);
+        }(std::make_index_sequence<kTotalClearings>{});
+    }
+
+    // Calls function on the clearing at a runtime index, which must be below kTotalClearings. Every clearing has its own
+    // type, so function has to be generic and return the same type for all of them
+    template <typename Function>
+    inline auto visit_clearing(uint8_t clearingIndex, Function &&function)
+    {
+        return visit_clearing_impl(clearings, clearingIndex, function);
+    }
+
+    template <typename Function>
+    inline auto visit_clearing(uint8_t clearingIndex, Function &&function) const
+    {
+        return visit_clearing_impl(clearings, clearingIndex, function);
+    }
+
+    [[nodiscard]] inline uint8_t get_landmark_clearing(clearing_data::landmark_data::Landmark landmark) const
+    {
+        [[unlikely]] if (landmark == clearing_data::landmark_data::Landmark::kNone)
+            return kNoClearing;
+        return featureIndex.landmarkClearings[static_cast<uint8_t>(landmark) - 1];
+    }
+
+    [[nodiscard]] inline uint16_t get_ruins_mask() const { return featureIndex.ruinsMask; }
+    [[nodiscard]] inline uint8_t get_elder_treetop_clearing() const { return featureIndex.treetopClearing; }
+
+    // Moves a landmark to another clearing, or takes it off the board when newClearingIndex is kNoClearing
+    inline std::expected<void, FeatureError> move_landmark(clearing_data::landmark_data::Landmark landmark, uint8_t newClearingIndex)
+    {
+        using clearing_data::landmark_data::LandmarkStatusPair;
+
+        [[unlikely]] if (landmark == clearing_data::landmark_data::Landmark::kNone)
+            return std::unexpected(FeatureError{FeatureError::Code::kNoLandmarkGiven});
+
+        [[unlikely]] if (newClearingIndex > kNoClearing)
+            return std::unexpected(FeatureError{FeatureError::Code::kIndexExceededClearingCount});
+
+        uint8_t &landmarkClearing = featureIndex.landmarkClearings[static_cast<uint8_t>(landmark) - 1];
+        const auto setStatus = [landmark](bool status) {
+            return [landmark, status](auto &clearing) {
+                return clearing.set_landmarks(std::vector<LandmarkStatusPair>{{landmark, status}});
+            };
+        };
+
+        if (landmarkClearing != kNoClearing) {
+            [[unlikely]] if (!visit_clearing(landmarkClearing, setStatus(false)).has_value())
+                return std::unexpected(FeatureError{FeatureError::Code::kLandmarkUpdateFailed});
+        }
+
+        if (newClearingIndex != kNoClearing) {
+            [[unlikely]] if (!visit_clearing(newClearingIndex, setStatus(true)).has_value())
+                return std::unexpected(FeatureError{FeatureError::Code::kLandmarkUpdateFailed});
+        }
+
+        landmarkClearing = newClearingIndex;
+        return {};
+    }
+
+    inline std::expected<void, FeatureError> remove_ruin(uint8_t clearingIndex)
+    {
+        [[unlikely]] if (clearingIndex >= kTotalClearings)
+            return std::unexpected(FeatureError{FeatureError::Code::kIndexExceededClearingCount});
+
+        [[unlikely]] if ((featureIndex.ruinsMask & (1U << clearingIndex)) == 0)
+            return std::unexpected(FeatureError{FeatureError::Code::kNoRuinInClearing});
+
+        const std::expected<void, FeatureError> result = visit_clearing(clearingIndex, [](auto &clearing) -> std::expected<void, FeatureError> {
+            const auto buildings = clearing.get_occupied_building_slots();
+            [[unlikely]] if (!buildings.has_value())
+                return std::unexpected(FeatureError{FeatureError::Code::kBuildingUpdateFailed});
+
+            const auto ruin = std::find(buildings.value().begin(), buildings.value().end(), clearing_data::building_data::Building::kRuin);
+            [[unlikely]] if (ruin == buildings.value().end())
+                return std::unexpected(FeatureError{FeatureError::Code::kNoRuinInClearing});
+
+            const uint8_t ruinSlot = static_cast<uint8_t>(ruin - buildings.value().begin());
+            return clearing.remove_buildings(std::vector<uint8_t>{ruinSlot})
+                .transform_error([](clearing_data::building_data::BuildingError)
+                    { return FeatureError{FeatureError::Code::kBuildingUpdateFailed}; });
+        });
+        [[unlikely]] if (!result.has_value())
+            return result;
+
+        featureIndex.ruinsMask &= ~(1U << clearingIndex);
+        return {};
+    }
+
+    // Places the Elder Treetop in a building slot of a clearing, taking it out of whichever clearing held it before
+    inline std::expected<void, FeatureError> set_elder_treetop(uint8_t clearingIndex, clearing_data::ElderTreetopIndex slot)
+    {
+        using clearing_data::ElderTreetopIndex;
+
+        [[unlikely]] if (clearingIndex >= kTotalClearings)
+            return std::unexpected(FeatureError{FeatureError::Code::kIndexExceededClearingCount});
+
+        const auto setSlot = [](ElderTreetopIndex newSlot) {
+            return [newSlot](auto &clearing) { return clearing.set_elder_treetop_index(newSlot); };
+        };
+
+        if (featureIndex.treetopClearing != kNoClearing && featureIndex.treetopClearing != clearingIndex) {
+            [[unlikely]] if (!visit_clearing(featureIndex.treetopClearing, setSlot(ElderTreetopIndex::kNotPresent)).has_value())
+                return std::unexpected(FeatureError{FeatureError::Code::kBuildingUpdateFailed});
+        }
+
+        [[unlikely]] if (!visit_clearing(clearingIndex, setSlot(slot)).has_value())
+            return std::unexpected(FeatureError{FeatureError::Code::kBuildingUpdateFailed});
+
+        featureIndex.treetopClearing = (slot == ElderTreetopIndex::kNotPresent) ? kNoClearing : clearingIndex;
+        return {};
+    }
+
+    [[nodiscard]] inline pawn_histogram::PawnWords get_pawn_words() const
+    {
+        return [this]<std::size_t... I>(std::index_sequence<I...>) {
+            return pawn_histogram::PawnWords{get_clearing<I>(clearings).get_pawn_word()...};
+        }(std::make_index_sequence<kTotalClearings>{});
+    }
 
-    consteval Board(r123::Threefry2x32_R<12>::ctr_type &ctr, const r123::Threefry2x32_R<12>::key_type &key) : ctr(ctr), key(key) {};
+    [[nodiscard]] inline pawn_histogram::PawnHistogram get_pawn_histogram() const
+    {
+        return pawn_histogram::PawnHistogram(get_pawn_words());
+    }
 
 private:
+    FeatureIndex featureIndex = make_starting_feature_index(boardType);
+
+    template <typename Clearings, typename Function>
+    static inline auto visit_clearing_impl(Clearings &clearings, uint8_t clearingIndex, Function &function)
+    {
+        using Result = decltype(function(get_clearing<0>(clearings)));
+        return [&clearings, clearingIndex, &function]<std::size_t... I>(std::index_sequence<I...>) -> Result {
+            if constexpr (std::is_void_v<Result>) {
+                (void)((I == clearingIndex ? (function(get_clearing<I>(clearings)), true) : false) || ...);
+            } else {
+                Result result{};
+                (void)((I == clearingIndex ? (result = function(get_clearing<I>(clearings)), true) : false) || ...);
+                return result;
+            }
+        }(std::make_index_sequence<kTotalClearings>{});
+    }
+
     static constexpr uint8_t kClearingClearingConnectionBits = 2;
     static constexpr uint16_t kClearingClearingsConnectionsBits = kTotalClearings * kTotalClearings * kClearingClearingConnectionBits;
 
@@ -826,26 +936,69 @@ private:
 
 template<>
 class Board<BoardType::kMountain> {
+    // Every closed path as a mask per clearing, these are land connections missing from clearingAdjacency
+    static constexpr AdjacencyMasks kClosedPathMasks = generated::kClosedPathMasks[static_cast<size_t>(BoardType::kMountain)];
+
     static constexpr std::bitset<kTotalClearings * kTotalClearings> initialBlockedConnections{[]{
         std::bitset<kTotalClearings * kTotalClearings> result{};
-        result.set(0 * kTotalClearings + 2, true);
-        result.set(0 * kTotalClearings + 3, true);
-        result.set(2 * kTotalClearings + 0, true);
-        result.set(3 * kTotalClearings + 0, true);
-        result.set(3 * kTotalClearings + 6, true);
-        result.set(5 * kTotalClearings + 7, true);
-        result.set(6 * kTotalClearings + 3, true);
-        result.set(7 * kTotalClearings + 5, true);
-        result.set(7 * kTotalClearings + 8, true);
-        result.set(8 * kTotalClearings + 7, true);
-        result.set(9 * kTotalClearings + 11, true);
-        result.set(11 * kTotalClearings + 9, true);
-
+        for (uint8_t origin = 0; origin < kTotalClearings; ++origin)
+            for (uint8_t destination = 0; destination < kTotalClearings; ++destination)
+                if ((kClosedPathMasks[origin] >> destination) & 1)
+                    result.set(origin * kTotalClearings + destination, true);
         return result;
     }()};
 
     std::bitset<kTotalClearings * kTotalClearings> blockedConnections = initialBlockedConnections;
 
+    // Adjacency and path tables with every currently open path included. Only land routes can cross a path, so the
+    // water table never changes and stays in pathTables
+    AdjacencyMasks landAdjacency = clearingAdjacency[static_cast<size_t>(BoardType::kMountain)].land;
+    AdjacencyMasks anyAdjacency = clearingAdjacency[static_cast<size_t>(BoardType::kMountain)].any;
+    PathTable landPaths = pathTables[static_cast<size_t>(BoardType::kMountain)][static_cast<size_t>(PathGraph::kLand)];
+    PathTable anyPaths = pathTables[static_cast<size_t>(BoardType::kMountain)][static_cast<size_t>(PathGraph::kLandAndWater)];
+
+    // Toggled for every path that differs from the printed board, so the starting board keys to 0
+    uint64_t zobristKey = 0;
+
+    [[nodiscard]] static constexpr bool is_path(uint8_t originIndex, uint8_t destinationIndex)
+    {
+        return (kClosedPathMasks[originIndex] >> destinationIndex) & 1;
+    }
+
+    // Only for printed paths, callers check is_path first
+    inline constexpr void update_paths(uint8_t originIndex, uint8_t destinationIndex, bool newStatus)
+    {
+        // Paths are two way, the bitset keeps both directions so lookups from either end agree
+        const bool wasBlocked = blockedConnections[originIndex * kTotalClearings + destinationIndex];
+        blockedConnections[originIndex * kTotalClearings + destinationIndex] = newStatus;
+        blockedConnections[destinationIndex * kTotalClearings + originIndex] = newStatus;
+        if (wasBlocked == newStatus)
+            return;
+
+        zobristKey ^= zobrist::make_key(zobrist::KeyStream::kClosedPath,
+            std::min(originIndex, destinationIndex) * kTotalClearings + std::max(originIndex, destinationIndex));
+
+        const ClearingMask originBit = static_cast<ClearingMask>(1U << originIndex);
+        const ClearingMask destinationBit = static_cast<ClearingMask>(1U << destinationIndex);
+        if (newStatus) {
+            landAdjacency[originIndex] &= ~destinationBit;
+            landAdjacency[destinationIndex] &= ~originBit;
+            anyAdjacency[originIndex] &= ~destinationBit;
+            anyAdjacency[destinationIndex] &= ~originBit;
+        } else {
+            landAdjacency[originIndex] |= destinationBit;
+            landAdjacency[destinationIndex] |= originBit;
+            anyAdjacency[originIndex] |= destinationBit;
+            anyAdjacency[destinationIndex] |= originBit;
+        }
+
+        update_path_table(landPaths, landAdjacency, originIndex, destinationIndex, !newStatus);
+        update_path_table(anyPaths, anyAdjacency, originIndex, destinationIndex, !newStatus);
+    }
+
+public:
+    [[nodiscard]] inline uint64_t get_zobrist_key() const { return zobristKey; }
+
     [[nodiscard]] inline std::expected<bool, ConnectionError> is_connection_blocked(uint8_t originIndex, uint8_t destinationIndex) const
     {
         [[unlikely]] if (originIndex == destinationIndex)
@@ -858,7 +1011,7 @@ class Board<BoardType::kMountain> {
     }
 
     template <uint8_t originIndex, uint8_t destinationIndex>
-    [[nodiscard]] consteval inline bool is_connection_blocked() const
+    [[nodiscard]] inline bool is_connection_blocked() const
     {
         static_assert(originIndex != destinationIndex, "Duplicate indices are not allowed");
         static_assert(originIndex < kTotalClearings && destinationIndex < kTotalClearings, "Index exceeded node count");
@@ -874,7 +1027,11 @@ class Board<BoardType::kMountain> {
         [[unlikely]] if (originIndex >= kTotalClearings || destinationIndex >= kTotalClearings)
             return std::unexpected(ConnectionError{ConnectionError::Code::kIndexExceededNodeCount});
 
-        blockedConnections[originIndex * kTotalClearings + destinationIndex] = newStatus;
+        // Anything else would leave the blocked bits disagreeing with the adjacency and path tables
+        [[unlikely]] if (!is_path(originIndex, destinationIndex))
+            return std::unexpected(ConnectionError{ConnectionError::Code::kNotAPath});
+
+        update_paths(originIndex, destinationIndex, newStatus);
         return {};
     }
 
@@ -883,8 +1040,34 @@ class Board<BoardType::kMountain> {
     {
         static_assert(originIndex != destinationIndex, "Duplicate indices are not allowed");
         static_assert(originIndex < kTotalClearings && destinationIndex < kTotalClearings, "Index exceeded node count");
+        static_assert(is_path(originIndex, destinationIndex), "Only the printed paths can be blocked or cleared");
 
-        blockedConnections[originIndex * kTotalClearings + destinationIndex] = newStatus;
+        update_paths(originIndex, destinationIndex, newStatus);
+    }
+
+    [[nodiscard]] inline const AdjacencyMasks &get_land_adjacency() const { return landAdjacency; }
+    [[nodiscard]] inline const AdjacencyMasks &get_any_adjacency() const { return anyAdjacency; }
+
+    template <PathGraph graph = PathGraph::kLand>
+    [[nodiscard]] inline uint8_t get_distance(uint8_t originIndex, uint8_t destinationIndex) const
+    {
+        if constexpr (graph == PathGraph::kLand)
+            return get_path_nibble(landPaths.distances[originIndex], destinationIndex);
+        else if constexpr (graph == PathGraph::kLandAndWater)
+            return get_path_nibble(anyPaths.distances[originIndex], destinationIndex);
+        else
+            return board_data::get_distance<BoardType::kMountain, graph>(originIndex, destinationIndex);
+    }
+
+    template <PathGraph graph = PathGraph::kLand>
+    [[nodiscard]] inline uint8_t get_next_hop(uint8_t originIndex, uint8_t destinationIndex) const
+    {
+        if constexpr (graph == PathGraph::kLand)
+            return get_path_nibble(landPaths.nextHops[originIndex], destinationIndex);
+        else if constexpr (graph == PathGraph::kLandAndWater)
+            return get_path_nibble(anyPaths.nextHops[originIndex], destinationIndex);
+        else
+            return board_data::get_next_hop<BoardType::kMountain, graph>(originIndex, destinationIndex);
     }
     
     struct BlockedConnectionList {
@@ -906,26 +1089,21 @@ class Board<BoardType::kMountain> {
         kBlocked
     };
 
+    // Paths out of desiredIndex that are currently closed or have been cleared, depending on desiredType
     template <IsBlocked desiredType>
     [[nodiscard]] inline std::expected<BlockedConnectionList, ConnectionError> get_blocked_connections_with_status(uint8_t desiredIndex) const
     {
         [[unlikely]] if (desiredIndex >= kTotalClearings)
             return std::unexpected(ConnectionError{ConnectionError::Code::kIndexExceededNodeCount});
 
-        BlockedConnectionList matchingConnectionList;
-        auto unroll[&desiredIndex, &matchingConnectionList]<size_t... i>(std::index_sequenceM<i...>)
-        {
-            (([&desiredIndex, &matchingConnectionList] {
-                if (
-                    i != desiredIndex &&
-                    clearingClearingConnections[static_cast<size_t>(boardType)][desiredIndex][i] == desiredType
-                )
-                {
-                    ++matchingConnectionList.count;
-                    matchingConnectionList.nodes[matchingConnectionList.count] = i;
-                }
-            }()), ...);
-        }(std::make_index_sequence<kTotalClearings>{});
+        // A path is open exactly when its land connection has been added back
+        ClearingMask matches = kClosedPathMasks[desiredIndex] & landAdjacency[desiredIndex];
+        if constexpr (desiredType == IsBlocked::kBlocked)
+            matches = kClosedPathMasks[desiredIndex] & ~matches;
+
+        BlockedConnectionList matchingConnectionList{};
+        for (; matches != 0; matches &= matches - 1)
+            matchingConnectionList.nodes[matchingConnectionList.count++] = static_cast<uint8_t>(std::countr_zero(matches));
 
         return matchingConnectionList;
     }
@@ -0,0 +1,154 @@
+#pragma once
+
+#include "game_data.hpp"
+#include "clearing_data.hpp"
+#include "board_data.hpp"
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <expected>
+#include <string_view>
+#include <filesystem>
+#include <type_traits>
+
+namespace game_data
+{
+namespace board_data
+{
+namespace board_loader
+{
+
+namespace clearing_data = ::game_data::board_data::clearing_data;
+
+struct LoaderError {
+    enum class Code : uint8_t {
+        kFileOpenFailed,
+        kFileReadFailed,
+        kUnexpectedEndOfInput,
+        kUnexpectedCharacter,
+        kNestingTooDeep,
+        kMissingField,
+        kWrongFieldType,
+        kWrongClearingCount,
+        kTooManyForests,
+        kIndexOutOfRange,
+        kSelfConnection,
+        kUnknownClearingType,
+        kUnknownConnectionType,
+        kUnknownLandmark,
+        kAsymmetricConnection,
+        kForestListsDisagree,
+        kTableMismatch,
+        kCacheWriteFailed,
+        kCacheMapFailed,
+        kUnknownError
+    } code;
+
+    static constexpr std::array<std::string_view, 20> kMessages = {
+        "Could not open board file",
+        "Could not read board file",
+        "Board JSON ended unexpectedly",
+        "Unexpected character in board JSON",
+        "Board JSON is nested too deeply",
+        "Required field is missing from board JSON",
+        "Board JSON field has the wrong type",
+        "Board must describe exactly kTotalClearings clearings",
+        "Board describes more forests than kTotalForests",
+        "Connection index is out of range",
+        "Clearing cannot connect to itself",
+        "Unknown clearing type",
+        "Unknown connection type",
+        "Unknown landmark",
+        "Clearing connection is only listed from one side",
+        "Clearing and forest connection lists disagree",
+        "Board does not match the compiled board tables",
+        "Could not write board cache",
+        "Could not map board cache",
+        "Unknown error"
+    };
+
+    [[nodiscard]] static std::string_view to_string(Code code) {
+        uint8_t idx = static_cast<uint8_t>(code);
+        [[likely]] if (idx < kMessages.size()) return kMessages[idx];
+        return kMessages.back();
+    }
+
+    [[nodiscard]] inline std::string_view message() const { return to_string(code); }
+};
+
+/*
+    Everything the engine derives from a board file, in the same mask and path table layouts the compiled boards
+    use. Trivially copyable so the binary cache is just this struct behind a header
+*/
+struct BoardDescription
+{
+    std::array<clearing_data::ClearingType, kTotalClearings> clearingTypes;
+    std::array<uint8_t, kTotalClearings> buildingSlotCounts;
+    ClearingMask ruinsMask;
+    // Landmark field bits as produced by landmark_data::get_landmark_bit
+    std::array<uint8_t, kTotalClearings> landmarkBits;
+    BoardAdjacency adjacency;
+    // Paths that start closed (Mountain), kept out of adjacency like the compiled tables do
+    AdjacencyMasks closedPaths;
+    ForestIncidence forests;
+    uint8_t totalForests;
+    std::array<PathTable, kTotalPathGraphs> paths;
+};
+static_assert(std::is_trivially_copyable_v<BoardDescription>, "Board descriptions are cached as raw bytes");
+
+/*
+    Parses one assets/boards file. Indices in the file start at 1. The total* fields only repeat the list lengths
+    and are ignored, so hand edited files cannot disagree with themselves
+*/
+[[nodiscard]] std::expected<BoardDescription, LoaderError> parse_board_description(std::string_view json);
+
+// Checks the description against itself: connections listed from both ends, forest lists agreeing from both sides
+[[nodiscard]] std::expected<void, LoaderError> validate_board_description(const BoardDescription &description);
+
+// Checks the description against the compiled tables of boardType
+[[nodiscard]] std::expected<void, LoaderError> compare_with_tables(const BoardDescription &description, BoardType boardType);
+
+/*
+    Read only view of a board description backed by a memory mapped cache file. The cache is rebuilt from the JSON
+    whenever its version, layout size or the JSON's size and modification time no longer match
+*/
+class BoardCache
+{
+public:
+    static constexpr uint32_t kMagic = 0x44524242; // "BBRD"
+    static constexpr uint32_t kVersion = 2;
+
+    [[nodiscard]] static std::expected<BoardCache, LoaderError> open(const std::filesystem::path &jsonPath, const std::filesystem::path &cachePath);
+
+    BoardCache(const BoardCache &) = delete;
+    BoardCache &operator=(const BoardCache &) = delete;
+    BoardCache(BoardCache &&other) noexcept;
+    BoardCache &operator=(BoardCache &&other) noexcept;
+    ~BoardCache();
+
+    [[nodiscard]] inline const BoardDescription &get_description() const { return *description; }
+
+private:
+    struct alignas(64) Header
+    {
+        uint32_t magic;
+        uint32_t version;
+        uint64_t payloadSize;
+        uint64_t sourceSize;
+        int64_t sourceWriteTime;
+    };
+    static_assert(sizeof(Header) % alignof(BoardDescription) == 0, "Payload must stay aligned after the header");
+
+    BoardCache(void *mapping, size_t mappingSize);
+
+    [[nodiscard]] static std::expected<BoardCache, LoaderError> map(const std::filesystem::path &cachePath, const Header &expected);
+    [[nodiscard]] static std::expected<void, LoaderError> write(const std::filesystem::path &cachePath, const Header &header, const BoardDescription &description);
+
+    void *mapping = nullptr;
+    size_t mappingSize = 0;
+    const BoardDescription *description = nullptr;
+};
+} // board_loader
+} // board_data
+} // game_data
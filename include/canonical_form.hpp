@@ -0,0 +1,245 @@
+#pragma once
+
+#include "game_data.hpp"
+#include "card_data.hpp"
+#include "clearing_data.hpp"
+#include "token_data.hpp"
+#include "board_data.hpp"
+#include "suit_setup.hpp"
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <type_traits>
+
+namespace game_data
+{
+namespace canonical_form
+{
+
+namespace card_data = ::game_data::card_data;
+namespace board_data = ::game_data::board_data;
+namespace clearing_data = ::game_data::board_data::clearing_data;
+namespace building_data = ::game_data::board_data::clearing_data::building_data;
+namespace token_data = ::game_data::token_data;
+namespace suit_setup = ::game_data::board_data::suit_setup;
+
+using suit_setup::kTotalSuits;
+using suit_setup::kSuitBits;
+
+/*
+    Suits only matter relative to each other and to the cards, so two positions that differ by a relabeling of
+    Mouse, Fox and Rabbit play out the same. Birds are never relabeled. A canonical form picks one representative of
+    each such class so transposition tables and training data can merge them.
+
+    Only boards whose suits are dealt (kRandom clearings) can be relabeled; a printed board only admits the identity
+*/
+static constexpr uint8_t kTotalSuitPermutations = 6;
+using SuitPermutation = std::array<uint8_t, kTotalSuits>;
+
+// Every ordering of the suits in lexicographic order, so index 0 is the identity
+static constexpr std::array<SuitPermutation, kTotalSuitPermutations> kSuitPermutations{[]{
+    std::array<SuitPermutation, kTotalSuitPermutations> result{};
+    uint8_t index = 0;
+    for (uint8_t first = 0; first < kTotalSuits; ++first)
+        for (uint8_t second = 0; second < kTotalSuits; ++second)
+            for (uint8_t third = 0; third < kTotalSuits; ++third)
+                if (first != second && second != third && first != third)
+                    result[index++] = {first, second, third};
+    return result;
+}()};
+
+// kSuitPermutations[kInversePermutations[p]] undoes kSuitPermutations[p]
+static constexpr std::array<uint8_t, kTotalSuitPermutations> kInversePermutations{[]{
+    std::array<uint8_t, kTotalSuitPermutations> result{};
+    for (uint8_t permutation = 0; permutation < kTotalSuitPermutations; ++permutation) {
+        for (uint8_t inverse = 0; inverse < kTotalSuitPermutations; ++inverse) {
+            bool undoes = true;
+            for (uint8_t suit = 0; suit < kTotalSuits; ++suit)
+                undoes &= kSuitPermutations[inverse][kSuitPermutations[permutation][suit]] == suit;
+            if (undoes)
+                result[permutation] = inverse;
+        }
+    }
+    return result;
+}()};
+
+using card_data::kTotalCardIDs;
+
+// Copies of every CardID in one place a card can be told apart in (a hand, the discard pile, the decree...)
+using CardCounts = std::array<uint8_t, kTotalCardIDs>;
+
+namespace detail
+{
+using enum card_data::CardID;
+
+// Cards that exist once per suit, so relabeling a suit just swaps which of them a position holds
+static constexpr std::array<std::array<card_data::CardID, kTotalSuits>, 5> kSuitFamilies{{
+    {kMouseDominance, kFoxDominance, kRabbitDominance},
+    {kMouseAmbush, kFoxAmbush, kRabbitAmbush},
+    {kMouseRootTea, kFoxRootTea, kRabbitRootTea},
+    {kFavorOfTheMice, kFavorOfTheFoxes, kFavorOfTheRabbits},
+    {kMousePartisans, kFoxPartisans, kRabbitPartisans},
+}};
+} // detail
+
+// kCardPermutations[p][card] is the card that card becomes under kSuitPermutations[p]
+static constexpr std::array<std::array<card_data::CardID, kTotalCardIDs>, kTotalSuitPermutations> kCardPermutations{[]{
+    std::array<std::array<card_data::CardID, kTotalCardIDs>, kTotalSuitPermutations> result{};
+    for (uint8_t permutation = 0; permutation < kTotalSuitPermutations; ++permutation) {
+        for (uint8_t card = 0; card < kTotalCardIDs; ++card)
+            result[permutation][card] = static_cast<card_data::CardID>(card);
+        for (const auto &family : detail::kSuitFamilies)
+            for (uint8_t suit = 0; suit < kTotalSuits; ++suit)
+                result[permutation][static_cast<uint8_t>(family[suit])] = family[kSuitPermutations[permutation][suit]];
+    }
+    return result;
+}()};
+
+/*
+    Bit p set = holding the card still allows kSuitPermutations[p]. A Mouse, Fox or Rabbit card outside the families
+    pins its suit, a relabeling would turn it into a card that does not exist. Birds allow everything, kUnpinned cards
+    only the identity
+*/
+static constexpr std::array<uint8_t, kTotalCardIDs> kCardAllowedPermutations{[]{
+    constexpr uint8_t kIdentityOnly = 1;
+    std::array<uint8_t, kTotalCardIDs> result{};
+    for (uint8_t card = 0; card < kTotalCardIDs; ++card) {
+        const card_data::CardSuit suit = card_data::kCardSuits[card];
+        if (suit == card_data::CardSuit::kUnpinned) {
+            result[card] = kIdentityOnly;
+            continue;
+        }
+        if (suit == card_data::CardSuit::kBird) {
+            result[card] = (1U << kTotalSuitPermutations) - 1;
+            continue;
+        }
+
+        const uint8_t suitIndex = static_cast<uint8_t>(suit);
+        uint8_t allowed = 0;
+        for (uint8_t permutation = 0; permutation < kTotalSuitPermutations; ++permutation)
+            allowed |= static_cast<uint8_t>((kSuitPermutations[permutation][suitIndex] == suitIndex) << permutation);
+        result[card] = allowed;
+    }
+    // Family members are relabeled into each other instead
+    for (const auto &family : detail::kSuitFamilies)
+        for (card_data::CardID card : family)
+            result[static_cast<uint8_t>(card)] = (1U << kTotalSuitPermutations) - 1;
+    return result;
+}()};
+
+/*
+    Suit dependent pieces of one clearing, one nibble per suit: {
+        1 Bit: Woodland Alliance base
+        1 Bit: Riverfolk trade post
+        2 Bits: Lizard Cult gardens
+    } x 3 for each suit
+*/
+using SuitedPieces = uint16_t;
+static constexpr uint8_t kSuitedPieceBits = 4;
+
+/*
+    The parts of a board a suit relabeling acts on, plus a hash of everything it leaves alone. Suited buildings and
+    trade posts are folded to their Mouse version before hashing, so neutralHash is the same for every relabeling
+*/
+struct SuitedBoard
+{
+    suit_setup::PackedSuitSetup suits;
+    std::array<SuitedPieces, board_data::kTotalClearings> pieces;
+    bool printedSuits;
+    uint64_t neutralHash;
+};
+
+struct CanonicalForm
+{
+    // Index into kSuitPermutations taking the position to its canonical form
+    uint8_t permutation;
+    uint64_t hash;
+};
+
+[[nodiscard]] inline constexpr suit_setup::PackedSuitSetup permute_suits(suit_setup::PackedSuitSetup suits, uint8_t permutation)
+{
+    constexpr suit_setup::PackedSuitSetup kSuitMask = (1U << kSuitBits) - 1;
+
+    suit_setup::PackedSuitSetup result = 0;
+    for (uint8_t clearing = 0; clearing < board_data::kTotalClearings; ++clearing) {
+        const uint8_t suit = (suits >> (clearing * kSuitBits)) & kSuitMask;
+        result |= static_cast<suit_setup::PackedSuitSetup>(kSuitPermutations[permutation][suit]) << (clearing * kSuitBits);
+    }
+    return result;
+}
+
+[[nodiscard]] inline constexpr SuitedPieces permute_pieces(SuitedPieces pieces, uint8_t permutation)
+{
+    constexpr SuitedPieces kNibbleMask = (1U << kSuitedPieceBits) - 1;
+
+    SuitedPieces result = 0;
+    for (uint8_t suit = 0; suit < kTotalSuits; ++suit)
+        result |= static_cast<SuitedPieces>(((pieces >> (suit * kSuitedPieceBits)) & kNibbleMask) << (kSuitPermutations[permutation][suit] * kSuitedPieceBits));
+    return result;
+}
+
+// Relabelings the board and every held card allow, bit p = kSuitPermutations[p]. Always includes the identity
+[[nodiscard]] uint8_t get_allowed_permutations(const SuitedBoard &board, std::span<const CardCounts> cardZones);
+
+/*
+    Of all allowed relabelings picks the one whose suits, then suited pieces, then card zones compare lowest, and
+    hashes the position under it. Zones are compared and hashed in the order given, so callers must list them the
+    same way every time
+*/
+[[nodiscard]] CanonicalForm canonicalize(const SuitedBoard &board, std::span<const CardCounts> cardZones);
+
+template <board_data::BoardType boardType>
+[[nodiscard]] inline SuitedBoard gather_suited_board(const board_data::Board<boardType> &board)
+{
+    using enum building_data::Building;
+
+    SuitedBoard result{};
+    result.neutralHash = ::game_data::kHashSeed;
+    for (uint8_t clearingIndex = 0; clearingIndex < board_data::kTotalClearings; ++clearingIndex) {
+        result.printedSuits |= board_data::clearingTypes[static_cast<size_t>(boardType)][clearingIndex] != clearing_data::ClearingType::kRandom;
+
+        board.visit_clearing(clearingIndex, [&result, clearingIndex](const auto &clearing) {
+            using Clearing = std::remove_cvref_t<decltype(clearing)>;
+
+            const uint8_t suit = static_cast<uint8_t>(clearing.clearingType) - static_cast<uint8_t>(clearing_data::ClearingType::kMouse);
+            result.suits |= static_cast<suit_setup::PackedSuitSetup>(suit) << (clearingIndex * kSuitBits);
+
+            SuitedPieces pieces = 0;
+            uint64_t hash = ::game_data::hash_combine(result.neutralHash, clearing.get_pawn_word());
+            hash = ::game_data::hash_combine(hash, clearing.get_token_word() & ~Clearing::kAnyTradePostMask);
+            hash = ::game_data::hash_combine(hash, clearing.get_landmark_bits() | (uint64_t(clearing.is_razed()) << 8));
+            hash = ::game_data::hash_combine(hash, clearing.get_slot_count().value_or(0));
+            hash = ::game_data::hash_combine(hash, static_cast<uint8_t>(clearing.get_elder_treetop_index().value_or(clearing_data::ElderTreetopIndex::kNotPresent)));
+
+            const auto buildings = clearing.get_occupied_building_slots();
+            if (buildings.has_value()) {
+                for (building_data::Building building : buildings.value()) {
+                    const uint8_t value = static_cast<uint8_t>(building);
+                    if (building >= kMouseBase && building <= kRabbitBase) {
+                        pieces |= static_cast<SuitedPieces>(1U << ((value - static_cast<uint8_t>(kMouseBase)) * kSuitedPieceBits));
+                        building = kMouseBase;
+                    } else if (building >= kMouseGarden && building <= kRabbitGarden) {
+                        pieces += static_cast<SuitedPieces>(4U << ((value - static_cast<uint8_t>(kMouseGarden)) * kSuitedPieceBits));
+                        building = kMouseGarden;
+                    }
+                    hash = ::game_data::hash_combine(hash, static_cast<uint8_t>(building));
+                }
+            }
+
+            const auto addTradePost = [&pieces, &clearing]<token_data::Token token>(uint8_t tradePostSuit) {
+                pieces |= static_cast<SuitedPieces>((clearing.template get_token_count<token>().value_or(0) != 0) << (tradePostSuit * kSuitedPieceBits + 1));
+            };
+            addTradePost.template operator()<token_data::Token::kMouseTradePost>(0);
+            addTradePost.template operator()<token_data::Token::kFoxTradePost>(1);
+            addTradePost.template operator()<token_data::Token::kRabbitTradePost>(2);
+
+            result.pieces[clearingIndex] = pieces;
+            result.neutralHash = hash;
+        });
+    }
+    return result;
+}
+} // canonical_form
+} // game_data
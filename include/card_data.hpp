@@ -1,5 +1,6 @@
 #pragma once
 
+#include <array>
 #include <cstdint>
 
 namespace game_data
@@ -85,5 +86,74 @@ enum class CardID : uint8_t
     kLoyalVizier,
     kFaithfulRetainer,
 };
+
+static constexpr uint8_t kTotalCardIDs = static_cast<uint8_t>(CardID::kFaithfulRetainer) + 1;
+
+// Suit printed on a card. Mouse, Fox and Rabbit share the suit numbering of clearings
+enum class CardSuit : uint8_t
+{
+    kMouse,
+    kFox,
+    kRabbit,
+    kBird,
+    // The CardID alone does not tell the suit: copies of the name are printed in several suits, or its suit is not
+    // recorded yet. Anything that depends on the suit has to assume the worst
+    kUnpinned
+};
+
+static constexpr std::array<CardSuit, kTotalCardIDs> kCardSuits{[]{
+    using enum CardID;
+    std::array<CardSuit, kTotalCardIDs> result{};
+    result.fill(CardSuit::kUnpinned);
+
+    for (CardID card : {kMouseDominance, kMouseAmbush, kMouseInASack, kMouseTravelGear, kSword, kMouseRootTea,
+                        kInvestments, kMouseCrossbow, kFavorOfTheMice, kMousePartisans, kLeagueOfAdventurousMice})
+        result[static_cast<uint8_t>(card)] = CardSuit::kMouse;
+    for (CardID card : {kFoxDominance, kFoxAmbush, kGentlyUsedKnapsack, kFoxTravelGear, kAnvil, kFoxfolkSteel,
+                        kFoxRootTea, kProtectionRacket, kFavorOfTheFoxes, kFoxPartisans})
+        result[static_cast<uint8_t>(card)] = CardSuit::kFox;
+    for (CardID card : {kRabbitDominance, kRabbitAmbush, kSmugglersTrail, kAVisitToFriends, kRabbitRootTea, kBakeSale,
+                        kFavorOfTheRabbits, kRabbitPartisans})
+        result[static_cast<uint8_t>(card)] = CardSuit::kRabbit;
+    for (CardID card : {kBirdDominance, kBirdAmbush, kBirdyBindle, kWoodlandRunners, kArmsTrader, kBirdCrossbow,
+                        kRoyalClaim, kLoyalVizier, kFaithfulRetainer})
+        result[static_cast<uint8_t>(card)] = CardSuit::kBird;
+    // Everything else, Codebreakers, Armorers, Tax Collector, Master Engravers..., stays kUnpinned
+    return result;
+}()};
+
+// Mouse, Fox and Rabbit, the suits crafting pieces come in. They are the first CardSuit values
+static constexpr uint8_t kCraftSuits = 3;
+
+// Crafting pieces a card takes in each of kCraftSuits, and the points it scores when crafted
+struct CraftRecipe
+{
+    std::array<uint8_t, kCraftSuits> cost;
+    uint8_t points;
+};
+
+/*
+    Only items are listed, their whole effect is the points they score. Everything else is left scoring nothing,
+    which marks it as not craftable: persistent effects and favors need more of the game than cards are modelled with
+*/
+static constexpr std::array<CraftRecipe, kTotalCardIDs> kCraftRecipes{[]{
+    using enum CardID;
+    std::array<CraftRecipe, kTotalCardIDs> result{};
+
+    for (CardID card : {kMouseInASack, kGentlyUsedKnapsack, kSmugglersTrail, kBirdyBindle})
+        result[static_cast<uint8_t>(card)] = {{1, 0, 0}, 1};
+    for (CardID card : {kMouseTravelGear, kFoxTravelGear, kAVisitToFriends, kWoodlandRunners})
+        result[static_cast<uint8_t>(card)] = {{0, 0, 1}, 1};
+    result[static_cast<uint8_t>(kAnvil)] = {{0, 1, 0}, 2};
+    for (CardID card : {kSword, kFoxfolkSteel, kArmsTrader})
+        result[static_cast<uint8_t>(card)] = {{0, 2, 0}, 2};
+    for (CardID card : {kMouseRootTea, kFoxRootTea, kRabbitRootTea})
+        result[static_cast<uint8_t>(card)] = {{1, 0, 0}, 2};
+    for (CardID card : {kInvestments, kProtectionRacket, kBakeSale})
+        result[static_cast<uint8_t>(card)] = {{0, 0, 2}, 3};
+    for (CardID card : {kMouseCrossbow, kBirdCrossbow})
+        result[static_cast<uint8_t>(card)] = {{0, 1, 0}, 1};
+    return result;
+}()};
 } // card_data
 } // game_data
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 #include "card_data.hpp"
 #include "game_data.hpp"
+#include "zobrist.hpp"
 
 #include <array>
 #include <cstdint>
@@ -10,6 +11,7 @@
 #include <bitset>
 #include <optional>
 #include <algorithm>
+#include <span>
 
 namespace game_data {
 namespace pile_data {
@@ -80,10 +82,19 @@ public:
     [[nodiscard]] std::expected<void, PileError> remove_cards_from_pile(const std::vector<uint8_t> &indices);
     [[nodiscard]] inline std::expected<void, PileError> pop_cards_from_pile(uint8_t popCardCount);
 
+    // Both only look at the cards below the current pile size, so stale cards left behind by removals are ignored
+    [[nodiscard]] uint64_t get_hash(uint64_t seed = game_data::kHashSeed) const;
+    [[nodiscard]] bool operator==(const CardPile &other) const;
+
+    // Sum of the keys of the cards below the pile size, kept current by every mutation. See zobrist.hpp
+    [[nodiscard]] inline uint64_t get_zobrist_key() const { return zobristKey; }
+
 protected:
     //Enforce abstractness
     CardPile() = default;
-    
+
+public:
+    // Layout of the packed pile, public so code working on the packed piles of a game state can read them in place
     static constexpr uint8_t kPileSizeBits = 6;
     static constexpr uint16_t kPileContentBits = card_data::kTotalCards * card_data::kCardIDBits;
 
@@ -92,9 +103,29 @@ protected:
 
     using CardPileData = std::array<uint8_t, (kPileSizeBits + card_data::kCardIDBits * card_data::kTotalCards + 7) / 8>;
 
+    // The pile exactly as stored, so flat game states can keep piles without their vtable
+    [[nodiscard]] inline const CardPileData &get_packed_pile() const { return pileData; }
+    inline void set_packed_pile(const CardPileData &newData)
+    {
+        pileData = newData;
+        zobristKey = get_range_key(0, std::min(read_bits<uint8_t, kPileSizeOffset, kPileSizeBits>(), card_data::kTotalCards));
+    }
+    // Skips rebuilding the key when the caller stored it alongside the packed pile
+    inline void set_packed_pile(const CardPileData &newData, uint64_t newZobristKey)
+    {
+        pileData = newData;
+        zobristKey = newZobristKey;
+    }
+    [[nodiscard]] static std::expected<CardPileData, PileError> pack_pile(std::span<const card_data::CardID> cards);
+
+protected:
     CardPileData pileData;
+    uint64_t zobristKey = 0;
+
+    // Keys of the cards in [begin, end), whether or not they are below the pile size
+    [[nodiscard]] uint64_t get_range_key(uint8_t begin, uint8_t end) const;
     
-    inline void on_pile_empty() {}; // CRTP
+    virtual void on_pile_empty() {}
 
     virtual consteval CardPileData initialize_pile() const = 0;
 
@@ -159,5 +190,6 @@ protected:
         return game_data::write_bits<InputType, sizeof(pileData), elementWidth>(pileData, outputSize, value, shift);
     }
 };
+using PackedPile = CardPile::CardPileData;
 } // namespace pile_data
 } // namespace game_data
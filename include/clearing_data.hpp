@@ -2,6 +2,8 @@
 
 #include "token_data.hpp"
 #include "game_data.hpp"
+#include "zobrist.hpp"
+#include "rng_stream.hpp"
 
 #include <cstdint>
 #include <array>
@@ -10,7 +12,8 @@
 #include <algorithm>
 #include <expected>
 #include <bitset>
-#include "Random123/threefry.h"
+#include <bit>
+#include <initializer_list>
 
 namespace game_data 
 {
@@ -157,6 +160,12 @@ struct LandmarkStatusPair
     Landmark landmark;
     bool status;
 };
+
+// kNone has no bit, every other landmark owns bit (landmark - 1) of a clearing's landmark field
+[[nodiscard]] constexpr uint8_t get_landmark_bit(Landmark landmark)
+{
+    return (landmark == Landmark::kNone) ? 0 : static_cast<uint8_t>(1U << (static_cast<uint8_t>(landmark) - 1));
+}
 }
 
 enum class ClearingType : uint8_t
@@ -234,7 +243,54 @@ struct PawnError {
 };
 
 
-template<ClearingType clearingTypeValue, uint8_t initialSlotCount, bool hasRuinInitially>
+struct PawnDataInfo
+{
+    uint8_t offset;
+    uint8_t width;
+    uint8_t maxCount;
+};
+
+// Indexed by FactionID, except that the Lord of the Hundreds warlord takes the slot after its faction and shifts
+// every later faction up by one
+static constexpr std::array<PawnDataInfo, 12> kPawnDataInfoField = {{
+    {0, 5, 25}, // Marquise de Cat Pawns
+    {5, 5, 20}, // Eyrie Dynasties Pawns
+    {10, 4, 10}, // Woodland Alliance Pawns
+    {14, 1, 1}, // Vagabond 1
+    {15, 1, 1}, // Vagabond 2
+    {16, 5, 25}, // Lizard Cult Pawns
+    {21, 4, 15}, // Riverfolk Company Pawns
+    {25, 5, 20}, // Underground Duchy Pawns
+    {30, 4, 15}, // Corvid Conspiracy Pawns
+    {34, 5, 20}, // Lord of The Hundred Pawns
+    {39, 1, 1}, // Lord of the Hundred Warlord
+    {40, 4, 15} // Keepers in Iron Pawns
+}};
+
+[[nodiscard]] consteval uint8_t get_pawn_data_index(faction_data::FactionID factionID)
+{
+    return (factionID > faction_data::FactionID::kLordOfTheHundreds) ? static_cast<uint8_t>(factionID) + 1 : static_cast<uint8_t>(factionID);
+}
+
+static constexpr uint8_t kWarlordPawnDataIndex = get_pawn_data_index(faction_data::FactionID::kLordOfTheHundreds) + 1;
+
+// Builds a mask over the bits of the listed fields of an {offset, width, maxCount} info table.
+// With highBitOnly set, only the top bit of each field is included (e.g. the face up bit of a plot)
+template <typename InfoField, typename Index>
+[[nodiscard]] consteval uint32_t make_field_mask(const InfoField &infoField, std::initializer_list<Index> indices, bool highBitOnly = false)
+{
+    uint32_t mask = 0;
+    for (const Index index : indices) {
+        const auto &info = infoField[static_cast<size_t>(index)];
+        if (highBitOnly)
+            mask |= uint32_t(1) << (info.offset + info.width - 1);
+        else
+            mask |= ((uint32_t(1) << info.width) - 1) << info.offset;
+    }
+    return mask;
+}
+
+template<ClearingType clearingTypeValue, uint8_t initialSlotCount, bool hasRuinInitially, landmark_data::Landmark startingLandmark>
 class Clearing
 {
     /*
@@ -278,40 +334,40 @@ class Clearing
 
     3 Bits: Elder Treetop Index (0-kMaxBuildingSlotIndex, 7 = Not present)
 
-    28 Bits: Tokens {
-        Bits 1-3: Wood (0-8 (9-15 unused))
-        Bit 4: Keep (0-1)
-        Bit 5: Sympathy (0-1)
-        Bit 6: Mouse Trade Post (0-1)
-        Bit 7: Fox Trade Post (0-1)
-        Bit 8: Rabbit Trade Post (0-1)
-        Bit 9: Bomb Plot (0-1)
-        Bit 10-11: Snare Plot (0 = none, 1 = Face Down, 2 = Face Up, 3 = unused)
-        Bits 12-13: Extortion Plot (0 = none, 1 = Face Down, 2 = Face Up, 3 = unused)
-        Bits 14-15: Raid Plot (0 = none, 1 = Face Down, 2 = Face Up, 3 = unused) 
-        Bit 16: Tunnel (0-1) 
-        Bit 17: Mob (0-1) 
-        Bit 18 Figure Value 1 (0-1) 
-        Bit 19 Figure Value 2 (0-1) 
-        Bits 20-21 Figure Value 3 (0-2, 3 = unused) 
-        Bit 22: Tablet Value 1 (0-1) 
-        Bit 23: Tablet Value 2 (0-1) 
-        Bits 24-25: Tablet Value 3 (0-2, 3 = unused) 
-        Bit 26: Jewelry Value 1 (0-1) 
-        Bit 27: Jewelry Value 2 (0-1)
-        Bit 28: Jewelry Value 3 (0-2, 3 = unused)
+    30 Bits: Tokens {
+        Bits 1-4: Wood (0-8 (9-15 unused))
+        Bit 5: Keep (0-1)
+        Bit 6: Sympathy (0-1)
+        Bit 7: Mouse Trade Post (0-1)
+        Bit 8: Fox Trade Post (0-1)
+        Bit 9: Rabbit Trade Post (0-1)
+        Bit 10: Tunnel (0-1)
+        Bit 11: Bomb Plot (0-1)
+        Bits 12-13: Snare Plot (0 = none, 1 = Face Down, 2 = Face Up, 3 = unused)
+        Bits 14-15: Extortion Plot (0 = none, 1 = Face Down, 2 = Face Up, 3 = unused)
+        Bits 16-17: Raid Plot (0 = none, 1 = Face Down, 2 = Face Up, 3 = unused)
+        Bit 18: Mob (0-1)
+        Bit 19: Figure Value 1 (0-1)
+        Bit 20: Figure Value 2 (0-1)
+        Bits 21-22: Figure Value 3 (0-2, 3 = unused)
+        Bit 23: Tablet Value 1 (0-1)
+        Bit 24: Tablet Value 2 (0-1)
+        Bits 25-26: Tablet Value 3 (0-2, 3 = unused)
+        Bit 27: Jewelry Value 1 (0-1)
+        Bit 28: Jewelry Value 2 (0-1)
+        Bits 29-30: Jewelry Value 3 (0-2, 3 = unused)
     }
 
-    44 Bits Pawn Data {
+    44 Bits Pawn Data (in FactionID order, with the warlord right after its faction) {
         Bits 1-5: Marquise de Cat Pawns (0-25, 26-31 uneeded)
         Bits 6-10: Eyrie Dynasties Pawns (0-20, 21-31 uneeded)
-        Bit 11: Vagabond 1 (0-1)
-        Bit 12: Vagabond 2 (0-1)
-        Bits 13-16: Woodland Alliance Pawns (0-10, 11-15 uneeded)
-        Bits 17-20: Riverfolk Company Pawns (0-15)
-        Bits 21-25: Lizard Cult Pawns (0-25, 26-31 uneeded)
-        Bits 26-29: Corvid Conspiracy Pawns (0-15)
-        Bits 30-34: Underground Duchy Pawns (0-20, 21-31 uneeded)
+        Bits 11-14: Woodland Alliance Pawns (0-10, 11-15 uneeded)
+        Bit 15: Vagabond 1 (0-1)
+        Bit 16: Vagabond 2 (0-1)
+        Bits 17-21: Lizard Cult Pawns (0-25, 26-31 uneeded)
+        Bits 22-25: Riverfolk Company Pawns (0-15)
+        Bits 26-30: Underground Duchy Pawns (0-20, 21-31 uneeded)
+        Bits 31-34: Corvid Conspiracy Pawns (0-15)
         Bits 35-39: Lord of the Hundreds Pawns (0-20, 21-31 uneeded)
         Bit 40: Lord of the Hundreds Warlord (0-1)
         Bits 41-44: Keepers in Iron Pawns (0-15)
@@ -340,15 +396,10 @@ class Clearing
     */
 public:
 
-    constexpr Clearing(r123::Threefry2x32_R<12>::ctr_type &ctr, const r123::Threefry2x32_R<12>::key_type &key)
-        : clearingType([&ctr, &key]{
-            if constexpr (clearingTypeValue == ClearingType::kRandom) {
-                r123::Threefry2x32_R<12> rng;
-                const auto rand = rng(ctr, key);
-                return static_cast<ClearingType>(rand[0] % 4);
-            }
-            return clearingTypeValue;
-        }()),
+    // Printed suit only. A kRandom clearing keeps kRandom until its board hands it a suit with apply_suit_setup.
+    // boardIndex is where the board puts the clearing, it picks the clearing's own Zobrist keys
+    constexpr explicit Clearing(uint8_t boardIndex = 0)
+        : clearingType(clearingTypeValue),
         clearingData([this]{
             static_assert(initialSlotCount <= initialSlotCount, "initialSlotCount must not exceed kMaxBuildingSlotCount");
             static_assert(kBuildingSlotCountBits > 0 && kBuildingSlotCountBits <= 8, "Invalid kBuildingSlotCountBits value");
@@ -358,19 +409,38 @@ public:
             using enum Building;
             static_assert(static_cast<std::underlying_type_t<Building>>(kRuin) == 0, "kRuin must be equal to 0");
 
-            static constexpr size_t dataSize = (kLandMarkOffset + kLandmarkBits + 7) / 8;
+            constexpr size_t dataSize = (kLandMarkOffset + kLandmarkBits + 7) / 8;
             std::array<uint8_t, dataSize> temp{};
 
-            game_data::write_bits_compile_time<uint8_t, dataSize, kBuildingSlotCountOffset, kBuildingSlotCountBits>(temp, initialSlotCount);
+            game_data::write_bits<uint8_t, dataSize, kBuildingSlotCountOffset, kBuildingSlotCountBits>(temp, initialSlotCount);
             
             //Set occupied count to 1, which sets a ruin bc/ the 0 = ruin, and temp is value-initialized to 0
             if constexpr (hasRuinInitially)
-                game_data::write_bits_compile_time<uint8_t, dataSize, kOccupiedBuildingSlotCountOffset, kOccupiedBuildingSlotCountBits>(temp, 1);
+                game_data::write_bits<uint8_t, dataSize, kOccupiedBuildingSlotCountOffset, kOccupiedBuildingSlotCountBits>(temp, 1);
+
+            // A zeroed treetop field would read as the treetop sitting in slot 0
+            game_data::write_bits<uint8_t, dataSize, kTreetopIndexOffset, kTreetopIndexBits>(temp, static_cast<uint8_t>(ElderTreetopIndex::kNotPresent));
+
+            // Printed landmarks such as the Lake's ferry start in the clearing
+            if constexpr (startingLandmark != landmark_data::Landmark::kNone)
+                game_data::write_bits<uint8_t, dataSize, kLandMarkOffset, kLandmarkBits>(temp, landmark_data::get_landmark_bit(startingLandmark));
 
             return temp;
-        }())
+        }()),
+        boardIndex(boardIndex),
+        zobristKey(hasRuinInitially ? zobrist::kBuildingKeys[boardIndex][0][static_cast<uint8_t>(building_data::Building::kRuin)] : 0)
     {}
 
+    constexpr explicit Clearing(::game_data::rng::RngStream &stream) : Clearing()
+    {
+        if constexpr (clearingTypeValue == ClearingType::kRandom) {
+            // Drawn over the three suits only, a draw over all four could land on kRandom.
+            // Boards should prefer a balanced setup from suit_setup, this only covers clearings built on their own
+            constexpr uint32_t kTotalSuits = 3;
+            clearingType = static_cast<ClearingType>(static_cast<uint8_t>(ClearingType::kMouse) + stream.draw_below(kTotalSuits));
+        }
+    }
+
     ClearingType clearingType;
 
     [[nodiscard]] inline std::expected<uint8_t, building_data::BuildingError> get_slot_count() const;
@@ -386,10 +456,17 @@ public:
     inline std::expected<void, building_data::BuildingError> set_elder_treetop_index(ElderTreetopIndex newIndex);
 
     [[nodiscard]] std::expected<std::vector<building_data::Building>, building_data::BuildingError> get_occupied_building_slots() const;
+    // Both read the slots in place instead of building the vector above. slot has to be below the occupied slot count
+    [[nodiscard]] inline building_data::Building get_building_in_slot(uint8_t slot) const;
+    [[nodiscard]] inline uint8_t count_buildings(building_data::Building building) const;
     std::expected<void, building_data::BuildingError> set_buildings(const std::vector<building_data::Building> &newBuildings);
     std::expected<void, building_data::BuildingError> set_buildings(const std::vector<building_data::IndexBuildingPair> &newIndexBuildingPairs);
     std::expected<void, building_data::BuildingError> add_buildings(const std::vector<building_data::Building> &newBuildings);
+    // add_buildings for a single building, without the vector
+    std::expected<void, building_data::BuildingError> add_building(building_data::Building newBuilding);
     std::expected<void, building_data::BuildingError> remove_buildings(const std::vector<uint8_t> &indices);
+    // remove_buildings for a single slot, without the vector. Later slots shift down to close the gap
+    std::expected<void, building_data::BuildingError> remove_building(uint8_t slot);
 
     template <token_data::Token token>
     [[nodiscard]] inline std::expected<uint8_t, TokenError> get_token_count() const;
@@ -398,7 +475,25 @@ public:
     template <token_data::Token token>
     inline std::expected<void, TokenError> set_token_count(uint8_t newCount);
 
+    // All token fields plus the hidden plot toggle, loaded as a single word. See the k*Mask constants below
+    using TokenWord = uint32_t;
+    [[nodiscard]] inline TokenWord get_token_word() const;
+    inline void set_token_word(TokenWord newWord);
+
+    [[nodiscard]] static constexpr inline bool contains_plot(TokenWord tokenWord);
+    [[nodiscard]] static constexpr inline bool contains_face_up_plot(TokenWord tokenWord);
+    [[nodiscard]] static constexpr inline bool contains_relic(TokenWord tokenWord);
+    [[nodiscard]] static constexpr inline bool contains_trade_post(TokenWord tokenWord);
+    [[nodiscard]] static constexpr inline uint8_t get_plot_count(TokenWord tokenWord);
+    [[nodiscard]] static constexpr inline uint8_t get_trade_post_count(TokenWord tokenWord);
+    [[nodiscard]] static constexpr inline uint8_t get_relic_count(TokenWord tokenWord);
+    [[nodiscard]] static constexpr inline uint8_t get_relic_value(TokenWord tokenWord);
+
     [[nodiscard]] inline bool contains_plot() const;
+    [[nodiscard]] inline bool contains_face_up_plot() const;
+    [[nodiscard]] inline bool contains_relic() const;
+    [[nodiscard]] inline bool contains_trade_post() const;
+    [[nodiscard]] inline uint8_t get_relic_value() const;
     
     [[nodiscard]] inline bool is_plot_face_down() const;
     inline void set_is_plot_face_down(bool newStatus);
@@ -413,13 +508,25 @@ public:
     template<faction_data::FactionID factionID, bool isWarlordPresent>
     inline std::expected<void, PawnError> set_pawn_count(uint8_t newCount);
 
+    // All pawn counts of this clearing as one word, laid out as described by kPawnDataInfoField
+    using PawnWord = uint64_t;
+    [[nodiscard]] inline PawnWord get_pawn_word() const;
+
     [[nodiscard]] inline bool is_razed() const;
     inline void set_is_razed(bool newStatus);
 
     [[nodiscard]] std::vector<landmark_data::Landmark> get_landmarks() const;
+    [[nodiscard]] inline uint8_t get_landmark_bits() const;
     [[nodiscard]] inline std::expected<bool, landmark_data::LandmarkError> is_landmark_present(landmark_data::Landmark desiredLandmark) const;
     std::expected<void, landmark_data::LandmarkError> set_landmarks(const std::vector<landmark_data::LandmarkStatusPair> &newLandmarkStatusPairs);
     std::expected<void, landmark_data::LandmarkError> set_landmarks(const std::vector<landmark_data::Landmark> &newLandmarks);
+
+    // Both cover the dealt suit and ignore building slots past the occupied count and the padding after the landmarks
+    [[nodiscard]] inline uint64_t get_hash(uint64_t seed = game_data::kHashSeed) const;
+    [[nodiscard]] inline bool operator==(const Clearing &other) const;
+
+    // Kept current by every setter of pawns, tokens, occupied buildings and the razed flag. See zobrist.hpp
+    [[nodiscard]] inline uint64_t get_zobrist_key() const { return zobristKey; }
 private:
 
     static constexpr uint8_t kMaxBuildingSlotCount = 4;
@@ -438,16 +545,16 @@ private:
     };
 
     static constexpr std::array<TokenDataInfo, 21> kTokenDataInfoField = {{
-        {0, 3, 8},  // Wood
-        {3, 1, 1},  // Keep
-        {4, 1, 1},  // Sympathy
-        {5, 1, 1},  // Mouse Trade Post
-        {6, 1, 1},  // Fox Trade Post
-        {7, 1, 1},  // Rabbit Trade Post
-        {8, 1, 1},  // Tunnel
-        {9, 1, 1},  // Bomb Plot
-        {10, 2, 2}, // Snare Plot
-        {12, 2, 2}, // Extortion Plot
+        {0, 4, 8},  // Wood
+        {4, 1, 1},  // Keep
+        {5, 1, 1},  // Sympathy
+        {6, 1, 1},  // Mouse Trade Post
+        {7, 1, 1},  // Fox Trade Post
+        {8, 1, 1},  // Rabbit Trade Post
+        {9, 1, 1},  // Tunnel
+        {10, 1, 1}, // Bomb Plot
+        {11, 2, 2}, // Snare Plot
+        {13, 2, 2}, // Extortion Plot
         {15, 2, 2}, // Raid Plot
         {17, 1, 1}, // Mob
         {18, 1, 1}, // Figure Value 1
@@ -463,28 +570,31 @@ private:
 
     static constexpr uint8_t kHiddenPlotToggleBits = 1;
     static constexpr uint8_t kTokenDataBits = kTokenDataInfoField.back().offset + kTokenDataInfoField.back().width;
-
-    struct PawnDataInfo
-    {
-        uint8_t offset;
-        uint8_t width;
-        uint8_t maxCount;
-    };
-
-    static constexpr std::array<PawnDataInfo, 12> kPawnDataInfoField = {{
-        {0, 5, 25}, // Marquise de Cat Pawns
-        {5, 5, 20}, // Eyrie Dynasties Pawns
-        {10, 1, 1}, // Vagabond 1
-        {11, 1, 1}, // Vagabond 2
-        {12, 4, 10}, // Woodland Alliance Pawns
-        {16, 4, 15}, // Riverfolk Company Pawns
-        {20, 5, 25}, // Lizard Cult Pawns
-        {25, 4, 15}, // Corvid Conspiracy Pawns
-        {29, 5, 20}, // Underground Duchy Pawns
-        {34, 5, 20}, // Lord of The Hundred Pawns
-        {39, 1, 1}, // Lord of the Hundred Warlord
-        {40, 4, 15} // Keepers in Iron Pawns
-    }};
+    // The hidden plot toggle sits directly after the token data, so both fit in one TokenWord
+    static constexpr uint8_t kTokenWordBits = kTokenDataBits + kHiddenPlotToggleBits;
+    static_assert(kTokenWordBits <= 32, "Token data and hidden plot toggle must fit in a TokenWord");
+
+    // Each relic type occupies one nibble: value 1 (1 bit), value 2 (1 bit), value 3 (2 bits)
+    static constexpr uint8_t kRelicNibbleBits = 4;
+    static constexpr uint8_t kRelicNibblesOffset = kTokenDataInfoField[static_cast<uint8_t>(token_data::Token::kFigureValue1)].offset;
+    static_assert(
+        kTokenDataInfoField[static_cast<uint8_t>(token_data::Token::kTabletValue1)].offset == kRelicNibblesOffset + kRelicNibbleBits &&
+        kTokenDataInfoField[static_cast<uint8_t>(token_data::Token::kJewelryValue1)].offset == kRelicNibblesOffset + 2 * kRelicNibbleBits,
+        "Relic token fields must be laid out as consecutive nibbles");
+
+    static constexpr std::array<uint8_t, 16> kRelicNibbleCounts{[]{
+        std::array<uint8_t, 16> result{};
+        for (uint8_t nibble = 0; nibble < 16; ++nibble)
+            result[nibble] = (nibble & 1) + ((nibble >> 1) & 1) + (nibble >> 2);
+        return result;
+    }()};
+
+    static constexpr std::array<uint8_t, 16> kRelicNibbleValues{[]{
+        std::array<uint8_t, 16> result{};
+        for (uint8_t nibble = 0; nibble < 16; ++nibble)
+            result[nibble] = (nibble & 1) + 2 * ((nibble >> 1) & 1) + 3 * (nibble >> 2);
+        return result;
+    }()};
 
     static constexpr uint8_t kPawnDataBits = kPawnDataInfoField.back().offset + kPawnDataInfoField.back().width;
 
@@ -501,7 +611,28 @@ private:
     static constexpr uint16_t kRazedOffset = kPawnDataOffset + kPawnDataBits;
     static constexpr uint16_t kLandMarkOffset = kRazedOffset + kRazedBits;
 
-    std::array<uint8_t, (kLandMarkOffset + kLandmarkBits + 7) / 8> clearingData;
+    static constexpr uint16_t kUsedBits = kLandMarkOffset + kLandmarkBits;
+
+    std::array<uint8_t, (kUsedBits + 7) / 8> clearingData;
+    uint8_t boardIndex;
+    uint64_t zobristKey;
+
+    static_assert(kPawnDataInfoField.size() == zobrist::kPawnFields, "Every pawn field needs its own Zobrist keys");
+    static_assert(kTokenDataInfoField.size() == zobrist::kTokenFields, "Every token field needs its own Zobrist keys");
+    // get_token_word_key looks up whatever a field holds, so every value the width can encode needs a key
+    static_assert([]{
+        for (const PawnDataInfo &info : kPawnDataInfoField)
+            if (info.maxCount >= zobrist::kPawnValues || (1U << info.width) > zobrist::kPawnValues)
+                return false;
+        return true;
+    }(), "Every pawn count needs a Zobrist key");
+    static_assert([]{
+        for (const TokenDataInfo &info : kTokenDataInfoField)
+            if (info.maxCount >= zobrist::kTokenValues || (1U << info.width) > zobrist::kTokenValues || info.maxCount >= (1U << info.width))
+                return false;
+        return true;
+    }(), "Every token count needs a Zobrist key and has to fit its field");
+    static_assert(kMaxBuildingSlotCount == zobrist::kBuildingSlots, "Every building slot needs its own Zobrist keys");
 
     // Wrappers for read and write bits functions to allow for ease of use
     template <game_data::IsUnsignedIntegralOrEnum OutputType, uint16_t shift, uint16_t width>
@@ -568,6 +699,31 @@ private:
     inline std::expected<void, PawnError> set_pawn_count_generic(uint8_t newCount);
 
     [[nodiscard]] inline uint8_t get_occupied_slot_count_unsafe() const;
+
+    [[nodiscard]] inline uint64_t get_token_word_key(TokenWord tokenWord) const;
+    // Only the occupied slots, so it changes both when a slot is rewritten and when the occupied count moves
+    [[nodiscard]] inline uint64_t get_buildings_key() const;
+
+public:
+    // Token group masks over a TokenWord
+    static constexpr TokenWord kAnyPlotMask = make_field_mask(kTokenDataInfoField, {
+        token_data::Token::kBombPlot, token_data::Token::kSnarePlot, token_data::Token::kExtortionPlot, token_data::Token::kRaidPlot});
+    // Bomb plots are a single bit, so their face is only tracked by the hidden plot toggle
+    static constexpr TokenWord kFaceUpPlotMask = make_field_mask(kTokenDataInfoField, {
+        token_data::Token::kSnarePlot, token_data::Token::kExtortionPlot, token_data::Token::kRaidPlot}, true);
+    static constexpr TokenWord kAnyTradePostMask = make_field_mask(kTokenDataInfoField, {
+        token_data::Token::kMouseTradePost, token_data::Token::kFoxTradePost, token_data::Token::kRabbitTradePost});
+    static constexpr TokenWord kAnyRelicMask = make_field_mask(kTokenDataInfoField, {
+        token_data::Token::kFigureValue1, token_data::Token::kFigureValue2, token_data::Token::kFigureValue3,
+        token_data::Token::kTabletValue1, token_data::Token::kTabletValue2, token_data::Token::kTabletValue3,
+        token_data::Token::kJewelryValue1, token_data::Token::kJewelryValue2, token_data::Token::kJewelryValue3});
+    static constexpr TokenWord kBombPlotMask = make_field_mask(kTokenDataInfoField, {token_data::Token::kBombPlot});
+    static constexpr TokenWord kHiddenPlotToggleMask = TokenWord(1) << kTokenDataBits;
+    static constexpr TokenWord kTokenWordMask = (TokenWord(1) << kTokenWordBits) - 1;
+
+private:
+    // Low bit of every two bit plot field, used to count plots regardless of which face is up
+    static constexpr TokenWord kTwoBitPlotLowMask = (kAnyPlotMask & ~kBombPlotMask) & ~kFaceUpPlotMask;
 };
 } // clearing_data
 } // board_data
@@ -3,10 +3,11 @@
 #include "card_pile.hpp"
 #include "card_data.hpp"
 #include "discard_pile_data.hpp"
+#include "rng_stream.hpp"
 
 #include <array>
 #include <cstdint>
-#include "Random123/threefry.h"
+#include <span>
 
 
 
@@ -27,19 +28,26 @@ template <DeckType deckType>
 class Deck : public ::game_data::pile_data::CardPile
 {
 public:
-    Deck(
-        r123::Threefry2x32_R<12>::ctr_type &ctr,
-        const r123::Threefry2x32_R<12>::key_type &key
-    ) : CardPile(), ctr(ctr), key(key) {
+    // The deck keeps its own copy of stream, shuffles draw from it and nothing else
+    explicit Deck(const ::game_data::rng::RngStream &stream) : CardPile(), rng(stream) {
         // Apparently using this-> is good practice here or something
         this->pileData = this->initialize_pile();
+        this->zobristKey = ::game_data::zobrist::get_cards_key(get_starting_cards());
     }
 
-    [[nodiscard]] consteval std::expected<void, pile_data::PileError> shuffle();
+    // Fisher-Yates over the pile with the deck's own stream
+    [[nodiscard]] std::expected<void, pile_data::PileError> shuffle();
+
+    [[nodiscard]] static constexpr std::span<const ::game_data::card_data::CardID, ::game_data::card_data::kTotalCards> get_starting_cards()
+    {
+        if constexpr (deckType == DeckType::kStandard)
+            return kStandardStartingCards;
+        else
+            return kExilesAndPartisansStartingCards;
+    }
 
 protected:
-    r123::Threefry2x32_R<12>::ctr_type &ctr;
-    const r123::Threefry2x32_R<12>::key_type &key;
+    ::game_data::rng::RngStream rng;
 
     template <size_t Bit, size_t Max>
     consteval void set_deck_size_bits(CardPileData& data, uint16_t& bitPos) const;
@@ -52,7 +60,7 @@ protected:
         
     }
 
-    [[nodiscard]] inline consteval std::expected<void, pile_data::PileError> turnover_discard(discard_pile_data::DiscardPile &discardPile);
+    [[nodiscard]] std::expected<void, pile_data::PileError> turnover_discard(discard_pile_data::DiscardPile &discardPile);
 
     [[nodiscard]] consteval CardPileData initialize_pile() const override; 
 
@@ -5,6 +5,7 @@
 #include "discard_pile_data.hpp"
 #include "clearing_data.hpp"
 #include "game_data.hpp"
+#include "zobrist.hpp"
 
 #include <array>
 #include <cstdint>
@@ -88,6 +89,10 @@ concept IsVagabond = requires {
     { T::kFactionID } -> std::convertible_to<FactionID>;
 } && (T::kFactionID == FactionID::kVagabond1 || T::kFactionID == FactionID::kVagabond2);
 
+// Every faction's data block is the same size, so flat game states can hold any faction in the same slot
+static constexpr size_t kFactionDataBytes = 112;
+using PackedFaction = std::array<uint8_t, kFactionDataBytes>;
+
 template <typename FactionType, bool isAI> //CRTP (look up what it stands for its funny)
 class Faction
 {
@@ -97,7 +102,28 @@ public:
 
     virtual ~Faction() = default;
 
-protected:
+    // Both only look at the cards below the current hand size, so stale cards left behind by discards are ignored
+    [[nodiscard]] uint64_t get_hash(uint64_t seed = ::game_data::kHashSeed) const;
+    [[nodiscard]] bool operator==(const Faction &other) const;
+
+    // The faction's data exactly as stored, without the vtable
+    [[nodiscard]] inline const PackedFaction &get_packed_data() const { return factionData; }
+    inline void set_packed_data(const PackedFaction &newData)
+    {
+        factionData = newData;
+        zobristKey = compute_zobrist_key();
+    }
+    // Skips rebuilding the key when the caller stored it alongside the packed data
+    inline void set_packed_data(const PackedFaction &newData, uint64_t newZobristKey)
+    {
+        factionData = newData;
+        zobristKey = newZobristKey;
+    }
+
+    // Score key plus the keys of the cards in hand, kept current by the score and hand setters. See zobrist.hpp
+    [[nodiscard]] inline uint64_t get_zobrist_key() const { return zobristKey; }
+
+    // Layout of the packed data, public so code working on the packed blocks of a game state can read them in place
     static constexpr uint8_t kScoreBits = 5;
     static constexpr uint8_t kMaxHandSize = 18;
     static constexpr uint8_t kHandWriteIndexBits = 5;
@@ -108,7 +134,18 @@ protected:
     static constexpr uint16_t kHandContentOffset = kScoreOffset + kScoreBits;
     static constexpr uint16_t kHandSizeOffset = kHandContentOffset + kHandContentBits;
     static constexpr uint16_t kPawnOffset = kHandSizeOffset + kHandSizeBits;
-    
+
+    // Everything from the hand write index up to the end of the faction specific data
+    static consteval uint16_t get_used_bits()
+    {
+        if constexpr (HasPawns<FactionType>)
+            return kPawnOffset + FactionType::kPawnBits;
+        else
+            return kPawnOffset;
+    }
+    static constexpr uint16_t kHandTailOffset = kHandContentOffset + card_data::kCardIDBits * kMaxHandSize;
+
+protected:
     [[nodiscard]] inline ExpandedScore get_score() const;
     inline void set_score(ExpandedScore newScore);
 
@@ -134,7 +171,12 @@ protected:
     virtual void recruit(uint8_t clearingIndex);
     virtual uint8_t calculate_extra_draws() = 0;
 
-    std::array<uint8_t, 112> factionData;
+    PackedFaction factionData;
+    uint64_t zobristKey = 0;
+
+    // Keys of the hand cards in [begin, end), whether or not they are below the hand size
+    [[nodiscard]] inline uint64_t get_hand_range_key(uint8_t begin, uint8_t end) const;
+    [[nodiscard]] inline uint64_t compute_zobrist_key() const;
 
         // Wrappers for read and write bits functions to allow for ease of use
         template <::game_data::IsUnsignedIntegralOrEnum OutputType, uint16_t shift, uint16_t width>
@@ -184,20 +226,7 @@ class MarquiseDeCatFaction : public Faction<MarquiseDeCatFaction<isAI>, isAI>
     public:
         static constexpr FactionID kFactionID = FactionID::kMarquiseDeCat;
         static constexpr uint8_t kPawnBits = 5;
-
-        bool place_starting_wood();
-        bool craft();
-        bool take_actions();
-        bool battle_action();
-        bool march_action();
-        bool recruit_action();
-        bool build_action();
-        bool overwork_action();
-        bool draw_cards_end_of_turn();
-        bool discard_cards();
-
-    private:
-        uint8_t calculate_extra_draws();
+        // The turn itself is generated by marquise_moves and played by playout, on the packed game state
 };
 
 // stupid hack
@@ -0,0 +1,190 @@
+#pragma once
+
+#include "game_data.hpp"
+#include "clearing_data.hpp"
+#include "token_data.hpp"
+#include "pawn_histogram.hpp"
+#include "board_data.hpp"
+#include "reachability.hpp"
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <concepts>
+#include <expected>
+#include <span>
+#include <string_view>
+#include <type_traits>
+
+namespace game_data
+{
+namespace board_data
+{
+namespace feature_planes
+{
+
+namespace faction_data = ::game_data::faction_data;
+namespace building_data = ::game_data::board_data::clearing_data::building_data;
+namespace token_data = ::game_data::token_data;
+
+using pawn_histogram::kTotalPawnFactions;
+using pawn_histogram::kClearingLanes;
+using pawn_histogram::LaneArray;
+
+/*
+    Planes of kTotalClearings values each. Perspective planes are relative to the faction the position is encoded
+    for, the per faction blocks after kFactionWarriors are in FactionID order
+*/
+enum class ClearingPlane : uint8_t
+{
+    kMouse,
+    kFox,
+    kRabbit,
+    kBuildingSlots,
+    kOpenBuildingSlots,
+    kRuin,
+    kRazed,
+    kElderTreetop,
+    kBlackMarket,
+    kFerry,
+    kLegendaryForge,
+    kLostCity,
+    kTower,
+    kLandDegree,
+    kWaterDegree,
+    kForestDegree,
+    kOwnPresence,
+    kEnemyWarriors,
+    kRuledByPerspective,
+    kRuledByEnemy,
+    kDistanceToEnemyBuilding,
+    kDistanceToEnemyWarriors,
+    kFactionWarriors
+};
+
+static constexpr uint8_t kFactionWarriorsPlane = static_cast<uint8_t>(ClearingPlane::kFactionWarriors);
+static constexpr uint8_t kFactionPresencePlane = kFactionWarriorsPlane + kTotalPawnFactions;
+static constexpr uint8_t kFactionRulePlane = kFactionPresencePlane + kTotalPawnFactions;
+static constexpr uint8_t kTotalClearingPlanes = kFactionRulePlane + kTotalPawnFactions;
+
+// One value per position. The per faction blocks are in FactionID order
+enum class GlobalFeature : uint8_t
+{
+    kRuinsRemaining,
+    kRazedClearings,
+    kBoardType,
+    kPerspective = kBoardType + kTotalBoardTypes,
+    kWarriorsOnBoard = kPerspective + kTotalPawnFactions,
+    kRuledClearings = kWarriorsOnBoard + kTotalPawnFactions,
+    kTotal = kRuledClearings + kTotalPawnFactions
+};
+
+static constexpr uint8_t kTotalGlobalFeatures = static_cast<uint8_t>(GlobalFeature::kTotal);
+
+// Clearing planes first, plane major, then the global features
+static constexpr size_t kClearingFeatureSize = size_t(kTotalClearingPlanes) * kTotalClearings;
+static constexpr size_t kEncodedSize = kClearingFeatureSize + kTotalGlobalFeatures;
+
+[[nodiscard]] inline constexpr size_t get_plane_offset(ClearingPlane plane) { return size_t(static_cast<uint8_t>(plane)) * kTotalClearings; }
+[[nodiscard]] inline constexpr size_t get_global_offset(GlobalFeature feature) { return kClearingFeatureSize + static_cast<uint8_t>(feature); }
+
+// Values are written unscaled, int8_t saturates at its maximum
+template <typename T>
+concept FeatureElement = std::same_as<T, float> || std::same_as<T, int8_t>;
+
+struct EncodeError {
+    enum class Code : uint8_t {
+        kBufferSizeMismatch,
+        kPerspectiveCountMismatch,
+        kUnknownError
+    } code;
+
+    static constexpr std::array<std::string_view, 3> kMessages = {
+        "Output buffer does not hold kEncodedSize values per position",
+        "Every position needs exactly one perspective",
+        "Unknown error"
+    };
+
+    [[nodiscard]] static std::string_view to_string(Code code) {
+        uint8_t idx = static_cast<uint8_t>(code);
+        [[likely]] if (idx < kMessages.size()) return kMessages[idx];
+        return kMessages.back();
+    }
+
+    [[nodiscard]] inline std::string_view message() const { return to_string(code); }
+};
+
+/*
+    Everything the encoder reads from a board, pulled out with one visit per clearing. Trivially copyable so a batch
+    of positions can be gathered first and encoded in one pass. Padding lanes stay zero
+*/
+struct FeatureInputs
+{
+    BoardType boardType;
+    // Mountain paths open during play, so the adjacency is copied rather than looked up by boardType
+    BoardAdjacency adjacency;
+    LaneArray<uint8_t> clearingTypes;
+    LaneArray<uint8_t> buildingSlots;
+    LaneArray<uint8_t> openBuildingSlots;
+    LaneArray<uint8_t> landmarkBits;
+    ClearingMask ruins;
+    ClearingMask razed;
+    uint8_t treetopClearing;
+    pawn_histogram::PawnWords pawnWords;
+    // Clearings holding at least one building of each faction
+    std::array<ClearingMask, kTotalPawnFactions> buildings;
+    // Warriors and buildings, as reachability counts them for rule
+    reachability::PresenceCounts presence;
+};
+static_assert(std::is_trivially_copyable_v<FeatureInputs>, "Feature inputs are gathered into flat batches");
+
+// Writes exactly kEncodedSize values
+template <FeatureElement T>
+[[nodiscard]] std::expected<void, EncodeError> encode(const FeatureInputs &inputs, faction_data::FactionID perspective, std::span<T> output);
+
+// Position i goes to output[i * kEncodedSize], one perspective per position
+template <FeatureElement T>
+[[nodiscard]] std::expected<void, EncodeError> encode_batch(
+    std::span<const FeatureInputs> inputs,
+    std::span<const faction_data::FactionID> perspectives,
+    std::span<T> output
+);
+
+template <BoardType boardType>
+[[nodiscard]] inline FeatureInputs gather_feature_inputs(const Board<boardType> &board)
+{
+    FeatureInputs result{};
+    result.boardType = boardType;
+    result.adjacency = clearingAdjacency[static_cast<size_t>(boardType)];
+    if constexpr (boardType == BoardType::kMountain) {
+        result.adjacency.land = board.get_land_adjacency();
+        result.adjacency.any = board.get_any_adjacency();
+    }
+    result.presence = reachability::get_presence_counts(board);
+    result.ruins = board.get_ruins_mask();
+    result.treetopClearing = board.get_elder_treetop_clearing();
+    result.pawnWords = board.get_pawn_words();
+
+    for (uint8_t clearingIndex = 0; clearingIndex < kTotalClearings; ++clearingIndex) {
+        board.visit_clearing(clearingIndex, [&result, clearingIndex](const auto &clearing) {
+            result.clearingTypes[clearingIndex] = static_cast<uint8_t>(clearing.clearingType);
+            result.buildingSlots[clearingIndex] = clearing.get_slot_count().value_or(0);
+            result.openBuildingSlots[clearingIndex] = clearing.get_remaining_slot_count().value_or(0);
+            result.landmarkBits[clearingIndex] = clearing.get_landmark_bits();
+            result.razed |= static_cast<ClearingMask>(clearing.is_razed() << clearingIndex);
+
+            const auto buildings = clearing.get_occupied_building_slots();
+            if (buildings.has_value()) {
+                for (building_data::Building building : buildings.value()) {
+                    const uint8_t owner = reachability::kBuildingOwners[static_cast<size_t>(building)];
+                    if (owner != reachability::kNoOwner)
+                        result.buildings[owner] |= static_cast<ClearingMask>(1U << clearingIndex);
+                }
+            }
+        });
+    }
+    return result;
+}
+} // feature_planes
+} // board_data
+} // game_data
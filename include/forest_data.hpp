@@ -94,6 +94,9 @@ public:
     template <uint8_t whichVagabond>
     void set_is_vagabond_present(bool value);
 
+    [[nodiscard]] uint64_t get_hash(uint64_t seed = game_data::kHashSeed) const;
+    [[nodiscard]] bool operator==(const Forest &other) const;
+
 private:
 
     struct RelicDataInfo
@@ -124,7 +127,9 @@ private:
     static constexpr uint8_t kRelicsOffset = 0;
     static constexpr uint8_t kVagabondsOffset = kRelicsOffset + kRelicsBits;
 
-    std::array<uint8_t, (kVagabondsOffset + kVagabondBits + 7) / 8> forestData;
+    static constexpr uint16_t kUsedBits = kVagabondsOffset + kVagabondsBits;
+
+    std::array<uint8_t, (kUsedBits + 7) / 8> forestData;
 
     // Wrappers for read and write bits functions to allow for ease of use
     template <game_data::IsUnsignedIntegralOrEnum OutputType, uint16_t shift, uint16_t width>
@@ -1,45 +1,160 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <cstdint>
+#include <expected>
 #include <optional>
-#include <vector>
-#include <exception>
+#include <string_view>
+#include <utility>
 
 #include "game_data.hpp"
 #include "board_data.hpp"
+#include "suit_setup.hpp"
+#include "card_pile.hpp"
+#include "deck_data.hpp"
 #include "factions_data.hpp"
+#include "rng_stream.hpp"
+#include "game_state.hpp"
 
 namespace game_data
 {
-template <uint8_t playerCount, std::array<bool, playerCount> isAIArray>
+
+struct GameError {
+    enum class Code : uint8_t {
+        kTooFewPlayers,
+        kTooManyPlayers,
+        kMissingFactions,
+        kDuplicateFaction,
+        kDeckSetupFailed,
+        kUnknownError
+    } code;
+
+    static constexpr std::array<std::string_view, 6> kMessages = {
+        "A game needs at least kMinPlayers players",
+        "A game cannot have more than kMaxPlayers players",
+        "Faction array cannot be empty when using standard setup",
+        "Every player needs a different faction",
+        "Could not set up the deck",
+        "Unknown error"
+    };
+
+    [[nodiscard]] static std::string_view to_string(Code code) {
+        uint8_t idx = static_cast<uint8_t>(code);
+        [[likely]] if (idx < kMessages.size()) return kMessages[idx];
+        return kMessages.back();
+    }
+
+    [[nodiscard]] inline std::string_view message() const { return to_string(code); }
+};
+
+struct GameSetup
+{
+    deck_data::DeckType deckType;
+    SetupType setupType;
+    uint8_t playerCount;
+    // Seat order. Required for SetupType::Normal, advanced setup chooses factions during play
+    std::optional<std::array<faction_data::FactionID, game_state::kMaxPlayers>> factions;
+    std::array<bool, game_state::kMaxPlayers> isAI;
+    uint64_t seed;
+    // Games sharing a seed, say one self-play batch, get independent streams by id
+    uint32_t gameID = 0;
+};
+
+// Boards can only be built in constant evaluation, every game starts from a copy of these. Dealt suits are filled in
+// per game by apply_suit_setup, so building one never runs the cipher
+template <board_data::BoardType boardType>
+static constexpr board_data::Board<boardType> kStartingBoard{};
+
+template <board_data::BoardType boardType>
 class Game
 {
-    Game(
-        board_data::BoardType boardType,
-        deck_data::DeckType deckType,
-        SetupType setupType,
-        const std::optional<std::array<faction_data::FactionID, playerCount>> &factions
-    )
+public:
+    [[nodiscard]] static std::expected<Game, GameError> create(const GameSetup &setup)
     {
+        using game_state::kMinPlayers;
+        using game_state::kMaxPlayers;
 
-        std::variant<
-            deck_data::Deck<deck_data::DeckType::kStandard>,
-            deck_data::Deck<deck_data::DeckType::kExilesAndPartisans>
-        > deck;
+        [[unlikely]] if (setup.playerCount < kMinPlayers)
+            return std::unexpected(GameError{GameError::Code::kTooFewPlayers});
 
-        if (deckType == deck_data::DeckType::kStandard) {
-            deck = deck_data::Deck<deck_data::DeckType::kStandard>();
-        } else {
-            deck = deck_data::Deck<deck_data::DeckType::kExilesAndPartisans>();
-        }
+        [[unlikely]] if (setup.playerCount > kMaxPlayers)
+            return std::unexpected(GameError{GameError::Code::kTooManyPlayers});
+
+        [[unlikely]] if (setup.setupType == SetupType::Normal && !setup.factions.has_value())
+            return std::unexpected(GameError{GameError::Code::kMissingFactions});
 
-        if (setupType == SetupType::Normal) {
-            [[unlikely]] if (!factions) {
-                throw std::invalid_argument("Faction array cannot be empty when using standard setup.")
+        uint16_t seenFactions = 0;
+        if (setup.factions.has_value()) {
+            for (uint8_t seat = 0; seat < setup.playerCount; ++seat) {
+                const uint16_t factionBit = 1U << static_cast<uint8_t>(setup.factions.value()[seat]);
+                [[unlikely]] if (seenFactions & factionBit)
+                    return std::unexpected(GameError{GameError::Code::kDuplicateFaction});
+                seenFactions |= factionBit;
             }
-        } else { // Advanced Setup
-            
         }
+
+        // Board has no default constructor, the remaining fields are value initialized and filled in below
+        game_state::GameState<boardType> state{
+            .rng = rng::RngStream(setup.seed, setup.gameID, rng::Stream::kPlay),
+            .board = kStartingBoard<boardType>
+        };
+        if constexpr (boardType != board_data::BoardType::kMountain)
+            state.board.apply_suit_setup(board_data::suit_setup::SuitSetupStream(setup.seed, setup.gameID).next());
+
+        const auto deck = [&setup] {
+            rng::RngStream deckStream(setup.seed, setup.gameID, rng::Stream::kDeck);
+            return setup.deckType == deck_data::DeckType::kStandard
+                ? make_shuffled_deck<deck_data::DeckType::kStandard>(deckStream)
+                : make_shuffled_deck<deck_data::DeckType::kExilesAndPartisans>(deckStream);
+        }();
+        const auto discard = pile_data::CardPile::pack_pile({});
+        [[unlikely]] if (!deck.has_value() || !discard.has_value())
+            return std::unexpected(GameError{GameError::Code::kDeckSetupFailed});
+
+        state.deckType = setup.deckType;
+        state.deck = deck.value();
+        state.discard = discard.value();
+        // Pile keys ignore order, so the shuffled deck keys the same as the starting cards
+        state.deckZobristKey = setup.deckType == deck_data::DeckType::kStandard
+            ? zobrist::get_cards_key(deck_data::Deck<deck_data::DeckType::kStandard>::get_starting_cards())
+            : zobrist::get_cards_key(deck_data::Deck<deck_data::DeckType::kExilesAndPartisans>::get_starting_cards());
+        state.discardZobristKey = 0;
+
+        state.playerCount = setup.playerCount;
+        state.seatedFactions = setup.factions.has_value() ? setup.playerCount : 0;
+        for (uint8_t seat = 0; seat < setup.playerCount; ++seat) {
+            state.factions[seat].isAI = setup.isAI[seat];
+            if (setup.factions.has_value())
+                state.factions[seat].factionID = setup.factions.value()[seat];
+        }
+
+        state.currentPlayer = 0;
+        state.turn = 0;
+        state.phase = game_state::Phase::kSetup;
+        state.zobristKey = game_state::compute_zobrist_key(state);
+        return Game(state);
     }
+
+    [[nodiscard]] inline const game_state::GameState<boardType> &get_state() const { return state; }
+    [[nodiscard]] inline game_state::GameState<boardType> &get_state() { return state; }
+
+private:
+    explicit Game(const game_state::GameState<boardType> &state) : state(state) {}
+
+    // Fisher-Yates over the starting cards, drawn from the game's deck stream so a seed always deals the same deck
+    template <deck_data::DeckType deckType>
+    [[nodiscard]] static std::expected<pile_data::PackedPile, pile_data::PileError> make_shuffled_deck(rng::RngStream &stream)
+    {
+        const auto startingCards = deck_data::Deck<deckType>::get_starting_cards();
+        std::array<card_data::CardID, card_data::kTotalCards> cards;
+        std::copy(startingCards.begin(), startingCards.end(), cards.begin());
+
+        for (uint8_t index = card_data::kTotalCards - 1; index > 0; --index)
+            std::swap(cards[index], cards[stream.draw_below(index + 1)]);
+        return pile_data::CardPile::pack_pile(cards);
+    }
+
+    game_state::GameState<boardType> state;
 };
 }
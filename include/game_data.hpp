@@ -8,7 +8,7 @@
 #include <expected>
 #include <bit>
 #include <cstring>
-#include <expected>
+#include <algorithm>
 
 namespace game_data
 {
@@ -25,6 +25,14 @@ enum class BoardType : uint8_t {
     kLake,
     kMountain
 };
+
+// Bit i set = clearing i
+using ClearingMask = uint16_t;
+static_assert(kTotalClearings <= sizeof(ClearingMask) * 8, "Every clearing needs a bit in ClearingMask");
+
+// Bit i set = forest i
+using ForestMask = uint16_t;
+static_assert(kTotalForests <= sizeof(ForestMask) * 8, "Every forest needs a bit in ForestMask");
 }
 
 template <typename T>
@@ -134,9 +142,10 @@ template <IsUnsignedIntegralOrEnum OutputType, size_t N, uint16_t shift, uint16_
         std::is_same_v<UnderlyingTypeOrVoid_t<OutputType>, uint8_t>
     )
     {
-        uint8_t temp = data[byteIndex];
+        // Both bytes side by side, so the high bits of the first survive the shift
+        uint16_t temp = data[byteIndex];
         if constexpr (bitOffset + width > 8)
-            temp |= data[byteIndex + 1] << (8 - bitOffset);
+            temp |= uint16_t(data[byteIndex + 1]) << 8;
         temp >>= bitOffset;
         if constexpr (width < 8) {
             constexpr uint8_t mask = (1U << width) - 1;
@@ -147,11 +156,15 @@ template <IsUnsignedIntegralOrEnum OutputType, size_t N, uint16_t shift, uint16_
     else
     {
         OutputType temp = 0;
-        constexpr uint8_t bytesNeeded = (width + 7) / 8;
+        // A field that starts mid-byte can touch one more byte than its width alone suggests
+        constexpr uint8_t bytesTouched = (bitOffset + width + 7) / 8;
+        constexpr uint8_t bytesNeeded = std::min<uint8_t>(bytesTouched, sizeof(OutputType));
         std::memcpy(&temp, &data[byteIndex], bytesNeeded);
         if constexpr (std::endian::native == std::endian::big)
             temp = std::byteswap(temp);
         temp >>= bitOffset;
+        if constexpr (bytesTouched > sizeof(OutputType))
+            temp |= static_cast<OutputType>(data[byteIndex + sizeof(OutputType)]) << (sizeof(OutputType) * 8 - bitOffset);
         if constexpr (width < sizeof(OutputType) * 8)
         {
             constexpr OutputType mask = (OutputType(1) << width) - 1;
@@ -183,9 +196,10 @@ template <IsUnsignedIntegralOrEnum OutputType, size_t N, uint16_t width>
         std::is_same_v<UnderlyingTypeOrVoid_t<OutputType>, uint8_t>
     )
     {
-        uint8_t temp = data[byteIndex];
+        // Both bytes side by side, so the high bits of the first survive the shift
+        uint16_t temp = data[byteIndex];
         if (bitOffset + width > 8)
-            temp |= data[byteIndex + 1] << (8 - bitOffset);
+            temp |= uint16_t(data[byteIndex + 1]) << 8;
         temp >>= bitOffset;
         if constexpr (width < 8) {
             constexpr uint8_t mask = (1U << width) - 1;
@@ -196,11 +210,15 @@ template <IsUnsignedIntegralOrEnum OutputType, size_t N, uint16_t width>
     else
     {
         OutputType temp = 0;
-        constexpr uint8_t bytesNeeded = (width + 7) / 8;
+        // A field that starts mid-byte can touch one more byte than its width alone suggests
+        const uint8_t bytesTouched = (bitOffset + width + 7) / 8;
+        const uint8_t bytesNeeded = std::min<uint8_t>(bytesTouched, sizeof(OutputType));
         std::memcpy(&temp, &data[byteIndex], bytesNeeded);
         if constexpr (std::endian::native == std::endian::big)
             temp = std::byteswap(temp);
         temp >>= bitOffset;
+        if (bytesTouched > sizeof(OutputType))
+            temp |= static_cast<OutputType>(data[byteIndex + sizeof(OutputType)]) << (sizeof(OutputType) * 8 - bitOffset);
         if constexpr (width < sizeof(OutputType) * 8)
         {
             constexpr OutputType mask = (OutputType(1) << width) - 1;
@@ -373,11 +391,11 @@ consteval void write_bits_compile_time(std::array<uint8_t, N> &data, InputType v
 {
     static_assert(width > 0, "Width cannot be zero");
     static_assert(width <= sizeof(InputType) * 8, "Width exceeds output type bit capacity");
-    static constexpr std::size_t lastByte = (shift + width - 1) / 8;
+    constexpr std::size_t lastByte = (shift + width - 1) / 8;
     static_assert(lastByte < N, "Not enough data to write requested bits");
 
     // Mask the value to fit width
-    static constexpr InputType mask = (width == sizeof(InputType) * 8) 
+    constexpr InputType mask = (width == sizeof(InputType) * 8) 
         ? ~InputType(0)
         : ((InputType(1) << width) - 1);
         
@@ -404,7 +422,7 @@ consteval void write_bits_compile_time(std::array<uint8_t, N> &data, InputType v
 }
 
 template <IsUnsignedIntegralOrEnum InputType, size_t N, uint16_t shift, uint16_t width>
-void write_bits(std::array<uint8_t, N> &data, const InputType &value) 
+constexpr void write_bits(std::array<uint8_t, N> &data, const InputType &value) 
 {
     static_assert(width > 0, "Width cannot be zero");
     static_assert(width <= sizeof(InputType) * 8, "Width exceeds output type bit capacity");
@@ -412,11 +430,10 @@ void write_bits(std::array<uint8_t, N> &data, const InputType &value)
     static_assert(lastByte < sizeof(data), "Not enough data to write requested bits");
 
     if consteval {
-        static constexpr InputType mask = static_cast<InputType>((width == sizeof(InputType) * 8) 
-            ? ~static_cast<std::underlying_type_t<InputType>>(InputType(0))
-            : ((static_cast<std::underlying_type_t<InputType>>(1) << width) - 1));
+        // uint64_t covers plain integers as well as enums, std::underlying_type_t only accepts the latter
+        constexpr uint64_t mask = (width == 64) ? ~uint64_t(0) : ((uint64_t(1) << width) - 1);
             
-        InputType mutableValue = static_cast<InputType>(static_cast<std::underlying_type_t<InputType>>(value) & static_cast<std::underlying_type_t<InputType>>(mask));
+        const uint64_t mutableValue = static_cast<uint64_t>(value) & mask;
 
         std::uint16_t bitsWritten = 0;
         std::uint16_t pos = shift;
@@ -427,7 +444,7 @@ void write_bits(std::array<uint8_t, N> &data, const InputType &value)
             std::uint16_t bitsThisByte = std::min<std::uint16_t>(width - bitsWritten, 8 - currentBit);
 
             uint8_t byteMask = ((1u << bitsThisByte) - 1u) << currentBit;
-            uint8_t bitsToWrite = static_cast<uint8_t>((static_cast<std::underlying_type_t<InputType>>(mutableValue) >> bitsWritten) & ((1u << bitsThisByte) - 1u));
+            uint8_t bitsToWrite = static_cast<uint8_t>((mutableValue >> bitsWritten) & ((1u << bitsThisByte) - 1u));
 
             data[currentByte] = static_cast<uint8_t>(
                 (data[currentByte] & ~byteMask) | ((bitsToWrite << currentBit) & byteMask)
@@ -449,7 +466,7 @@ void write_bits(std::array<uint8_t, N> &data, const InputType &value)
         )
         {
             uint8_t value_uint8 = static_cast<uint8_t>(value);
-            static constexpr uint8_t mask = (width < 8) ? ((1U << width) - 1) : 0xFF;
+            constexpr uint8_t mask = (width < 8) ? ((1U << width) - 1) : 0xFF;
             value_uint8 &= mask;
             data[byteIndex] &= ~(mask << bitOffset);
             data[byteIndex] |= (value_uint8 << bitOffset);
@@ -682,6 +699,89 @@ template <IsValidByteVector InputType, size_t N, uint8_t elementWidth>
     return {};
 }
 
+static constexpr uint64_t kHashSeed = 0x9E3779B97F4A7C15ULL;
+
+// Loads up to eight bytes starting at byteIndex as a little endian word, bytes past the end of the array read as zero
+template <size_t N>
+[[nodiscard]] constexpr uint64_t load_word(const std::array<uint8_t, N> &data, size_t byteIndex)
+{
+    const size_t byteCount = std::min<size_t>(sizeof(uint64_t), N - byteIndex);
+    uint64_t word = 0;
+    if consteval {
+        for (size_t i = 0; i < byteCount; ++i)
+            word |= static_cast<uint64_t>(data[byteIndex + i]) << (i * 8);
+    } else {
+        std::memcpy(&word, &data[byteIndex], byteCount);
+        if constexpr (std::endian::native == std::endian::big)
+            word = std::byteswap(word);
+    }
+    return word;
+}
+
+// Mask selecting the bits of the word loaded at byteIndex that fall inside [beginBit, endBit)
+[[nodiscard]] constexpr uint64_t word_mask_in_range(size_t byteIndex, uint16_t beginBit, uint16_t endBit)
+{
+    const size_t wordBegin = byteIndex * 8;
+    const size_t lowBit = std::max<size_t>(beginBit, wordBegin) - wordBegin;
+    const size_t highBit = std::min<size_t>(endBit, wordBegin + 64) - wordBegin;
+    const uint64_t highMask = (highBit == 64) ? ~uint64_t(0) : ((uint64_t(1) << highBit) - 1);
+    return highMask & (~uint64_t(0) << lowBit);
+}
+
+[[nodiscard]] constexpr uint64_t hash_mix(uint64_t hash)
+{
+    hash ^= hash >> 30;
+    hash *= 0xBF58476D1CE4E5B9ULL;
+    hash ^= hash >> 27;
+    hash *= 0x94D049BB133111EBULL;
+    hash ^= hash >> 31;
+    return hash;
+}
+
+[[nodiscard]] constexpr uint64_t hash_combine(uint64_t seed, uint64_t value)
+{
+    return hash_mix(seed ^ (value + kHashSeed + (seed << 6) + (seed >> 2)));
+}
+
+// Hashes the bits in [beginBit, endBit) eight bytes at a time. Bits outside the range are masked off, so padding and
+// stale bits never make equal states hash differently
+template <size_t N>
+[[nodiscard]] constexpr uint64_t hash_bits(const std::array<uint8_t, N> &data, uint16_t beginBit, uint16_t endBit, uint64_t seed = kHashSeed)
+{
+    uint64_t hash = seed;
+    for (size_t byteIndex = beginBit / 8; byteIndex * 8 < endBit; byteIndex += sizeof(uint64_t))
+        hash = hash_mix(hash ^ (load_word(data, byteIndex) & word_mask_in_range(byteIndex, beginBit, endBit)));
+    return hash_mix(hash ^ (endBit - beginBit));
+}
+
+template <uint16_t beginBit, uint16_t endBit, size_t N>
+[[nodiscard]] constexpr uint64_t hash_bits(const std::array<uint8_t, N> &data, uint64_t seed = kHashSeed)
+{
+    static_assert(beginBit < endBit, "Hashed range cannot be empty");
+    static_assert(endBit <= N * 8, "Not enough data to hash requested bits");
+    return hash_bits(data, beginBit, endBit, seed);
+}
+
+// Compares the bits in [beginBit, endBit) of two packed arrays eight bytes at a time
+template <size_t N>
+[[nodiscard]] constexpr bool equal_bits(const std::array<uint8_t, N> &lhs, const std::array<uint8_t, N> &rhs, uint16_t beginBit, uint16_t endBit)
+{
+    for (size_t byteIndex = beginBit / 8; byteIndex * 8 < endBit; byteIndex += sizeof(uint64_t)) {
+        const uint64_t mask = word_mask_in_range(byteIndex, beginBit, endBit);
+        [[unlikely]] if (((load_word(lhs, byteIndex) ^ load_word(rhs, byteIndex)) & mask) != 0)
+            return false;
+    }
+    return true;
+}
+
+template <uint16_t beginBit, uint16_t endBit, size_t N>
+[[nodiscard]] constexpr bool equal_bits(const std::array<uint8_t, N> &lhs, const std::array<uint8_t, N> &rhs)
+{
+    static_assert(beginBit < endBit, "Compared range cannot be empty");
+    static_assert(endBit <= N * 8, "Not enough data to compare requested bits");
+    return equal_bits(lhs, rhs, beginBit, endBit);
+}
+
 enum class SetupType : uint8_t {
     Normal,
     Advanced
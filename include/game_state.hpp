@@ -0,0 +1,160 @@
+#pragma once
+
+#include "game_data.hpp"
+#include "board_data.hpp"
+#include "card_pile.hpp"
+#include "deck_data.hpp"
+#include "factions_data.hpp"
+#include "rng_stream.hpp"
+#include "zobrist.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <type_traits>
+
+namespace game_data
+{
+namespace game_state
+{
+
+namespace board_data = ::game_data::board_data;
+namespace card_data = ::game_data::card_data;
+namespace faction_data = ::game_data::faction_data;
+namespace pile_data = ::game_data::pile_data;
+namespace deck_data = ::game_data::deck_data;
+
+static constexpr size_t kCacheLineBytes = 64;
+static constexpr uint8_t kMinPlayers = 2;
+static constexpr uint8_t kMaxPlayers = 6;
+
+enum class Phase : uint8_t
+{
+    kSetup,
+    kBirdsong,
+    kDaylight,
+    kEvening,
+    kGameOver
+};
+
+// Where the current player is inside the phase. Each faction's move generator gives step and flags their meaning
+struct TurnState
+{
+    uint8_t step;
+    uint8_t actionsLeft;
+    uint16_t flags;
+};
+
+struct FactionBlock
+{
+    faction_data::FactionID factionID;
+    bool isAI;
+    faction_data::PackedFaction data;
+    uint64_t zobristKey;
+};
+
+/*
+    Everything a position needs, in one contiguous block with no references, heap storage or vtables, so cloning a
+    state for search is a single memcpy. The piles and factions are kept as their packed data; the classes that own
+    that data can be loaded from and stored back into these blocks, together with their Zobrist keys
+*/
+template <board_data::BoardType boardType>
+struct alignas(kCacheLineBytes) GameState
+{
+    // Held by value, so a cloned state keeps drawing the same numbers as the original would have
+    ::game_data::rng::RngStream rng;
+    board_data::Board<boardType> board;
+
+    deck_data::DeckType deckType;
+    pile_data::PackedPile deck;
+    pile_data::PackedPile discard;
+    uint64_t deckZobristKey;
+    uint64_t discardZobristKey;
+
+    std::array<FactionBlock, kMaxPlayers> factions;
+    uint8_t playerCount;
+    // Seats below this have their faction chosen, advanced setup fills them in during kSetup
+    uint8_t seatedFactions;
+    uint8_t currentPlayer;
+    uint16_t turn;
+    Phase phase;
+    TurnState turnState;
+    // The whole position's key, see get_zobrist_key
+    uint64_t zobristKey;
+};
+
+static_assert(std::is_trivially_copyable_v<FactionBlock>, "Game states are cloned with memcpy");
+static_assert(std::is_trivially_copyable_v<TurnState>, "Game states are cloned with memcpy");
+static_assert(std::is_trivially_copyable_v<GameState<board_data::BoardType::kAutumn>>, "Game states are cloned with memcpy");
+static_assert(std::is_trivially_copyable_v<GameState<board_data::BoardType::kWinter>>, "Game states are cloned with memcpy");
+static_assert(std::is_trivially_copyable_v<GameState<board_data::BoardType::kLake>>, "Game states are cloned with memcpy");
+static_assert(std::is_trivially_copyable_v<GameState<board_data::BoardType::kMountain>>, "Game states are cloned with memcpy");
+
+namespace detail
+{
+
+// Score and hand sit at the same offsets for every faction, so any faction's layout reads them
+using HandLayout = faction_data::Faction<faction_data::MarquiseDeCatFaction<false>, false>;
+
+// Sum of the held keys of count packed cards starting at offset
+template <size_t bytes>
+[[nodiscard]] inline uint64_t get_held_cards_key(const std::array<uint8_t, bytes> &data, uint16_t offset, uint8_t count, zobrist::CardHolder holder)
+{
+    uint64_t key = 0;
+    for (uint8_t index = 0; index < count; ++index)
+        key += zobrist::get_held_card_key(holder, ::game_data::read_bits<card_data::CardID, bytes, card_data::kCardIDBits>(
+            data, static_cast<uint16_t>(offset + index * card_data::kCardIDBits)).value_or(card_data::CardID{}));
+    return key;
+}
+} // detail
+
+// Whose turn it is and how far into it they are. Steps change with nearly every action, so they are keyed together
+template <board_data::BoardType boardType>
+[[nodiscard]] inline uint64_t get_turn_key(const GameState<boardType> &state)
+{
+    return zobrist::kCurrentPlayerKeys[state.currentPlayer] + zobrist::kPhaseKeys[static_cast<uint8_t>(state.phase)] +
+        zobrist::get_turn_state_key(state.turnState.step | (uint32_t(state.turnState.actionsLeft) << 8) | (uint32_t(state.turnState.flags) << 16));
+}
+
+/*
+    Builds the key of the whole position from scratch: the clearing keys, every card keyed by who holds it, the seat
+    scores, the seated factions and the turn. Only for states put together outside the playout edits, which keep
+    zobristKey current themselves. The turn counter is left out on purpose, the same position reached on different
+    turns plays out the same
+*/
+template <board_data::BoardType boardType>
+[[nodiscard]] inline uint64_t compute_zobrist_key(const GameState<boardType> &state)
+{
+    using Pile = pile_data::CardPile;
+    using detail::HandLayout;
+
+    uint64_t key = state.board.get_zobrist_key();
+    const auto getPileSize = [](const pile_data::PackedPile &pile) {
+        return std::min(::game_data::read_bits<uint8_t, sizeof(pile_data::PackedPile), Pile::kPileSizeOffset, Pile::kPileSizeBits>(pile), card_data::kTotalCards);
+    };
+    key += detail::get_held_cards_key(state.deck, Pile::kPileContentOffset, getPileSize(state.deck), zobrist::CardHolder::kDeck);
+    key += detail::get_held_cards_key(state.discard, Pile::kPileContentOffset, getPileSize(state.discard), zobrist::CardHolder::kDiscard);
+
+    for (uint8_t seat = 0; seat < state.playerCount; ++seat) {
+        const faction_data::PackedFaction &data = state.factions[seat].data;
+        const uint8_t score = ::game_data::read_bits<uint8_t, faction_data::kFactionDataBytes, HandLayout::kScoreOffset, HandLayout::kScoreBits>(data);
+        const uint8_t handSize = std::min(
+            ::game_data::read_bits<uint8_t, faction_data::kFactionDataBytes, HandLayout::kHandSizeOffset, HandLayout::kHandSizeBits>(data),
+            HandLayout::kMaxHandSize);
+        key += zobrist::kSeatScoreKeys[seat][score];
+        key += detail::get_held_cards_key(data, HandLayout::kHandContentOffset, handSize, zobrist::get_seat_holder(seat));
+    }
+    for (uint8_t seat = 0; seat < state.seatedFactions; ++seat)
+        key += zobrist::kSeatedFactionKeys[seat][static_cast<uint8_t>(state.factions[seat].factionID)];
+    return key + get_turn_key(state);
+}
+
+// Every edit during play keeps the key current, so a probe is a single load
+template <board_data::BoardType boardType>
+[[nodiscard]] inline uint64_t get_zobrist_key(const GameState<boardType> &state)
+{
+    return state.zobristKey;
+}
+} // game_state
+} // game_data
@@ -0,0 +1,433 @@
+#pragma once
+
+#include "game_data.hpp"
+#include "action.hpp"
+#include "board_data.hpp"
+#include "card_data.hpp"
+#include "clearing_data.hpp"
+#include "token_data.hpp"
+#include "pawn_histogram.hpp"
+#include "reachability.hpp"
+#include "factions_data.hpp"
+#include "game_state.hpp"
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <expected>
+
+namespace game_data
+{
+namespace marquise_moves
+{
+
+namespace board_data = ::game_data::board_data;
+namespace clearing_data = ::game_data::board_data::clearing_data;
+namespace building_data = ::game_data::board_data::clearing_data::building_data;
+namespace token_data = ::game_data::token_data;
+namespace reachability = ::game_data::board_data::reachability;
+namespace faction_data = ::game_data::faction_data;
+namespace game_state = ::game_data::game_state;
+namespace action = ::game_data::action;
+
+using board_data::ClearingMask;
+using board_data::AdjacencyMasks;
+using board_data::pawn_histogram::LaneArray;
+using faction_data::FactionID;
+
+static constexpr FactionID kFactionID = FactionID::kMarquiseDeCat;
+static constexpr uint8_t kTotalWarriors = clearing_data::kPawnDataInfoField[clearing_data::get_pawn_data_index(kFactionID)].maxCount;
+static constexpr uint8_t kTotalWood = 8;
+static constexpr uint8_t kBuildingsPerType = 6;
+static constexpr uint8_t kDaylightActions = 3;
+static constexpr uint8_t kHandLimit = 5;
+
+// Wood the next building of a type costs, by how many of that type are on the board already
+static constexpr std::array<uint8_t, kBuildingsPerType> kBuildCosts = {0, 1, 2, 3, 3, 4};
+static constexpr uint8_t kMaxBuildCost = 4;
+
+// Victory points for building, by kMarquiseBuildings entry and how many of that type are on the board already
+static constexpr std::array<std::array<uint8_t, kBuildingsPerType>, 3> kBuildPoints = {{
+    {0, 1, 2, 3, 4, 5}, // Sawmill
+    {0, 2, 2, 3, 4, 5}, // Workshop
+    {0, 1, 2, 3, 3, 4}  // Recruiter
+}};
+
+static constexpr std::array<building_data::Building, 3> kMarquiseBuildings = {
+    building_data::Building::kSawmill,
+    building_data::Building::kWorkshop,
+    building_data::Building::kRecruiter
+};
+
+// TurnState::step during Daylight. A march spends its action on the first move, the second move may be passed
+enum class MarquiseStep : uint8_t
+{
+    kChooseAction,
+    kSecondMove
+};
+
+// TurnState::flags, the recruit taken this turn and then the crafting pieces used so far in each of kCraftSuits
+static constexpr uint16_t kRecruitedFlag = 1;
+static constexpr uint8_t kCraftedShift = 1;
+static constexpr uint8_t kCraftedBits = 3;
+static_assert(kCraftedShift + kCraftedBits * card_data::kCraftSuits <= 16, "Crafted counts must fit in TurnState::flags");
+static_assert(kBuildingsPerType < (1U << kCraftedBits), "Every workshop on the board must be countable as used");
+
+[[nodiscard]] constexpr uint8_t get_crafted(uint16_t flags, uint8_t suit)
+{
+    return static_cast<uint8_t>((flags >> (kCraftedShift + suit * kCraftedBits)) & ((1U << kCraftedBits) - 1));
+}
+
+// affordable[cost] holds every site with at least cost wood reachable through ruled clearings
+using AffordableSites = std::array<ClearingMask, kMaxBuildCost + 1>;
+
+/*
+    Wood can be spent on a build if it sits anywhere in the group of connected ruled clearings around the site. Each
+    group is one flood fill over the masks, so every site's supply comes from a handful of ANDs instead of a search
+    per site and cost
+*/
+[[nodiscard]] AffordableSites get_affordable_sites(ClearingMask sites, ClearingMask ruled, const LaneArray<uint8_t> &wood, const AdjacencyMasks &adjacency);
+
+// Wood to remove per clearing to pay cost for a build at site, nearest first and lowest index among equals. Which
+// wood pays is not part of a build action, so this settles it the same way every time
+[[nodiscard]] LaneArray<uint8_t> plan_wood_payment(
+    uint8_t site,
+    uint8_t cost,
+    ClearingMask ruled,
+    const LaneArray<uint8_t> &wood,
+    const AdjacencyMasks &adjacency
+);
+
+// The parts of the board the Marquise's moves depend on, read once per generation
+struct MarquiseBoard
+{
+    // Warriors and buildings, what rule is counted from
+    reachability::PresenceCounts presence;
+    // Tokens, which never rule but can still be battled
+    reachability::PresenceCounts tokens;
+    LaneArray<uint8_t> warriors;
+    LaneArray<uint8_t> wood;
+    ClearingMask ruled;
+    ClearingMask openSlots;
+    ClearingMask sawmills;
+    ClearingMask keep;
+    // Clearings of each of card_data::kCraftSuits, and the workshops standing in them
+    std::array<ClearingMask, card_data::kCraftSuits> suitClearings;
+    std::array<uint8_t, card_data::kCraftSuits> workshops;
+    std::array<uint8_t, kMarquiseBuildings.size()> builtCounts;
+    uint8_t recruiterCount;
+    uint8_t warriorSupply;
+    uint8_t woodSupply;
+};
+
+// Mountain boards only track their paths, there are no clearings to read pieces from
+template <board_data::BoardType boardType>
+    requires (boardType != board_data::BoardType::kMountain)
+[[nodiscard]] inline MarquiseBoard scan_board(const board_data::Board<boardType> &board)
+{
+    MarquiseBoard result{};
+    result.presence = reachability::get_presence_counts(board);
+    result.tokens = reachability::get_token_counts(board);
+    result.ruled = reachability::compute_rule_masks(result.presence)[static_cast<uint8_t>(kFactionID)];
+    result.warriors = board.get_pawn_histogram().get_counts(kFactionID);
+
+    uint8_t warriorsOnBoard = 0;
+    uint8_t woodOnBoard = 0;
+    for (uint8_t clearingIndex = 0; clearingIndex < board_data::kTotalClearings; ++clearingIndex) {
+        warriorsOnBoard += result.warriors[clearingIndex];
+        board.visit_clearing(clearingIndex, [&result, &woodOnBoard, clearingIndex](const auto &clearing) {
+            const ClearingMask bit = static_cast<ClearingMask>(1U << clearingIndex);
+            result.wood[clearingIndex] = clearing.template get_token_count<token_data::Token::kWood>().value_or(0);
+            woodOnBoard += result.wood[clearingIndex];
+            if (clearing.get_remaining_slot_count().value_or(0) > 0)
+                result.openSlots |= bit;
+
+            for (uint8_t building = 0; building < kMarquiseBuildings.size(); ++building)
+                result.builtCounts[building] += clearing.count_buildings(kMarquiseBuildings[building]);
+            if (clearing.count_buildings(building_data::Building::kSawmill) > 0)
+                result.sawmills |= bit;
+            if (clearing.template get_token_count<token_data::Token::kKeep>().value_or(0) > 0)
+                result.keep |= bit;
+            const uint8_t suit = static_cast<uint8_t>(clearing.clearingType) - static_cast<uint8_t>(clearing_data::ClearingType::kMouse);
+            if (suit < card_data::kCraftSuits) {
+                result.suitClearings[suit] |= bit;
+                result.workshops[suit] += clearing.count_buildings(building_data::Building::kWorkshop);
+            }
+            result.recruiterCount += clearing.count_buildings(building_data::Building::kRecruiter);
+        });
+    }
+
+    result.warriorSupply = warriorsOnBoard < kTotalWarriors ? kTotalWarriors - warriorsOnBoard : 0;
+    result.woodSupply = woodOnBoard < kTotalWood ? kTotalWood - woodOnBoard : 0;
+    return result;
+}
+
+namespace detail
+{
+
+// One action per legal move out of every clearing the Marquise hold warriors in, every count from one up
+[[nodiscard]] inline std::expected<void, action::ActionError> generate_moves(
+    const MarquiseBoard &marquise,
+    const AdjacencyMasks &adjacency,
+    action::Verb verb,
+    action::ActionList &actions)
+{
+    const LaneArray<uint8_t> &warriors = marquise.warriors;
+    for (uint8_t origin = 0; origin < board_data::kTotalClearings; ++origin) {
+        if (warriors[origin] == 0)
+            continue;
+
+        // Moves need rule at one end
+        const ClearingMask destinations = ((marquise.ruled >> origin) & 1) ? adjacency[origin] : adjacency[origin] & marquise.ruled;
+        for (ClearingMask remaining = destinations; remaining != 0; remaining &= remaining - 1) {
+            const uint8_t destination = static_cast<uint8_t>(std::countr_zero(remaining));
+            for (uint8_t count = 1; count <= warriors[origin]; ++count) {
+                [[unlikely]] if (!actions.push_back(action::Action::make(kFactionID, verb, origin, destination, count)).has_value())
+                    return std::unexpected(action::ActionError{action::ActionError::Code::kListFull});
+            }
+        }
+    }
+    return {};
+}
+
+[[nodiscard]] inline std::expected<void, action::ActionError> generate_battles(const MarquiseBoard &marquise, action::ActionList &actions)
+{
+    const LaneArray<uint8_t> &warriors = marquise.warriors;
+    for (uint8_t clearing = 0; clearing < board_data::kTotalClearings; ++clearing) {
+        if (warriors[clearing] == 0)
+            continue;
+
+        for (uint8_t defender = 0; defender < reachability::kTotalPawnFactions; ++defender) {
+            if (defender == static_cast<uint8_t>(kFactionID) ||
+                (marquise.presence[defender][clearing] == 0 && marquise.tokens[defender][clearing] == 0))
+                continue;
+            [[unlikely]] if (!actions.push_back(action::Action::make_battle(kFactionID, clearing, static_cast<FactionID>(defender))).has_value())
+                return std::unexpected(action::ActionError{action::ActionError::Code::kListFull});
+        }
+    }
+    return {};
+}
+
+// Every building type still off the board, at every open ruled site its cost of wood can reach
+[[nodiscard]] inline std::expected<void, action::ActionError> generate_builds(
+    const MarquiseBoard &marquise,
+    const AdjacencyMasks &adjacency,
+    action::ActionList &actions)
+{
+    const ClearingMask sites = marquise.ruled & marquise.openSlots;
+    if (sites == 0)
+        return {};
+
+    const AffordableSites affordable = get_affordable_sites(sites, marquise.ruled, marquise.wood, adjacency);
+    for (uint8_t building = 0; building < kMarquiseBuildings.size(); ++building) {
+        const uint8_t built = marquise.builtCounts[building];
+        if (built >= kBuildingsPerType)
+            continue;
+
+        for (ClearingMask remaining = affordable[kBuildCosts[built]]; remaining != 0; remaining &= remaining - 1) {
+            const uint8_t site = static_cast<uint8_t>(std::countr_zero(remaining));
+            const action::Action build = action::Action::make(
+                kFactionID, action::Verb::kBuild, site, action::Action::kNoClearing, 0, action::Action::kNoCard, kMarquiseBuildings[building]);
+            [[unlikely]] if (!actions.push_back(build).has_value())
+                return std::unexpected(action::ActionError{action::ActionError::Code::kListFull});
+        }
+    }
+    return {};
+}
+
+// Every distinct card in hand as a bit per CardID, copies of a card are the same choice
+[[nodiscard]] inline uint64_t get_hand_cards(const faction_data::PackedFaction &data)
+{
+    using Layout = faction_data::Faction<faction_data::MarquiseDeCatFaction<false>, false>;
+    static_assert(card_data::kTotalCardIDs <= 64, "Hand cards must fit in a mask");
+
+    const uint8_t handSize = std::min(
+        ::game_data::read_bits<uint8_t, faction_data::kFactionDataBytes, Layout::kHandSizeOffset, Layout::kHandSizeBits>(data),
+        Layout::kMaxHandSize);
+    uint64_t cards = 0;
+    for (uint8_t index = 0; index < handSize; ++index) {
+        const uint8_t card = ::game_data::read_bits<uint8_t, faction_data::kFactionDataBytes, card_data::kCardIDBits>(
+            data, static_cast<uint16_t>(Layout::kHandContentOffset + index * card_data::kCardIDBits)).value_or(action::Action::kNoCard);
+        if (card < card_data::kTotalCardIDs)
+            cards |= uint64_t(1) << card;
+    }
+    return cards;
+}
+
+// One action of verb per card in cards
+[[nodiscard]] inline std::expected<void, action::ActionError> generate_card_actions(uint64_t cards, action::Verb verb, action::ActionList &actions)
+{
+    for (uint64_t remaining = cards; remaining != 0; remaining &= remaining - 1) {
+        const card_data::CardID card = static_cast<card_data::CardID>(std::countr_zero(remaining));
+        [[unlikely]] if (!actions.push_back(action::Action::make_with_card(kFactionID, verb, card)).has_value())
+            return std::unexpected(action::ActionError{action::ActionError::Code::kListFull});
+    }
+    return {};
+}
+
+[[nodiscard]] inline uint64_t get_bird_cards(uint64_t cards)
+{
+    uint64_t birds = 0;
+    for (uint64_t remaining = cards; remaining != 0; remaining &= remaining - 1) {
+        const uint8_t card = static_cast<uint8_t>(std::countr_zero(remaining));
+        if (card_data::kCardSuits[card] == card_data::CardSuit::kBird)
+            birds |= uint64_t(1) << card;
+    }
+    return birds;
+}
+
+// Every item in hand the workshops not yet used this turn can pay for, each suit from workshops in its own clearings
+[[nodiscard]] inline std::expected<void, action::ActionError> generate_crafts(
+    const MarquiseBoard &marquise,
+    uint16_t flags,
+    uint64_t cards,
+    action::ActionList &actions)
+{
+    for (uint64_t remaining = cards; remaining != 0; remaining &= remaining - 1) {
+        const uint8_t card = static_cast<uint8_t>(std::countr_zero(remaining));
+        const card_data::CraftRecipe &recipe = card_data::kCraftRecipes[card];
+        if (recipe.points == 0)
+            continue;
+
+        bool affordable = true;
+        for (uint8_t suit = 0; suit < card_data::kCraftSuits; ++suit)
+            affordable &= get_crafted(flags, suit) + recipe.cost[suit] <= marquise.workshops[suit];
+        if (!affordable)
+            continue;
+
+        [[unlikely]] if (!actions.push_back(action::Action::make_with_card(kFactionID, action::Verb::kCraft, static_cast<card_data::CardID>(card))).has_value())
+            return std::unexpected(action::ActionError{action::ActionError::Code::kListFull});
+    }
+    return {};
+}
+
+// A card and one of the sawmills in a clearing of its suit to put a wood on, birds go with any sawmill
+[[nodiscard]] inline std::expected<void, action::ActionError> generate_overworks(const MarquiseBoard &marquise, uint64_t cards, action::ActionList &actions)
+{
+    if (marquise.woodSupply == 0 || marquise.sawmills == 0)
+        return {};
+
+    for (uint64_t remaining = cards; remaining != 0; remaining &= remaining - 1) {
+        const uint8_t card = static_cast<uint8_t>(std::countr_zero(remaining));
+        const uint8_t suit = static_cast<uint8_t>(card_data::kCardSuits[card]);
+        ClearingMask sites = 0;
+        if (suit < card_data::kCraftSuits)
+            sites = marquise.sawmills & marquise.suitClearings[suit];
+        else if (card_data::kCardSuits[card] == card_data::CardSuit::kBird)
+            sites = marquise.sawmills;
+
+        for (; sites != 0; sites &= sites - 1) {
+            const action::Action overwork = action::Action::make(
+                kFactionID, action::Verb::kOverwork, static_cast<uint8_t>(std::countr_zero(sites)), action::Action::kNoClearing, 0, card);
+            [[unlikely]] if (!actions.push_back(overwork).has_value())
+                return std::unexpected(action::ActionError{action::ActionError::Code::kListFull});
+        }
+    }
+    return {};
+}
+
+[[nodiscard]] inline uint8_t get_hand_size(const faction_data::PackedFaction &data)
+{
+    using Layout = faction_data::Faction<faction_data::MarquiseDeCatFaction<false>, false>;
+    return ::game_data::read_bits<uint8_t, faction_data::kFactionDataBytes, Layout::kHandSizeOffset, Layout::kHandSizeBits>(data);
+}
+} // detail
+
+/*
+    Fills actions with every legal move of the Marquise seated at state.currentPlayer, in a fixed order: birdsong
+    wood, then crafts before the first daylight action, battles, marches, recruits, builds and overworks by clearing,
+    then passing. Nothing is allocated; the list is the only output.
+
+    A bird card for an extra action is only offered once the three are spent, earlier it plays out the same. Setup
+    offers the keep in every clearing with an open slot, the map's corners are not modelled
+*/
+template <board_data::BoardType boardType>
+    requires (boardType != board_data::BoardType::kMountain)
+[[nodiscard]] inline std::expected<void, action::ActionError> generate_actions(const game_state::GameState<boardType> &state, action::ActionList &actions)
+{
+    using action::Action;
+    using action::Verb;
+
+    actions.clear();
+    const AdjacencyMasks &adjacency = board_data::clearingAdjacency[static_cast<size_t>(boardType)].land;
+    const game_state::TurnState &turnState = state.turnState;
+
+    switch (state.phase) {
+    case game_state::Phase::kBirdsong: {
+        const MarquiseBoard marquise = scan_board(state.board);
+        // Supply running short is settled in clearing order by whoever applies the action
+        if (marquise.sawmills != 0 && marquise.woodSupply > 0)
+            return actions.push_back(Action::make(kFactionID, Verb::kPlaceWood));
+        return actions.push_back(Action::make(kFactionID, Verb::kPass));
+    }
+    case game_state::Phase::kDaylight: {
+        const MarquiseBoard marquise = scan_board(state.board);
+        if (static_cast<MarquiseStep>(turnState.step) == MarquiseStep::kSecondMove) {
+            const auto moves = detail::generate_moves(marquise, adjacency, Verb::kMove, actions);
+            [[unlikely]] if (!moves.has_value())
+                return moves;
+            return actions.push_back(Action::make(kFactionID, Verb::kPass));
+        }
+
+        const uint64_t cards = detail::get_hand_cards(state.factions[state.currentPlayer].data);
+        // Crafting opens daylight, before any action is taken
+        if (turnState.actionsLeft == kDaylightActions) {
+            const auto crafts = detail::generate_crafts(marquise, turnState.flags, cards, actions);
+            [[unlikely]] if (!crafts.has_value())
+                return crafts;
+        }
+
+        if (turnState.actionsLeft > 0) {
+            const auto battles = detail::generate_battles(marquise, actions);
+            [[unlikely]] if (!battles.has_value())
+                return battles;
+
+            const auto marches = detail::generate_moves(marquise, adjacency, Verb::kMarch, actions);
+            [[unlikely]] if (!marches.has_value())
+                return marches;
+
+            if (!(turnState.flags & kRecruitedFlag) && marquise.recruiterCount > 0 && marquise.warriorSupply > 0) {
+                const auto recruit = actions.push_back(Action::make(kFactionID, Verb::kRecruit));
+                [[unlikely]] if (!recruit.has_value())
+                    return recruit;
+            }
+
+            const auto builds = detail::generate_builds(marquise, adjacency, actions);
+            [[unlikely]] if (!builds.has_value())
+                return builds;
+
+            const auto overworks = detail::generate_overworks(marquise, cards, actions);
+            [[unlikely]] if (!overworks.has_value())
+                return overworks;
+        } else {
+            const auto extraActions = detail::generate_card_actions(detail::get_bird_cards(cards), Verb::kDiscard, actions);
+            [[unlikely]] if (!extraActions.has_value())
+                return extraActions;
+        }
+        return actions.push_back(Action::make(kFactionID, Verb::kPass));
+    }
+    case game_state::Phase::kEvening: {
+        const faction_data::PackedFaction &data = state.factions[state.currentPlayer].data;
+        if (detail::get_hand_size(data) > kHandLimit)
+            return detail::generate_card_actions(detail::get_hand_cards(data), Verb::kDiscard, actions);
+        return actions.push_back(Action::make(kFactionID, Verb::kPass));
+    }
+    case game_state::Phase::kSetup: {
+        // Without the map's corners any clearing with room for a building can hold the keep
+        const MarquiseBoard marquise = scan_board(state.board);
+        if (marquise.keep != 0)
+            return actions.push_back(Action::make(kFactionID, Verb::kPass));
+        for (ClearingMask remaining = marquise.openSlots; remaining != 0; remaining &= remaining - 1) {
+            const auto keep = actions.push_back(Action::make(kFactionID, Verb::kPlaceKeep, static_cast<uint8_t>(std::countr_zero(remaining))));
+            [[unlikely]] if (!keep.has_value())
+                return keep;
+        }
+        return {};
+    }
+    case game_state::Phase::kGameOver:
+        return {};
+    }
+    return {};
+}
+} // marquise_moves
+} // game_data
@@ -0,0 +1,538 @@
+#pragma once
+
+#include "game_data.hpp"
+#include "action.hpp"
+#include "board_data.hpp"
+#include "card_pile.hpp"
+#include "game_state.hpp"
+#include "playout.hpp"
+#include "task_scheduler.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstddef>
+#include <expected>
+#include <limits>
+#include <memory>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace game_data
+{
+namespace mcts
+{
+
+namespace board_data = ::game_data::board_data;
+namespace pile_data = ::game_data::pile_data;
+namespace game_state = ::game_data::game_state;
+namespace rng = ::game_data::rng;
+namespace action = ::game_data::action;
+namespace playout = ::game_data::playout;
+namespace task = ::game_data::task;
+
+struct SearchError {
+    enum class Code : uint8_t {
+        kTreeTooSmall,
+        kAllocationFailed,
+        kNoLegalActions,
+        kMoveGenerationFailed,
+        kPlayoutFailed,
+        kNoSearchLimit,
+        kUnknownError
+    } code;
+
+    static constexpr std::array<std::string_view, 7> kMessages = {
+        "Tree needs room for the root and one full expansion per thread",
+        "Could not allocate the tree",
+        "Root position has no legal actions",
+        "Move generator could not list every legal action",
+        "Playout could not be finished",
+        "Search needs an iteration or time limit",
+        "Unknown error"
+    };
+
+    [[nodiscard]] static std::string_view to_string(Code code) {
+        uint8_t idx = static_cast<uint8_t>(code);
+        [[likely]] if (idx < kMessages.size()) return kMessages[idx];
+        return kMessages.back();
+    }
+
+    [[nodiscard]] inline std::string_view message() const { return to_string(code); }
+};
+
+using NodeIndex = uint32_t;
+using EdgeIndex = uint32_t;
+
+static constexpr NodeIndex kRootNode = 0;
+static constexpr NodeIndex kNoNode = UINT32_MAX;
+
+enum class NodeState : uint8_t
+{
+    kLeaf,
+    // One thread is listing the node's actions, everyone else treats it as a leaf until it is done
+    kExpanding,
+    kExpanded
+};
+
+/*
+    Nodes and edges of one search in a fixed size bump arena, addressed by 32 bit indices.
+
+    Every node but the root is the child of exactly one edge, so edge e leads to node e + 1 and one counter hands
+    out both. Edge statistics are kept as one array per field, so scoring the children of a node reads each field
+    as a contiguous run. Nothing is freed during a search; compact_into copies the part worth keeping into another
+    tree instead
+*/
+class Tree
+{
+public:
+    // capacity counts edges, the arena holds one more node than that for the root
+    [[nodiscard]] static std::expected<Tree, SearchError> create(uint32_t capacity);
+
+    Tree(Tree &&other) noexcept;
+    Tree &operator=(Tree &&other) noexcept;
+    Tree(const Tree &) = delete;
+    Tree &operator=(const Tree &) = delete;
+    ~Tree() = default;
+
+    // Back to a lone unexpanded root. Stale nodes past the counter are reset as they are handed out again
+    void clear();
+
+    [[nodiscard]] inline NodeState get_state(NodeIndex node) const { return nodes[node].state.load(std::memory_order_acquire); }
+    // True for the one thread that gets to expand node
+    [[nodiscard]] inline bool try_begin_expansion(NodeIndex node)
+    {
+        NodeState expected = NodeState::kLeaf;
+        return nodes[node].state.compare_exchange_strong(expected, NodeState::kExpanding, std::memory_order_acquire, std::memory_order_relaxed);
+    }
+    inline void cancel_expansion(NodeIndex node) { nodes[node].state.store(NodeState::kLeaf, std::memory_order_release); }
+
+    // Gives node one edge per action, with fresh leaves behind them. False when the arena cannot hold them, the
+    // node is then left expanding and the caller cancels
+    [[nodiscard]] bool expand(NodeIndex node, std::span<const action::Action> actions, std::span<const float> priors);
+
+    [[nodiscard]] inline EdgeIndex get_first_edge(NodeIndex node) const { return nodes[node].firstEdge; }
+    [[nodiscard]] inline uint16_t get_edge_count(NodeIndex node) const { return nodes[node].edgeCount; }
+    [[nodiscard]] static inline NodeIndex get_child(EdgeIndex edge) { return edge + 1; }
+    // kNoNode when node is not expanded or has no edge for the action
+    [[nodiscard]] NodeIndex find_child(NodeIndex node, action::Action edgeAction) const;
+
+    [[nodiscard]] inline action::Action get_action(EdgeIndex edge) const { return actions[edge]; }
+    [[nodiscard]] inline float get_prior(EdgeIndex edge) const { return priors[edge]; }
+    [[nodiscard]] inline uint32_t get_visits(EdgeIndex edge) const { return visits[edge].load(std::memory_order_relaxed); }
+    [[nodiscard]] inline uint32_t get_virtual_loss(EdgeIndex edge) const { return virtualLosses[edge].load(std::memory_order_relaxed); }
+    [[nodiscard]] inline float get_value_sum(EdgeIndex edge) const { return valueSums[edge].load(std::memory_order_relaxed); }
+
+    // A thread on its way down counts as a visit that lost, so the threads behind it spread out
+    inline void add_virtual_loss(EdgeIndex edge) { virtualLosses[edge].fetch_add(1, std::memory_order_relaxed); }
+    inline void backup(EdgeIndex edge, float reward)
+    {
+        valueSums[edge].fetch_add(reward, std::memory_order_relaxed);
+        visits[edge].fetch_add(1, std::memory_order_relaxed);
+        virtualLosses[edge].fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] inline uint32_t get_edge_count() const { return edgeCount.load(std::memory_order_relaxed); }
+    [[nodiscard]] inline uint32_t get_node_count() const { return get_edge_count() + 1; }
+    [[nodiscard]] inline uint32_t get_capacity() const { return capacity; }
+
+    /*
+        Copies the subtree under sourceRoot into destination with sourceRoot as its root, expanding nodes best first
+        by visits. Once the next node's edges would take destination past nodeBudget nodes that node is kept as a
+        leaf, so the least visited subtrees are the ones dropped. Only call this while no search uses either tree
+    */
+    void compact_into(Tree &destination, NodeIndex sourceRoot, uint32_t nodeBudget) const;
+
+private:
+    struct Node
+    {
+        EdgeIndex firstEdge;
+        uint16_t edgeCount;
+        std::atomic<NodeState> state;
+    };
+
+    Tree(uint32_t capacity);
+
+    // Hands out count consecutive edges, nothing if they do not fit
+    [[nodiscard]] bool allocate_edges(uint16_t count, EdgeIndex &firstEdge);
+
+    uint32_t capacity = 0;
+    std::atomic<uint32_t> edgeCount = 0;
+
+    std::unique_ptr<Node[]> nodes;
+    std::unique_ptr<action::Action[]> actions;
+    std::unique_ptr<float[]> priors;
+    std::unique_ptr<std::atomic<uint32_t>[]> visits;
+    std::unique_ptr<std::atomic<uint32_t>[]> virtualLosses;
+    std::unique_ptr<std::atomic<float>[]> valueSums;
+};
+
+// What a finished playout is worth to a seat: 1 for the winner, else a share of the score that scales to half a win
+[[nodiscard]] float get_reward(const playout::PlayoutResult &result, uint8_t seat);
+
+/*
+    Information set sampling. Every hand but the observer's goes back into the deck, the deck is shuffled and the
+    hands are dealt again at their old sizes, so a search never peeks at cards its seat could not see. stateKey is the
+    game state's key, the redealt cards move in it too
+*/
+void determinize(
+    rng::RngStream &rng,
+    pile_data::PackedPile &deck,
+    uint64_t &deckKey,
+    std::span<game_state::FactionBlock> seats,
+    uint8_t observer,
+    uint64_t &stateKey
+);
+
+struct SearchConfig
+{
+    // Searcher tasks sharing the tree, they run on the scheduler's workers
+    uint8_t threadCount = 1;
+    // Nodes the tree may grow to before its least visited subtrees are pruned
+    uint32_t nodeBudget = 1U << 20;
+    float exploration = 1.25f;
+    playout::PlayoutConfig playout{playout::Policy::kHeuristic, playout::kDefaultMaxTurns};
+};
+
+// Zero means no limit, at least one of them has to be set
+struct SearchLimits
+{
+    uint64_t maxIterations = 0;
+    std::chrono::milliseconds maxTime{0};
+};
+
+struct SearchStats
+{
+    uint64_t iterations = 0;
+    uint32_t prunes = 0;
+    uint32_t nodes = 0;
+    uint16_t maxDepth = 0;
+    double seconds = 0.0;
+
+    [[nodiscard]] inline double get_iterations_per_second() const { return seconds <= 0.0 ? 0.0 : double(iterations) / seconds; }
+};
+
+struct SearchResult
+{
+    action::Action bestAction;
+    uint32_t visits;
+    // Mean reward of bestAction for the seat to act
+    float value;
+    SearchStats stats;
+};
+
+/*
+    Open loop ISMCTS over the packed game state. Edges are actions; each iteration samples the hidden cards and the
+    dice again and replays the path from the root, so a node stands for every state its action sequence can reach
+    and only the edges legal in the current sample compete. Leaves are scored by one playout.
+
+    Searcher tasks on the scheduler share one tree and spread out with virtual loss. Children are picked by PUCT with priors from the
+    playout policy's verb weights
+*/
+template <board_data::BoardType boardType>
+    requires (boardType != board_data::BoardType::kMountain)
+class Search
+{
+public:
+    static constexpr uint16_t kMaxDepth = 512;
+    // Share of the budget a prune keeps, so pruning does not come back after a handful of iterations
+    static constexpr uint32_t kPruneKeepPercent = 75;
+
+    // scheduler has to outlive the search
+    [[nodiscard]] static std::expected<Search, SearchError> create(
+        const game_state::GameState<boardType> &root,
+        const SearchConfig &config,
+        task::TaskScheduler &scheduler)
+    {
+        const uint32_t headroom = uint32_t(std::max<uint8_t>(config.threadCount, 1)) * action::kMaxLegalActions;
+        [[unlikely]] if (config.nodeBudget <= headroom)
+            return std::unexpected(SearchError{SearchError::Code::kTreeTooSmall});
+
+        auto active = Tree::create(config.nodeBudget + headroom);
+        [[unlikely]] if (!active.has_value())
+            return std::unexpected(active.error());
+        auto spare = Tree::create(config.nodeBudget + headroom);
+        [[unlikely]] if (!spare.has_value())
+            return std::unexpected(spare.error());
+
+        return Search(root, config, scheduler, std::move(active.value()), std::move(spare.value()));
+    }
+
+    /*
+        Grows the tree until a limit is reached and returns the most visited action at the root. Running again
+        continues the same tree
+    */
+    [[nodiscard]] std::expected<SearchResult, SearchError> run(const SearchLimits &limits)
+    {
+        [[unlikely]] if (limits.maxIterations == 0 && limits.maxTime.count() == 0)
+            return std::unexpected(SearchError{SearchError::Code::kNoSearchLimit});
+
+        SearchStats stats;
+        const auto start = std::chrono::steady_clock::now();
+        const auto deadline = start + limits.maxTime;
+        const uint8_t threadCount = std::max<uint8_t>(config.threadCount, 1);
+
+        while (true) {
+            std::atomic<bool> stop = false;
+            std::atomic<bool> pruneNeeded = false;
+            std::atomic<uint8_t> errorCode = kNoError;
+            std::atomic<uint64_t> claimed = 0;
+            std::atomic<uint64_t> completed = 0;
+            std::vector<uint16_t> depths(threadCount, 0);
+            const uint64_t remaining = limits.maxIterations == 0 ? UINT64_MAX : limits.maxIterations - stats.iterations;
+
+            const auto work = [&, this](uint64_t searcherIndex, task::WorkerContext &context) {
+                const size_t arenaMark = context.arena.get_used();
+                Worker *scratch = context.arena.allocate<Worker>();
+                [[unlikely]] if (scratch == nullptr) {
+                    errorCode.store(static_cast<uint8_t>(SearchError::Code::kAllocationFailed), std::memory_order_relaxed);
+                    stop.store(true, std::memory_order_relaxed);
+                    return;
+                }
+                Worker &worker = *scratch;
+                while (!stop.load(std::memory_order_relaxed)) {
+                    const uint64_t iteration = claimed.fetch_add(1, std::memory_order_relaxed);
+                    if (iteration >= remaining || (limits.maxTime.count() != 0 && (iteration & kClockCheckMask) == 0 &&
+                        std::chrono::steady_clock::now() >= deadline)) {
+                        stop.store(true, std::memory_order_relaxed);
+                        break;
+                    }
+
+                    const auto result = run_iteration(worker, nextIteration + iteration);
+                    [[unlikely]] if (!result.has_value()) {
+                        errorCode.store(static_cast<uint8_t>(result.error().code), std::memory_order_relaxed);
+                        stop.store(true, std::memory_order_relaxed);
+                        break;
+                    }
+                    completed.fetch_add(1, std::memory_order_relaxed);
+                    if (get_tree().get_node_count() > config.nodeBudget) {
+                        pruneNeeded.store(true, std::memory_order_relaxed);
+                        stop.store(true, std::memory_order_relaxed);
+                    }
+                }
+                depths[searcherIndex] = worker.maxDepth;
+                context.arena.rewind(arenaMark);
+            };
+            scheduler->fork_join(threadCount, work);
+
+            // Iterations are numbered by claim, the ones claimed past a stop are skipped for good so that no two
+            // iterations of this search ever share a counter range
+            nextIteration += claimed.load(std::memory_order_relaxed);
+            stats.iterations += completed.load(std::memory_order_relaxed);
+            for (const uint16_t depth : depths)
+                stats.maxDepth = std::max(stats.maxDepth, depth);
+
+            [[unlikely]] if (errorCode.load(std::memory_order_relaxed) != kNoError)
+                return std::unexpected(SearchError{static_cast<SearchError::Code>(errorCode.load(std::memory_order_relaxed))});
+
+            const bool isOutOfTime = limits.maxTime.count() != 0 && std::chrono::steady_clock::now() >= deadline;
+            const bool isOutOfIterations = limits.maxIterations != 0 && stats.iterations >= limits.maxIterations;
+            if (!pruneNeeded.load(std::memory_order_relaxed) || isOutOfTime || isOutOfIterations)
+                break;
+
+            prune();
+            ++stats.prunes;
+        }
+
+        stats.nodes = get_tree().get_node_count();
+        stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return get_best(stats);
+    }
+
+    // Moves the root along the action that was played, keeping what the search learned below it
+    void advance(action::Action played, const game_state::GameState<boardType> &newRoot)
+    {
+        Tree &spare = trees[activeTree ^ 1];
+        const NodeIndex child = get_tree().find_child(kRootNode, played);
+        if (child == kNoNode)
+            spare.clear();
+        else
+            get_tree().compact_into(spare, child, get_prune_budget());
+        activeTree ^= 1;
+        root = newRoot;
+    }
+
+    [[nodiscard]] inline const Tree &get_tree() const { return trees[activeTree]; }
+    [[nodiscard]] inline const game_state::GameState<boardType> &get_root() const { return root; }
+
+private:
+    static constexpr uint8_t kNoError = UINT8_MAX;
+    static constexpr uint64_t kClockCheckMask = 63;
+
+    struct PathStep
+    {
+        EdgeIndex edge;
+        uint8_t seat;
+    };
+
+    // Scratch space of one searcher, taken from its worker's arena and reused by all its iterations
+    struct Worker
+    {
+        action::ActionList actions;
+        std::array<float, action::kMaxLegalActions> priors;
+        std::array<float, action::kMaxLegalActions> visitCounts;
+        std::array<float, action::kMaxLegalActions> valueSums;
+        std::array<float, action::kMaxLegalActions> edgePriors;
+        std::array<float, action::kMaxLegalActions> legalMask;
+        std::array<float, action::kMaxLegalActions> scores;
+        std::array<PathStep, kMaxDepth> path;
+        uint16_t maxDepth = 0;
+    };
+
+    Search(const game_state::GameState<boardType> &root, const SearchConfig &config, task::TaskScheduler &scheduler, Tree &&active, Tree &&spare)
+        : root(root), config(config), scheduler(&scheduler), trees{std::move(active), std::move(spare)} {}
+
+    // Taken in 64 bits, budgets above 2^32 / kPruneKeepPercent would wrap otherwise
+    [[nodiscard]] inline uint32_t get_prune_budget() const
+    {
+        return static_cast<uint32_t>(uint64_t(config.nodeBudget) * kPruneKeepPercent / 100);
+    }
+
+    inline void prune()
+    {
+        trees[activeTree].compact_into(trees[activeTree ^ 1], kRootNode, get_prune_budget());
+        activeTree ^= 1;
+    }
+
+    // PUCT over the edges of node that are legal in this sample, kNoNode when none are
+    [[nodiscard]] EdgeIndex select_edge(Worker &worker, NodeIndex node, const action::ActionList &legal) const
+    {
+        const Tree &tree = get_tree();
+        const EdgeIndex firstEdge = tree.get_first_edge(node);
+        const uint16_t edgeCount = tree.get_edge_count(node);
+
+        // Gather pass: atomics and the legality lookups, one field per array
+        float parentVisits = 1.0f;
+        for (uint16_t index = 0; index < edgeCount; ++index) {
+            const EdgeIndex edge = firstEdge + index;
+            const bool isLegal = std::binary_search(legal.begin(), legal.end(), tree.get_action(edge));
+            worker.legalMask[index] = isLegal ? 0.0f : -std::numeric_limits<float>::infinity();
+            worker.visitCounts[index] = float(tree.get_visits(edge) + tree.get_virtual_loss(edge));
+            worker.valueSums[index] = tree.get_value_sum(edge);
+            worker.edgePriors[index] = tree.get_prior(edge);
+            parentVisits += isLegal ? worker.visitCounts[index] : 0.0f;
+        }
+
+        // Score pass: straight line arithmetic over the arrays, kept apart from the argmax so it has no branches
+        const float explorationScale = config.exploration * std::sqrt(parentVisits);
+        for (uint16_t index = 0; index < edgeCount; ++index) {
+            const float count = worker.visitCounts[index];
+            const float meanValue = worker.valueSums[index] / std::max(count, 1.0f);
+            worker.scores[index] = meanValue + explorationScale * worker.edgePriors[index] / (1.0f + count) + worker.legalMask[index];
+        }
+
+        // Illegal edges score -infinity and never win, so no legal edge leaves best at kNoNode
+        EdgeIndex best = kNoNode;
+        float bestScore = -std::numeric_limits<float>::infinity();
+        for (uint16_t index = 0; index < edgeCount; ++index) {
+            if (worker.scores[index] > bestScore) {
+                bestScore = worker.scores[index];
+                best = firstEdge + index;
+            }
+        }
+        return best;
+    }
+
+    [[nodiscard]] std::expected<void, SearchError> expand(Worker &worker, NodeIndex node)
+    {
+        Tree &tree = trees[activeTree];
+        const std::span<const action::Action> legal = worker.actions.get_actions();
+        float totalWeight = 0.0f;
+        for (const action::Action candidate : legal)
+            totalWeight += playout::kHeuristicWeights[static_cast<size_t>(candidate.get_verb())];
+        for (size_t index = 0; index < legal.size(); ++index)
+            worker.priors[index] = playout::kHeuristicWeights[static_cast<size_t>(legal[index].get_verb())] / totalWeight;
+
+        if (!tree.expand(node, legal, std::span<const float>(worker.priors.data(), legal.size())))
+            tree.cancel_expansion(node);
+        return {};
+    }
+
+    [[nodiscard]] std::expected<void, SearchError> run_iteration(Worker &worker, uint64_t iteration)
+    {
+        Tree &tree = trees[activeTree];
+        game_state::GameState<boardType> state = root;
+        // In tree draws get a stream per iteration, the playout ending the iteration splits its own off that one
+        state.rng = root.rng.split(rng::Stream::kSearch).split(static_cast<uint32_t>(iteration));
+        determinize(state.rng, state.deck, state.deckZobristKey, std::span(state.factions.data(), state.playerCount), root.currentPlayer, state.zobristKey);
+
+        NodeIndex node = kRootNode;
+        uint16_t depth = 0;
+        while (state.phase != game_state::Phase::kGameOver && depth < kMaxDepth) {
+            const NodeState nodeState = tree.get_state(node);
+            if (nodeState != NodeState::kExpanded) {
+                if (nodeState == NodeState::kLeaf && tree.try_begin_expansion(node)) {
+                    [[unlikely]] if (!playout::generate_actions(state, worker.actions).has_value()) {
+                        tree.cancel_expansion(node);
+                        return std::unexpected(SearchError{SearchError::Code::kMoveGenerationFailed});
+                    }
+                    worker.actions.sort();
+                    const auto expanded = expand(worker, node);
+                    [[unlikely]] if (!expanded.has_value())
+                        return expanded;
+                }
+                break;
+            }
+
+            [[unlikely]] if (!playout::generate_actions(state, worker.actions).has_value())
+                return std::unexpected(SearchError{SearchError::Code::kMoveGenerationFailed});
+            worker.actions.sort();
+
+            const EdgeIndex edge = select_edge(worker, node, worker.actions);
+            if (edge == kNoNode)
+                break;
+
+            tree.add_virtual_loss(edge);
+            worker.path[depth++] = {edge, state.currentPlayer};
+            [[unlikely]] if (!playout::apply_action(state, tree.get_action(edge)).has_value()) {
+                for (uint16_t step = 0; step < depth; ++step)
+                    tree.backup(worker.path[step].edge, 0.0f);
+                return std::unexpected(SearchError{SearchError::Code::kPlayoutFailed});
+            }
+            node = Tree::get_child(edge);
+        }
+        worker.maxDepth = std::max(worker.maxDepth, depth);
+
+        const auto result = playout::run_playout(state, static_cast<uint32_t>(iteration), config.playout);
+        for (uint16_t step = 0; step < depth; ++step)
+            tree.backup(worker.path[step].edge, result.has_value() ? get_reward(result.value(), worker.path[step].seat) : 0.0f);
+        [[unlikely]] if (!result.has_value())
+            return std::unexpected(SearchError{SearchError::Code::kPlayoutFailed});
+        return {};
+    }
+
+    [[nodiscard]] std::expected<SearchResult, SearchError> get_best(const SearchStats &stats) const
+    {
+        const Tree &tree = get_tree();
+        [[unlikely]] if (tree.get_state(kRootNode) != NodeState::kExpanded || tree.get_edge_count(kRootNode) == 0)
+            return std::unexpected(SearchError{SearchError::Code::kNoLegalActions});
+
+        const EdgeIndex firstEdge = tree.get_first_edge(kRootNode);
+        EdgeIndex best = firstEdge;
+        for (EdgeIndex edge = firstEdge + 1; edge < firstEdge + tree.get_edge_count(kRootNode); ++edge)
+            if (tree.get_visits(edge) > tree.get_visits(best))
+                best = edge;
+
+        const uint32_t bestVisits = tree.get_visits(best);
+        return SearchResult{
+            .bestAction = tree.get_action(best),
+            .visits = bestVisits,
+            .value = bestVisits == 0 ? 0.0f : tree.get_value_sum(best) / float(bestVisits),
+            .stats = stats
+        };
+    }
+
+    game_state::GameState<boardType> root;
+    SearchConfig config;
+    task::TaskScheduler *scheduler;
+    std::array<Tree, 2> trees;
+    uint8_t activeTree = 0;
+    // First iteration number the next run hands out, each iteration owns the counter ranges under its number
+    uint64_t nextIteration = 0;
+};
+} // mcts
+} // game_data
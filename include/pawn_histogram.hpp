@@ -0,0 +1,70 @@
+#pragma once
+
+#include "game_data.hpp"
+#include "clearing_data.hpp"
+
+#include <array>
+#include <cstdint>
+
+namespace game_data
+{
+namespace board_data
+{
+namespace pawn_histogram
+{
+
+namespace faction_data = ::game_data::faction_data;
+namespace clearing_data = ::game_data::board_data::clearing_data;
+
+static constexpr uint8_t kTotalPawnFactions = static_cast<uint8_t>(faction_data::FactionID::kKeepersInIron) + 1;
+// kTotalClearings rounded up to a full 16 byte vector, the padding lanes always hold zero
+static constexpr uint8_t kClearingLanes = 16;
+static_assert(kTotalClearings <= kClearingLanes, "Every clearing needs a lane");
+
+using ::game_data::board_data::ClearingMask;
+using PawnWords = std::array<uint64_t, kTotalClearings>;
+
+template <typename T>
+using LaneArray = std::array<T, kClearingLanes>;
+
+struct FactionCount
+{
+    faction_data::FactionID factionID;
+    uint8_t count;
+};
+
+// Sorted by count, highest first. Ties go to the lower FactionID, and a count of 0 means nobody holds that place
+struct TopTwo
+{
+    std::array<FactionCount, 2> places;
+};
+
+// Warrior counts of every faction in every clearing, stored faction major so each query walks one contiguous row
+// per faction instead of decoding clearings one at a time
+class PawnHistogram
+{
+public:
+    explicit PawnHistogram(const PawnWords &pawnWords);
+
+    [[nodiscard]] inline const LaneArray<uint8_t> &get_counts(faction_data::FactionID factionID) const { return counts[static_cast<uint8_t>(factionID)]; }
+    [[nodiscard]] inline const LaneArray<uint8_t> &get_totals() const { return totals; }
+
+    [[nodiscard]] ClearingMask get_clearings_with_at_least(faction_data::FactionID factionID, uint8_t minimumCount) const;
+    [[nodiscard]] inline ClearingMask get_clearings_present(faction_data::FactionID factionID) const { return get_clearings_with_at_least(factionID, 1); }
+
+    [[nodiscard]] std::array<TopTwo, kTotalClearings> get_top_two() const;
+
+    [[nodiscard]] LaneArray<uint8_t> get_enemy_counts(faction_data::FactionID factionID) const;
+    // adjacency[i] is the mask of clearings next to clearing i
+    [[nodiscard]] LaneArray<uint16_t> get_adjacent_enemy_counts(faction_data::FactionID factionID, const std::array<ClearingMask, kTotalClearings> &adjacency) const;
+    [[nodiscard]] uint16_t get_enemy_count_in(faction_data::FactionID factionID, ClearingMask clearings) const;
+
+private:
+    static constexpr ClearingMask kAllClearingsMask = (1U << kTotalClearings) - 1;
+
+    alignas(kClearingLanes) std::array<LaneArray<uint8_t>, kTotalPawnFactions> counts;
+    alignas(kClearingLanes) LaneArray<uint8_t> totals;
+};
+} // pawn_histogram
+} // board_data
+} // game_data
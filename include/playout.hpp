@@ -0,0 +1,817 @@
+#pragma once
+
+#include "game_data.hpp"
+#include "action.hpp"
+#include "board_data.hpp"
+#include "card_data.hpp"
+#include "card_pile.hpp"
+#include "clearing_data.hpp"
+#include "factions_data.hpp"
+#include "game_state.hpp"
+#include "marquise_moves.hpp"
+#include "reachability.hpp"
+#include "task_scheduler.hpp"
+#include "token_data.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <expected>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace game_data
+{
+namespace playout
+{
+
+namespace board_data = ::game_data::board_data;
+namespace card_data = ::game_data::card_data;
+namespace clearing_data = ::game_data::board_data::clearing_data;
+namespace building_data = ::game_data::board_data::clearing_data::building_data;
+namespace token_data = ::game_data::token_data;
+namespace pile_data = ::game_data::pile_data;
+namespace faction_data = ::game_data::faction_data;
+namespace game_state = ::game_data::game_state;
+namespace rng = ::game_data::rng;
+namespace action = ::game_data::action;
+namespace marquise_moves = ::game_data::marquise_moves;
+namespace task = ::game_data::task;
+
+using board_data::ClearingMask;
+using faction_data::FactionID;
+
+struct PlayoutError {
+    enum class Code : uint8_t {
+        kNoLegalActions,
+        kMoveGenerationFailed,
+        kIllegalAction,
+        kBoardUpdateFailed,
+        kUnknownError
+    } code;
+
+    static constexpr std::array<std::string_view, 5> kMessages = {
+        "Position has no legal actions but the game is not over",
+        "Move generator could not list every legal action",
+        "Action cannot be applied to this position",
+        "Board rejected a change made by an action",
+        "Unknown error"
+    };
+
+    [[nodiscard]] static std::string_view to_string(Code code) {
+        uint8_t idx = static_cast<uint8_t>(code);
+        [[likely]] if (idx < kMessages.size()) return kMessages[idx];
+        return kMessages.back();
+    }
+
+    [[nodiscard]] inline std::string_view message() const { return to_string(code); }
+};
+
+// How a playout picks among the legal actions
+enum class Policy : uint8_t
+{
+    kUniform,
+    // Weighted by verb toward actions that score, see kHeuristicWeights
+    kHeuristic
+};
+
+static constexpr uint8_t kWinningScore = 30;
+static constexpr uint8_t kNoWinner = UINT8_MAX;
+static constexpr uint16_t kDefaultMaxTurns = 60;
+
+// Relative odds of picking an action by its verb under Policy::kHeuristic
+static constexpr std::array<uint8_t, static_cast<size_t>(action::Verb::kMaxVerb)> kHeuristicWeights{[]{
+    using enum action::Verb;
+    std::array<uint8_t, static_cast<size_t>(kMaxVerb)> result{};
+    result.fill(1);
+    result[static_cast<size_t>(kBuild)] = 8;
+    result[static_cast<size_t>(kRecruit)] = 6;
+    result[static_cast<size_t>(kBattle)] = 4;
+    return result;
+}()};
+
+struct PlayoutConfig
+{
+    Policy policy = Policy::kUniform;
+    // Rounds of the table before a playout is cut off without a winner
+    uint16_t maxTurns = kDefaultMaxTurns;
+};
+
+struct PlayoutResult
+{
+    std::array<uint8_t, game_state::kMaxPlayers> scores;
+    // Seat that reached kWinningScore, kNoWinner if the playout ran out of turns first
+    uint8_t winner;
+    uint32_t steps;
+    uint16_t turns;
+};
+
+// Totals over a batch of playouts. Batches on different threads are summed afterwards
+struct PlayoutStats
+{
+    uint64_t playouts = 0;
+    uint64_t steps = 0;
+    uint64_t turns = 0;
+    double seconds = 0.0;
+
+    [[nodiscard]] inline double get_playouts_per_second() const { return seconds <= 0.0 ? 0.0 : double(playouts) / seconds; }
+    [[nodiscard]] inline double get_steps_per_second() const { return seconds <= 0.0 ? 0.0 : double(steps) / seconds; }
+
+    inline PlayoutStats &operator+=(const PlayoutStats &other)
+    {
+        playouts += other.playouts;
+        steps += other.steps;
+        turns += other.turns;
+        seconds += other.seconds;
+        return *this;
+    }
+};
+
+/*
+    In place edits of the packed blocks of a game state. Each keeps the block's Zobrist key current the same way the
+    owning class would, and stateKey, the game state's key, with the card or score keyed by its seat or pile. None of
+    them allocate.
+
+    Playouts keep raw victory points in a faction's score field
+*/
+[[nodiscard]] uint8_t get_score(const faction_data::PackedFaction &data);
+void add_score(game_state::FactionBlock &faction, uint8_t seat, uint8_t points, uint64_t &stateKey);
+
+[[nodiscard]] uint8_t get_hand_size(const faction_data::PackedFaction &data);
+// index has to be below the hand size
+[[nodiscard]] card_data::CardID get_card_in_hand(const faction_data::PackedFaction &data, uint8_t index);
+// False when the hand is already at its maximum size
+[[nodiscard]] bool add_card_to_hand(game_state::FactionBlock &faction, uint8_t seat, card_data::CardID card, uint64_t &stateKey);
+// Takes out one copy of card, the last card in hand fills its place. False when card is not in hand
+[[nodiscard]] bool remove_card_from_hand(game_state::FactionBlock &faction, uint8_t seat, card_data::CardID card, uint64_t &stateKey);
+
+[[nodiscard]] uint8_t get_pile_size(const pile_data::PackedPile &pile);
+// The top of a pile is its last card
+[[nodiscard]] std::optional<card_data::CardID> pop_card(pile_data::PackedPile &pile, uint64_t &zobristKey, zobrist::CardHolder holder, uint64_t &stateKey);
+[[nodiscard]] bool push_card(pile_data::PackedPile &pile, uint64_t &zobristKey, zobrist::CardHolder holder, card_data::CardID card, uint64_t &stateKey);
+
+// Fisher-Yates in place. Card keys are summed, so the pile's key does not change
+void shuffle_pile(rng::RngStream &rng, pile_data::PackedPile &pile);
+// Moves the discard pile into the deck and shuffles the deck in place
+void reshuffle_discard(
+    rng::RngStream &rng,
+    pile_data::PackedPile &deck,
+    uint64_t &deckKey,
+    pile_data::PackedPile &discard,
+    uint64_t &discardKey,
+    uint64_t &stateKey
+);
+
+// Draws from one stream block per pick, so a playout's choices only depend on its own counter range
+[[nodiscard]] action::Action select_action(const action::ActionList &actions, Policy policy, rng::RngStream &rng);
+
+namespace detail
+{
+
+// Pawn counts are set through a template per faction, this picks it at runtime
+template <typename Clearing>
+[[nodiscard]] inline std::expected<void, clearing_data::PawnError> set_pawn_count(Clearing &clearing, FactionID faction, uint8_t newCount)
+{
+    using enum FactionID;
+    switch (faction) {
+    case kMarquiseDeCat: return clearing.template set_pawn_count<kMarquiseDeCat>(newCount);
+    case kEyrieDynasty: return clearing.template set_pawn_count<kEyrieDynasty>(newCount);
+    case kWoodlandAlliance: return clearing.template set_pawn_count<kWoodlandAlliance>(newCount);
+    case kVagabond1: return clearing.template set_pawn_count<kVagabond1>(newCount);
+    case kVagabond2: return clearing.template set_pawn_count<kVagabond2>(newCount);
+    case kLizardCult: return clearing.template set_pawn_count<kLizardCult>(newCount);
+    case kRiverfolkCompany: return clearing.template set_pawn_count<kRiverfolkCompany>(newCount);
+    case kUndergroundDuchy: return clearing.template set_pawn_count<kUndergroundDuchy>(newCount);
+    case kCorvidConspiracy: return clearing.template set_pawn_count<kCorvidConspiracy>(newCount);
+    // Leaves the warlord alone
+    case kLordOfTheHundreds: return clearing.template set_pawn_count<kLordOfTheHundreds, false>(newCount);
+    case kKeepersInIron: return clearing.template set_pawn_count<kKeepersInIron>(newCount);
+    }
+    return std::unexpected(clearing_data::PawnError{clearing_data::PawnError::Code::kNewCountExceededMaximumCount});
+}
+
+// visit_clearing for edits, the change in the clearing's key goes into the game state's
+template <board_data::BoardType boardType, typename Function>
+inline auto update_clearing(game_state::GameState<boardType> &state, uint8_t clearingIndex, Function &&function)
+{
+    return state.board.visit_clearing(clearingIndex, [&state, &function](auto &clearing) {
+        const uint64_t oldKey = clearing.get_zobrist_key();
+        const auto result = function(clearing);
+        state.zobristKey += clearing.get_zobrist_key() - oldKey;
+        return result;
+    });
+}
+
+template <board_data::BoardType boardType>
+[[nodiscard]] inline std::expected<void, PlayoutError> add_pawns(game_state::GameState<boardType> &state, uint8_t clearingIndex, FactionID faction, int8_t delta)
+{
+    const uint8_t oldCount = state.board.get_pawn_histogram().get_counts(faction)[clearingIndex];
+    [[unlikely]] if (oldCount + delta < 0)
+        return std::unexpected(PlayoutError{PlayoutError::Code::kIllegalAction});
+
+    const bool updated = update_clearing(state, clearingIndex, [faction, newCount = uint8_t(oldCount + delta)](auto &clearing) {
+        return set_pawn_count(clearing, faction, newCount).has_value();
+    });
+    [[unlikely]] if (!updated)
+        return std::unexpected(PlayoutError{PlayoutError::Code::kBoardUpdateFailed});
+    return {};
+}
+
+template <board_data::BoardType boardType, token_data::Token token>
+[[nodiscard]] inline std::expected<void, PlayoutError> add_tokens(game_state::GameState<boardType> &state, uint8_t clearingIndex, int8_t delta)
+{
+    const bool updated = update_clearing(state, clearingIndex, [delta](auto &clearing) {
+        const int16_t newCount = int16_t(clearing.template get_token_count<token>().value_or(0)) + delta;
+        return newCount >= 0 && clearing.template set_token_count<token>(static_cast<uint8_t>(newCount)).has_value();
+    });
+    [[unlikely]] if (!updated)
+        return std::unexpected(PlayoutError{PlayoutError::Code::kBoardUpdateFailed});
+    return {};
+}
+
+template <board_data::BoardType boardType>
+[[nodiscard]] inline uint8_t get_remaining_slots(const board_data::Board<boardType> &board, uint8_t clearingIndex)
+{
+    return board.visit_clearing(clearingIndex, [](const auto &clearing) {
+        return clearing.get_remaining_slot_count().value_or(0);
+    });
+}
+
+template <board_data::BoardType boardType>
+[[nodiscard]] inline std::expected<void, PlayoutError> add_building(game_state::GameState<boardType> &state, uint8_t clearingIndex, building_data::Building building)
+{
+    const bool updated = update_clearing(state, clearingIndex, [building](auto &clearing) {
+        return clearing.add_building(building).has_value();
+    });
+    [[unlikely]] if (!updated)
+        return std::unexpected(PlayoutError{PlayoutError::Code::kBoardUpdateFailed});
+    return {};
+}
+
+template <board_data::BoardType boardType>
+inline void draw_cards(game_state::GameState<boardType> &state, uint8_t seat, uint8_t count)
+{
+    for (uint8_t drawn = 0; drawn < count; ++drawn) {
+        if (get_pile_size(state.deck) == 0)
+            reshuffle_discard(state.rng, state.deck, state.deckZobristKey, state.discard, state.discardZobristKey, state.zobristKey);
+
+        const std::optional<card_data::CardID> card = pop_card(state.deck, state.deckZobristKey, zobrist::CardHolder::kDeck, state.zobristKey);
+        if (!card.has_value())
+            return;
+        // A full hand cannot take the card, it goes straight to the discard
+        if (!add_card_to_hand(state.factions[seat], seat, card.value(), state.zobristKey))
+            (void)push_card(state.discard, state.discardZobristKey, zobrist::CardHolder::kDiscard, card.value(), state.zobristKey);
+    }
+}
+
+// Next seat's birdsong, a new round when the table wraps
+template <board_data::BoardType boardType>
+inline void end_turn(game_state::GameState<boardType> &state)
+{
+    state.turnState = {};
+    state.currentPlayer = static_cast<uint8_t>((state.currentPlayer + 1) % state.playerCount);
+    state.phase = game_state::Phase::kBirdsong;
+    if (state.currentPlayer == 0)
+        ++state.turn;
+}
+
+template <board_data::BoardType boardType>
+inline void end_setup_seat(game_state::GameState<boardType> &state)
+{
+    state.currentPlayer = static_cast<uint8_t>((state.currentPlayer + 1) % state.playerCount);
+    if (state.currentPlayer == 0)
+        state.phase = game_state::Phase::kBirdsong;
+}
+
+template <board_data::BoardType boardType>
+inline void begin_daylight(game_state::GameState<boardType> &state)
+{
+    state.phase = game_state::Phase::kDaylight;
+    state.turnState = {static_cast<uint8_t>(marquise_moves::MarquiseStep::kChooseAction), marquise_moves::kDaylightActions, 0};
+}
+
+/*
+    The keep, a warrior in every clearing but the one farthest from it, and one sawmill, workshop and recruiter in the
+    keep's clearing or the clearings next to it, lowest index first
+*/
+template <board_data::BoardType boardType>
+[[nodiscard]] inline std::expected<void, PlayoutError> place_marquise_setup(game_state::GameState<boardType> &state, uint8_t keepClearing)
+{
+    using marquise_moves::kFactionID;
+    const board_data::AdjacencyMasks &adjacency = board_data::clearingAdjacency[static_cast<size_t>(boardType)].land;
+
+    [[unlikely]] if (keepClearing >= board_data::kTotalClearings)
+        return std::unexpected(PlayoutError{PlayoutError::Code::kIllegalAction});
+
+    const auto keep = add_tokens<boardType, token_data::Token::kKeep>(state, keepClearing, 1);
+    [[unlikely]] if (!keep.has_value())
+        return keep;
+
+    uint8_t farthest = keepClearing;
+    for (uint8_t clearing = 0; clearing < board_data::kTotalClearings; ++clearing)
+        if (board_data::get_distance<boardType>(keepClearing, clearing) > board_data::get_distance<boardType>(keepClearing, farthest))
+            farthest = clearing;
+
+    for (uint8_t clearing = 0; clearing < board_data::kTotalClearings; ++clearing) {
+        if (clearing == farthest)
+            continue;
+        const auto warrior = add_pawns(state, clearing, kFactionID, 1);
+        [[unlikely]] if (!warrior.has_value())
+            return warrior;
+    }
+
+    const ClearingMask sites = static_cast<ClearingMask>(adjacency[keepClearing] | (1U << keepClearing));
+    for (const building_data::Building building : marquise_moves::kMarquiseBuildings) {
+        uint8_t site = keepClearing;
+        if (get_remaining_slots(state.board, site) == 0) {
+            site = board_data::kTotalClearings;
+            for (ClearingMask remaining = sites; remaining != 0 && site == board_data::kTotalClearings; remaining &= remaining - 1) {
+                const uint8_t candidate = static_cast<uint8_t>(std::countr_zero(remaining));
+                if (get_remaining_slots(state.board, candidate) > 0)
+                    site = candidate;
+            }
+        }
+        if (site == board_data::kTotalClearings)
+            continue;
+
+        const auto placed = add_building(state, site, building);
+        [[unlikely]] if (!placed.has_value())
+            return placed;
+    }
+    return {};
+}
+
+// A wood at every sawmill, in clearing order while the supply lasts
+template <board_data::BoardType boardType>
+[[nodiscard]] inline std::expected<void, PlayoutError> place_wood(game_state::GameState<boardType> &state)
+{
+    const marquise_moves::MarquiseBoard marquise = marquise_moves::scan_board(state.board);
+    uint8_t supply = marquise.woodSupply;
+    for (uint8_t clearing = 0; clearing < board_data::kTotalClearings && supply > 0; ++clearing) {
+        const uint8_t sawmills = state.board.visit_clearing(clearing, [](const auto &clearingData) {
+            return clearingData.count_buildings(building_data::Building::kSawmill);
+        });
+        const uint8_t placed = std::min(sawmills, supply);
+        if (placed == 0)
+            continue;
+
+        const auto wood = add_tokens<boardType, token_data::Token::kWood>(state, clearing, static_cast<int8_t>(placed));
+        [[unlikely]] if (!wood.has_value())
+            return wood;
+        supply -= placed;
+    }
+    return {};
+}
+
+// A warrior at every recruiter, in clearing order while the supply lasts
+template <board_data::BoardType boardType>
+[[nodiscard]] inline std::expected<void, PlayoutError> recruit(game_state::GameState<boardType> &state)
+{
+    const marquise_moves::MarquiseBoard marquise = marquise_moves::scan_board(state.board);
+    uint8_t supply = marquise.warriorSupply;
+    for (uint8_t clearing = 0; clearing < board_data::kTotalClearings && supply > 0; ++clearing) {
+        const uint8_t recruiters = state.board.visit_clearing(clearing, [](const auto &clearingData) {
+            return clearingData.count_buildings(building_data::Building::kRecruiter);
+        });
+        const uint8_t recruited = std::min(recruiters, supply);
+        if (recruited == 0)
+            continue;
+
+        const auto warriors = add_pawns(state, clearing, marquise_moves::kFactionID, static_cast<int8_t>(recruited));
+        [[unlikely]] if (!warriors.has_value())
+            return warriors;
+        supply -= recruited;
+    }
+    return {};
+}
+
+template <board_data::BoardType boardType>
+[[nodiscard]] inline std::expected<void, PlayoutError> build(game_state::GameState<boardType> &state, uint8_t site, building_data::Building building)
+{
+    const marquise_moves::MarquiseBoard marquise = marquise_moves::scan_board(state.board);
+    const auto type = std::find(marquise_moves::kMarquiseBuildings.begin(), marquise_moves::kMarquiseBuildings.end(), building);
+    [[unlikely]] if (site >= board_data::kTotalClearings || type == marquise_moves::kMarquiseBuildings.end())
+        return std::unexpected(PlayoutError{PlayoutError::Code::kIllegalAction});
+
+    const size_t typeIndex = static_cast<size_t>(type - marquise_moves::kMarquiseBuildings.begin());
+    const uint8_t built = marquise.builtCounts[typeIndex];
+    [[unlikely]] if (built >= marquise_moves::kBuildingsPerType)
+        return std::unexpected(PlayoutError{PlayoutError::Code::kIllegalAction});
+
+    const uint8_t cost = marquise_moves::kBuildCosts[built];
+    const board_data::AdjacencyMasks &adjacency = board_data::clearingAdjacency[static_cast<size_t>(boardType)].land;
+    const board_data::pawn_histogram::LaneArray<uint8_t> payment = marquise_moves::plan_wood_payment(site, cost, marquise.ruled, marquise.wood, adjacency);
+
+    uint8_t paid = 0;
+    for (uint8_t clearing = 0; clearing < board_data::kTotalClearings; ++clearing)
+        paid += payment[clearing];
+    [[unlikely]] if (paid < cost)
+        return std::unexpected(PlayoutError{PlayoutError::Code::kIllegalAction});
+
+    for (uint8_t clearing = 0; clearing < board_data::kTotalClearings; ++clearing) {
+        if (payment[clearing] == 0)
+            continue;
+        const auto wood = add_tokens<boardType, token_data::Token::kWood>(state, clearing, -static_cast<int8_t>(payment[clearing]));
+        [[unlikely]] if (!wood.has_value())
+            return wood;
+    }
+
+    const auto placed = add_building(state, site, building);
+    [[unlikely]] if (!placed.has_value())
+        return placed;
+
+    add_score(state.factions[state.currentPlayer], state.currentPlayer, marquise_moves::kBuildPoints[typeIndex][built], state.zobristKey);
+    return {};
+}
+
+// Points for whoever plays the faction, nothing when nobody at the table does
+template <board_data::BoardType boardType>
+inline void add_faction_score(game_state::GameState<boardType> &state, FactionID faction, uint8_t points)
+{
+    for (uint8_t seat = 0; seat < state.playerCount; ++seat) {
+        if (state.factions[seat].factionID == faction)
+            return add_score(state.factions[seat], seat, points, state.zobristKey);
+    }
+}
+
+// Hits left after the warriors, taken from the faction's tokens and then its buildings. Returns the pieces removed
+template <board_data::BoardType boardType>
+[[nodiscard]] inline std::expected<uint8_t, PlayoutError> remove_pieces(game_state::GameState<boardType> &state, uint8_t clearingIndex, FactionID faction, uint8_t hits)
+{
+    using enum token_data::Token;
+    using enum faction_data::FactionID;
+
+    uint8_t removed = 0;
+    const bool updated = update_clearing(state, clearingIndex, [faction, hits, &removed](auto &clearing) {
+        const auto removeTokens = [faction, hits, &removed, &clearing]<token_data::Token token>(FactionID owner) {
+            if (owner != faction || removed == hits)
+                return true;
+            const uint8_t count = clearing.template get_token_count<token>().value_or(0);
+            const uint8_t taken = std::min<uint8_t>(count, hits - removed);
+            removed += taken;
+            return taken == 0 || clearing.template set_token_count<token>(static_cast<uint8_t>(count - taken)).has_value();
+        };
+        const bool tokensRemoved = removeTokens.template operator()<kWood>(kMarquiseDeCat) &&
+            removeTokens.template operator()<kKeep>(kMarquiseDeCat) &&
+            removeTokens.template operator()<kSympathy>(kWoodlandAlliance) &&
+            removeTokens.template operator()<kMouseTradePost>(kRiverfolkCompany) &&
+            removeTokens.template operator()<kFoxTradePost>(kRiverfolkCompany) &&
+            removeTokens.template operator()<kRabbitTradePost>(kRiverfolkCompany) &&
+            removeTokens.template operator()<kTunnel>(kUndergroundDuchy) &&
+            removeTokens.template operator()<kBombPlot>(kCorvidConspiracy) &&
+            removeTokens.template operator()<kSnarePlot>(kCorvidConspiracy) &&
+            removeTokens.template operator()<kExtortionPlot>(kCorvidConspiracy) &&
+            removeTokens.template operator()<kRaidPlot>(kCorvidConspiracy) &&
+            removeTokens.template operator()<kMob>(kLordOfTheHundreds);
+        [[unlikely]] if (!tokensRemoved)
+            return false;
+
+        // From the last slot down so a removal never shifts a slot still to be checked
+        for (uint8_t slot = clearing.get_occupied_slot_count().value_or(0); slot > 0 && removed < hits; --slot) {
+            if (board_data::reachability::kBuildingOwners[static_cast<size_t>(clearing.get_building_in_slot(slot - 1))] != static_cast<uint8_t>(faction))
+                continue;
+            [[unlikely]] if (!clearing.remove_building(slot - 1).has_value())
+                return false;
+            ++removed;
+        }
+        return true;
+    });
+    [[unlikely]] if (!updated)
+        return std::unexpected(PlayoutError{PlayoutError::Code::kBoardUpdateFailed});
+    return removed;
+}
+
+/*
+    Two dice, the attacker deals the higher and the defender the lower, each capped by their warriors in the
+    clearing. A defender without warriors takes an extra hit. Warriors take hits first and the rest fall on tokens,
+    then buildings, each of those scoring a point for the other side
+*/
+template <board_data::BoardType boardType>
+[[nodiscard]] inline std::expected<void, PlayoutError> battle(game_state::GameState<boardType> &state, FactionID attacker, uint8_t clearing, FactionID defender)
+{
+    [[unlikely]] if (clearing >= board_data::kTotalClearings || attacker == defender)
+        return std::unexpected(PlayoutError{PlayoutError::Code::kIllegalAction});
+
+    const board_data::pawn_histogram::PawnHistogram histogram = state.board.get_pawn_histogram();
+    const uint8_t attackers = histogram.get_counts(attacker)[clearing];
+    const uint8_t defenders = histogram.get_counts(defender)[clearing];
+    [[unlikely]] if (attackers == 0)
+        return std::unexpected(PlayoutError{PlayoutError::Code::kIllegalAction});
+
+    const uint8_t firstDie = static_cast<uint8_t>(state.rng.draw_below(4));
+    const uint8_t secondDie = static_cast<uint8_t>(state.rng.draw_below(4));
+    const uint8_t attackerHits = std::min<uint8_t>(std::max(firstDie, secondDie), attackers) + (defenders == 0 ? 1 : 0);
+    const uint8_t defenderHits = std::min<uint8_t>(std::min(firstDie, secondDie), defenders);
+
+    const uint8_t defenderWarriorsLost = std::min(attackerHits, defenders);
+    const auto defenderLosses = add_pawns(state, clearing, defender, -static_cast<int8_t>(defenderWarriorsLost));
+    [[unlikely]] if (!defenderLosses.has_value())
+        return defenderLosses;
+    const auto defenderPieces = remove_pieces(state, clearing, defender, static_cast<uint8_t>(attackerHits - defenderWarriorsLost));
+    [[unlikely]] if (!defenderPieces.has_value())
+        return std::unexpected(defenderPieces.error());
+
+    const uint8_t attackerWarriorsLost = std::min(defenderHits, attackers);
+    const auto attackerLosses = add_pawns(state, clearing, attacker, -static_cast<int8_t>(attackerWarriorsLost));
+    [[unlikely]] if (!attackerLosses.has_value())
+        return attackerLosses;
+    const auto attackerPieces = remove_pieces(state, clearing, attacker, static_cast<uint8_t>(defenderHits - attackerWarriorsLost));
+    [[unlikely]] if (!attackerPieces.has_value())
+        return std::unexpected(attackerPieces.error());
+
+    add_faction_score(state, attacker, defenderPieces.value());
+    add_faction_score(state, defender, attackerPieces.value());
+    return {};
+}
+
+template <board_data::BoardType boardType>
+[[nodiscard]] inline std::expected<void, PlayoutError> move_warriors(game_state::GameState<boardType> &state, FactionID faction, action::Action move)
+{
+    [[unlikely]] if (move.get_origin() >= board_data::kTotalClearings || move.get_destination() >= board_data::kTotalClearings || move.get_count() == 0)
+        return std::unexpected(PlayoutError{PlayoutError::Code::kIllegalAction});
+
+    const auto left = add_pawns(state, move.get_origin(), faction, -static_cast<int8_t>(move.get_count()));
+    [[unlikely]] if (!left.has_value())
+        return left;
+    return add_pawns(state, move.get_destination(), faction, static_cast<int8_t>(move.get_count()));
+}
+
+// The card leaves the hand for the discard pile
+template <board_data::BoardType boardType>
+[[nodiscard]] inline std::expected<void, PlayoutError> spend_card(game_state::GameState<boardType> &state, uint8_t seat, card_data::CardID card)
+{
+    [[unlikely]] if (!remove_card_from_hand(state.factions[seat], seat, card, state.zobristKey) ||
+        !push_card(state.discard, state.discardZobristKey, zobrist::CardHolder::kDiscard, card, state.zobristKey))
+        return std::unexpected(PlayoutError{PlayoutError::Code::kIllegalAction});
+    return {};
+}
+
+// Items only, their points are their whole effect. The workshops paying for it are marked used in the turn state
+template <board_data::BoardType boardType>
+[[nodiscard]] inline std::expected<void, PlayoutError> craft(game_state::GameState<boardType> &state, card_data::CardID card)
+{
+    const card_data::CraftRecipe &recipe = card_data::kCraftRecipes[static_cast<uint8_t>(card)];
+    [[unlikely]] if (recipe.points == 0)
+        return std::unexpected(PlayoutError{PlayoutError::Code::kIllegalAction});
+
+    const auto spent = spend_card(state, state.currentPlayer, card);
+    [[unlikely]] if (!spent.has_value())
+        return spent;
+
+    for (uint8_t suit = 0; suit < card_data::kCraftSuits; ++suit)
+        state.turnState.flags += static_cast<uint16_t>(recipe.cost[suit] << (marquise_moves::kCraftedShift + suit * marquise_moves::kCraftedBits));
+    add_score(state.factions[state.currentPlayer], state.currentPlayer, recipe.points, state.zobristKey);
+    return {};
+}
+
+template <board_data::BoardType boardType>
+[[nodiscard]] inline std::expected<void, PlayoutError> overwork(game_state::GameState<boardType> &state, uint8_t site, card_data::CardID card)
+{
+    [[unlikely]] if (site >= board_data::kTotalClearings)
+        return std::unexpected(PlayoutError{PlayoutError::Code::kIllegalAction});
+
+    const auto spent = spend_card(state, state.currentPlayer, card);
+    [[unlikely]] if (!spent.has_value())
+        return spent;
+    return add_tokens<boardType, token_data::Token::kWood>(state, site, 1);
+}
+
+// Daylight ends, the Marquise draw one card plus one for each of the third and fifth recruiter
+template <board_data::BoardType boardType>
+inline void begin_marquise_evening(game_state::GameState<boardType> &state)
+{
+    const uint8_t recruiters = marquise_moves::scan_board(state.board).recruiterCount;
+    state.phase = game_state::Phase::kEvening;
+    state.turnState = {};
+    draw_cards(state, state.currentPlayer, static_cast<uint8_t>(1 + (recruiters >= 3) + (recruiters >= 5)));
+}
+} // detail
+
+/*
+    Legal actions of whoever is to act. Only the Marquise have a move generator so far; every other faction passes
+    through each of its steps
+*/
+template <board_data::BoardType boardType>
+    requires (boardType != board_data::BoardType::kMountain)
+[[nodiscard]] inline std::expected<void, action::ActionError> generate_actions(const game_state::GameState<boardType> &state, action::ActionList &actions)
+{
+    const FactionID faction = state.factions[state.currentPlayer].factionID;
+    if (faction == FactionID::kMarquiseDeCat)
+        return marquise_moves::generate_actions(state, actions);
+
+    actions.clear();
+    if (state.phase == game_state::Phase::kGameOver)
+        return {};
+    return actions.push_back(action::Action::make(faction, action::Verb::kPass));
+}
+
+/*
+    Plays one action produced by generate_actions for the seat to act, moving the turn along and ending the game
+    once a seat reaches kWinningScore. Only what the action needs to stay consistent is checked, legality is the
+    generator's job
+*/
+template <board_data::BoardType boardType>
+    requires (boardType != board_data::BoardType::kMountain)
+[[nodiscard]] inline std::expected<void, PlayoutError> apply_action(game_state::GameState<boardType> &state, action::Action chosen)
+{
+    using action::Verb;
+    using game_state::Phase;
+    using marquise_moves::MarquiseStep;
+
+    game_state::FactionBlock &faction = state.factions[state.currentPlayer];
+    game_state::TurnState &turnState = state.turnState;
+    const uint64_t oldTurnKey = game_state::get_turn_key(state);
+    std::expected<void, PlayoutError> result{};
+
+    switch (chosen.get_verb()) {
+    case Verb::kPass:
+        switch (state.phase) {
+        case Phase::kSetup:
+            detail::end_setup_seat(state);
+            break;
+        case Phase::kBirdsong:
+            detail::begin_daylight(state);
+            break;
+        case Phase::kDaylight:
+            if (static_cast<MarquiseStep>(turnState.step) == MarquiseStep::kSecondMove)
+                turnState.step = static_cast<uint8_t>(MarquiseStep::kChooseAction);
+            else if (faction.factionID == FactionID::kMarquiseDeCat)
+                detail::begin_marquise_evening(state);
+            else {
+                state.phase = Phase::kEvening;
+                turnState = {};
+            }
+            break;
+        case Phase::kEvening:
+            detail::end_turn(state);
+            break;
+        case Phase::kGameOver:
+            return std::unexpected(PlayoutError{PlayoutError::Code::kIllegalAction});
+        }
+        break;
+    case Verb::kPlaceKeep:
+        result = detail::place_marquise_setup(state, chosen.get_origin());
+        detail::end_setup_seat(state);
+        break;
+    case Verb::kPlaceWood:
+        result = detail::place_wood(state);
+        detail::begin_daylight(state);
+        break;
+    case Verb::kMarch:
+        result = detail::move_warriors(state, chosen.get_faction(), chosen);
+        --turnState.actionsLeft;
+        turnState.step = static_cast<uint8_t>(MarquiseStep::kSecondMove);
+        break;
+    case Verb::kMove:
+        result = detail::move_warriors(state, chosen.get_faction(), chosen);
+        turnState.step = static_cast<uint8_t>(MarquiseStep::kChooseAction);
+        break;
+    case Verb::kRecruit:
+        result = detail::recruit(state);
+        --turnState.actionsLeft;
+        turnState.flags |= marquise_moves::kRecruitedFlag;
+        break;
+    case Verb::kBuild:
+        result = detail::build(state, chosen.get_origin(), chosen.get_building());
+        --turnState.actionsLeft;
+        break;
+    case Verb::kBattle:
+        result = detail::battle(state, chosen.get_faction(), chosen.get_origin(), chosen.get_defender());
+        --turnState.actionsLeft;
+        break;
+    case Verb::kOverwork:
+        result = detail::overwork(state, chosen.get_origin(), chosen.get_card());
+        --turnState.actionsLeft;
+        break;
+    case Verb::kCraft:
+        result = detail::craft(state, chosen.get_card());
+        break;
+    case Verb::kDiscard:
+        result = detail::spend_card(state, state.currentPlayer, chosen.get_card());
+        // In daylight the discard is a bird card bought for an extra action
+        if (state.phase == Phase::kDaylight)
+            ++turnState.actionsLeft;
+        break;
+    default:
+        return std::unexpected(PlayoutError{PlayoutError::Code::kIllegalAction});
+    }
+    if (result.has_value() && get_score(faction.data) >= kWinningScore)
+        state.phase = Phase::kGameOver;
+    state.zobristKey += game_state::get_turn_key(state) - oldTurnKey;
+    return result;
+}
+
+/*
+    Plays state out to the end with policy picking every action. state is a clone, cloning is a memcpy. Draws come
+    from the child of the state's stream numbered playoutIndex, so every playout has a stream of its own and the same
+    index always replays the same game. The game's own stream is left where it was
+*/
+template <board_data::BoardType boardType>
+    requires (boardType != board_data::BoardType::kMountain)
+[[nodiscard]] inline std::expected<PlayoutResult, PlayoutError> run_playout(game_state::GameState<boardType> state, uint32_t playoutIndex, const PlayoutConfig &config)
+{
+    state.rng = state.rng.split(playoutIndex);
+
+    PlayoutResult result{};
+    result.winner = kNoWinner;
+    const uint16_t firstTurn = state.turn;
+    action::ActionList actions;
+
+    while (state.phase != game_state::Phase::kGameOver && state.turn - firstTurn < config.maxTurns) {
+        [[unlikely]] if (!generate_actions(state, actions).has_value())
+            return std::unexpected(PlayoutError{PlayoutError::Code::kMoveGenerationFailed});
+        [[unlikely]] if (actions.empty())
+            return std::unexpected(PlayoutError{PlayoutError::Code::kNoLegalActions});
+
+        const auto applied = apply_action(state, select_action(actions, config.policy, state.rng));
+        [[unlikely]] if (!applied.has_value())
+            return std::unexpected(applied.error());
+        ++result.steps;
+    }
+
+    for (uint8_t seat = 0; seat < state.playerCount; ++seat) {
+        result.scores[seat] = get_score(state.factions[seat].data);
+        if (state.phase == game_state::Phase::kGameOver && seat == state.currentPlayer)
+            result.winner = seat;
+    }
+    result.turns = static_cast<uint16_t>(state.turn - firstTurn);
+    return result;
+}
+
+// Plays count playouts of state with indices from firstIndex up, timing the batch
+template <board_data::BoardType boardType>
+    requires (boardType != board_data::BoardType::kMountain)
+[[nodiscard]] inline std::expected<PlayoutStats, PlayoutError> run_playouts(
+    const game_state::GameState<boardType> &state,
+    uint32_t count,
+    uint32_t firstIndex,
+    const PlayoutConfig &config)
+{
+    PlayoutStats stats;
+    const auto start = std::chrono::steady_clock::now();
+    for (uint32_t index = firstIndex; index < firstIndex + count; ++index) {
+        const auto playout = run_playout(state, index, config);
+        [[unlikely]] if (!playout.has_value())
+            return std::unexpected(playout.error());
+        ++stats.playouts;
+        stats.steps += playout.value().steps;
+        stats.turns += playout.value().turns;
+    }
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return stats;
+}
+
+/*
+    The same batch spread over the scheduler's workers. Each playout still draws from its own index, so the totals
+    match the serial batch whichever worker ran what
+*/
+template <board_data::BoardType boardType>
+    requires (boardType != board_data::BoardType::kMountain)
+[[nodiscard]] inline std::expected<PlayoutStats, PlayoutError> run_playouts(
+    task::TaskScheduler &scheduler,
+    const game_state::GameState<boardType> &state,
+    uint32_t count,
+    uint32_t firstIndex,
+    const PlayoutConfig &config)
+{
+    static constexpr uint64_t kPlayoutsPerTask = 8;
+    static constexpr uint8_t kNoError = UINT8_MAX;
+
+    struct alignas(game_state::kCacheLineBytes) WorkerStats
+    {
+        PlayoutStats stats;
+    };
+
+    std::vector<WorkerStats> workerStats(scheduler.get_worker_count());
+    std::atomic<uint8_t> errorCode = kNoError;
+    const auto start = std::chrono::steady_clock::now();
+    scheduler.parallel_for(firstIndex, uint64_t(firstIndex) + count, kPlayoutsPerTask, [&](uint64_t index, task::WorkerContext &worker) {
+        if (errorCode.load(std::memory_order_relaxed) != kNoError)
+            return;
+        const auto playout = run_playout(state, static_cast<uint32_t>(index), config);
+        [[unlikely]] if (!playout.has_value()) {
+            errorCode.store(static_cast<uint8_t>(playout.error().code), std::memory_order_relaxed);
+            return;
+        }
+        PlayoutStats &stats = workerStats[worker.index].stats;
+        ++stats.playouts;
+        stats.steps += playout.value().steps;
+        stats.turns += playout.value().turns;
+    });
+
+    [[unlikely]] if (errorCode.load(std::memory_order_relaxed) != kNoError)
+        return std::unexpected(PlayoutError{static_cast<PlayoutError::Code>(errorCode.load(std::memory_order_relaxed))});
+
+    PlayoutStats total;
+    for (const WorkerStats &partial : workerStats)
+        total += partial.stats;
+    total.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return total;
+}
+} // playout
+} // game_data
@@ -0,0 +1,154 @@
+#pragma once
+
+#include "game_data.hpp"
+#include "clearing_data.hpp"
+#include "token_data.hpp"
+#include "pawn_histogram.hpp"
+#include "board_data.hpp"
+
+#include <array>
+#include <cstdint>
+
+namespace game_data
+{
+namespace board_data
+{
+namespace reachability
+{
+
+namespace faction_data = ::game_data::faction_data;
+namespace building_data = ::game_data::board_data::clearing_data::building_data;
+namespace token_data = ::game_data::token_data;
+
+using pawn_histogram::kTotalPawnFactions;
+using pawn_histogram::LaneArray;
+
+// Ruled clearings of every faction, indexed by FactionID. Vagabonds never rule so their masks stay empty
+using RuleMasks = std::array<ClearingMask, kTotalPawnFactions>;
+
+// Warriors and buildings of every faction in every clearing, the pieces rule is counted from
+using PresenceCounts = std::array<LaneArray<uint8_t>, kTotalPawnFactions>;
+
+static constexpr uint8_t kNoOwner = kTotalPawnFactions;
+
+static constexpr std::array<uint8_t, static_cast<size_t>(building_data::Building::kMaxBuildingIndex)> kBuildingOwners{[]{
+    using enum building_data::Building;
+    using enum faction_data::FactionID;
+
+    std::array<uint8_t, static_cast<size_t>(kMaxBuildingIndex)> result{};
+    result.fill(kNoOwner);
+    for (building_data::Building building : {kWorkshop, kSawmill, kRecruiter})
+        result[static_cast<size_t>(building)] = static_cast<uint8_t>(kMarquiseDeCat);
+    result[static_cast<size_t>(kRoost)] = static_cast<uint8_t>(kEyrieDynasty);
+    for (building_data::Building building : {kMouseBase, kFoxBase, kRabbitBase})
+        result[static_cast<size_t>(building)] = static_cast<uint8_t>(kWoodlandAlliance);
+    for (building_data::Building building : {kMouseGarden, kFoxGarden, kRabbitGarden})
+        result[static_cast<size_t>(building)] = static_cast<uint8_t>(kLizardCult);
+    for (building_data::Building building : {kCitadel, kMarket})
+        result[static_cast<size_t>(building)] = static_cast<uint8_t>(kUndergroundDuchy);
+    result[static_cast<size_t>(kStronghold)] = static_cast<uint8_t>(kLordOfTheHundreds);
+    for (building_data::Building building : {kFigureAndTabletWaystation, kTabletAndJewelryWaystation, kJewelryAndFigureWaystation})
+        result[static_cast<size_t>(building)] = static_cast<uint8_t>(kKeepersInIron);
+    return result;
+}()};
+
+// Most pieces rules, ties leave a clearing unruled unless the Eyrie are among the leaders (Lords of the Forest)
+[[nodiscard]] RuleMasks compute_rule_masks(const PresenceCounts &presence);
+
+// One move of every clearing in origins at once. Edges in ruledAdjacency need rule at one end, edges in
+// freeAdjacency (rivers for the Riverfolk, everything for a Vagabond) ignore rule
+[[nodiscard]] inline constexpr ClearingMask get_move_step(
+    ClearingMask origins,
+    ClearingMask ruled,
+    const AdjacencyMasks &ruledAdjacency,
+    const AdjacencyMasks &freeAdjacency
+) {
+    return get_neighbours(origins & ruled, ruledAdjacency) |
+        (get_neighbours(origins, ruledAdjacency) & ruled) |
+        get_neighbours(origins, freeAdjacency);
+}
+
+static constexpr AdjacencyMasks kNoAdjacency{};
+
+struct ReachResult
+{
+    // bySource[i] holds every clearing warriors starting in clearing i can end on, including i itself
+    std::array<ClearingMask, kTotalClearings> bySource;
+    ClearingMask reachable;
+    // Warriors from every source that can reach the clearing on their own. With several sources this is an upper
+    // bound, since a march spends one of its moves per group
+    LaneArray<uint8_t> arrivals;
+};
+
+/*
+    Every clearing the faction's warriors in sources can reach in at most moves legal moves. Rule is taken from the
+    board before the moves start, so warriors moved earlier in the same action do not change it
+*/
+[[nodiscard]] ReachResult get_reachable(
+    faction_data::FactionID factionID,
+    ClearingMask sources,
+    uint8_t moves,
+    const RuleMasks &rule,
+    const pawn_histogram::PawnHistogram &histogram,
+    const AdjacencyMasks &ruledAdjacency,
+    const AdjacencyMasks &freeAdjacency = kNoAdjacency
+);
+
+template <BoardType boardType>
+[[nodiscard]] inline PresenceCounts get_presence_counts(const Board<boardType> &board)
+{
+    const pawn_histogram::PawnHistogram histogram = board.get_pawn_histogram();
+
+    PresenceCounts result;
+    for (uint8_t faction = 0; faction < kTotalPawnFactions; ++faction)
+        result[faction] = histogram.get_counts(static_cast<faction_data::FactionID>(faction));
+
+    for (uint8_t clearingIndex = 0; clearingIndex < kTotalClearings; ++clearingIndex) {
+        board.visit_clearing(clearingIndex, [&result, clearingIndex](const auto &clearing) {
+            const uint8_t occupiedSlotCount = clearing.get_occupied_slot_count().value_or(0);
+            for (uint8_t slot = 0; slot < occupiedSlotCount; ++slot) {
+                const uint8_t owner = kBuildingOwners[static_cast<size_t>(clearing.get_building_in_slot(slot))];
+                if (owner != kNoOwner)
+                    ++result[owner][clearingIndex];
+            }
+        });
+    }
+    return result;
+}
+
+// Tokens of every faction in every clearing, Corvid plots included. They never count toward rule, but they can be
+// battled
+template <BoardType boardType>
+[[nodiscard]] inline PresenceCounts get_token_counts(const Board<boardType> &board)
+{
+    using enum token_data::Token;
+    using enum faction_data::FactionID;
+
+    PresenceCounts result{};
+    for (uint8_t clearingIndex = 0; clearingIndex < kTotalClearings; ++clearingIndex) {
+        board.visit_clearing(clearingIndex, [&result, clearingIndex](const auto &clearing) {
+            const auto addTokens = [&result, clearingIndex, &clearing]<token_data::Token token>(faction_data::FactionID owner) {
+                result[static_cast<uint8_t>(owner)][clearingIndex] += clearing.template get_token_count<token>().value_or(0);
+            };
+            addTokens.template operator()<kWood>(kMarquiseDeCat);
+            addTokens.template operator()<kKeep>(kMarquiseDeCat);
+            addTokens.template operator()<kSympathy>(kWoodlandAlliance);
+            addTokens.template operator()<kMouseTradePost>(kRiverfolkCompany);
+            addTokens.template operator()<kFoxTradePost>(kRiverfolkCompany);
+            addTokens.template operator()<kRabbitTradePost>(kRiverfolkCompany);
+            addTokens.template operator()<kTunnel>(kUndergroundDuchy);
+            addTokens.template operator()<kMob>(kLordOfTheHundreds);
+            result[static_cast<uint8_t>(kCorvidConspiracy)][clearingIndex] += clearing.get_plot_count(clearing.get_token_word());
+        });
+    }
+    return result;
+}
+
+template <BoardType boardType>
+[[nodiscard]] inline RuleMasks get_rule_masks(const Board<boardType> &board)
+{
+    return compute_rule_masks(get_presence_counts(board));
+}
+} // reachability
+} // board_data
+} // game_data
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <type_traits>
+#include "Random123/threefry.h"
+
+namespace game_data
+{
+namespace rng
+{
+
+using Threefry = r123::Threefry2x32_R<12>;
+
+// What a game draws randomness for. Each purpose has its own stream, so drawing more for one never shifts another
+enum class Stream : uint32_t
+{
+    kSuitSetup,
+    kClearings,
+    kDeck,
+    kPlay,
+    kSearch,
+    kWorkers
+};
+
+/*
+    One independent Threefry stream, held by value. Its key comes from running the cipher once over (game id,
+    stream id) under the seed, so every triple gets a key of its own and no two streams ever share a counter.
+    Words are handed out of a buffer that is refilled kBufferedBlocks blocks at a time.
+
+    Copying a stream copies its position: the copy draws exactly what the original would have. Random123 does not
+    promise a constexpr cipher, so streams only draw at run time
+*/
+class RngStream
+{
+public:
+    static constexpr uint8_t kBufferedBlocks = 4;
+    static constexpr uint8_t kBufferedWords = kBufferedBlocks * 2;
+
+    constexpr RngStream() = default;
+    RngStream(uint64_t seed, uint32_t gameID, uint32_t streamID)
+        : key(derive_key(Threefry::key_type{{static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32)}}, gameID, streamID)) {}
+    RngStream(uint64_t seed, uint32_t gameID, Stream stream) : RngStream(seed, gameID, static_cast<uint32_t>(stream)) {}
+
+    // Child stream number streamID. It depends on this stream's key only, not on how far this stream has been drawn
+    [[nodiscard]] inline RngStream split(uint32_t streamID) const
+    {
+        RngStream child;
+        child.key = derive_key(key, streamID, kSplitDomain);
+        return child;
+    }
+    [[nodiscard]] inline RngStream split(Stream stream) const { return split(static_cast<uint32_t>(stream)); }
+
+    [[nodiscard]] inline uint32_t next()
+    {
+        [[unlikely]] if (cursor == kBufferedWords)
+            refill();
+        return buffer[cursor++];
+    }
+
+    // Uniform in [0, bound) with Lemire's multiply shift
+    [[nodiscard]] inline uint32_t draw_below(uint32_t bound)
+    {
+        // Smallest low product that keeps the draw unbiased, 2^32 mod bound
+        const uint32_t threshold = static_cast<uint32_t>(-bound) % bound;
+        while (true) {
+            const uint64_t product = static_cast<uint64_t>(next()) * bound;
+            [[likely]] if (static_cast<uint32_t>(product) >= threshold)
+                return static_cast<uint32_t>(product >> 32);
+        }
+    }
+
+private:
+    // High counter word of every derived key. Output blocks only reach it after 2^64 - 2^32 of them
+    static constexpr uint32_t kSplitDomain = UINT32_MAX;
+
+    [[nodiscard]] static inline Threefry::key_type derive_key(const Threefry::key_type &parent, uint32_t low, uint32_t high)
+    {
+        const Threefry generator;
+        const Threefry::ctr_type block = generator(Threefry::ctr_type{{low, high}}, parent);
+        return Threefry::key_type{{block[0], block[1]}};
+    }
+
+    inline void refill()
+    {
+        const Threefry generator;
+        for (uint8_t block = 0; block < kBufferedBlocks; ++block) {
+            const Threefry::ctr_type output = generator(
+                Threefry::ctr_type{{static_cast<uint32_t>(nextBlock), static_cast<uint32_t>(nextBlock >> 32)}}, key);
+            buffer[block * 2] = output[0];
+            buffer[block * 2 + 1] = output[1];
+            ++nextBlock;
+        }
+        cursor = 0;
+    }
+
+    Threefry::key_type key{};
+    uint64_t nextBlock = 0;
+    std::array<uint32_t, kBufferedWords> buffer{};
+    uint8_t cursor = kBufferedWords;
+};
+static_assert(std::is_trivially_copyable_v<RngStream>, "Streams live inside game states, which are cloned with memcpy");
+} // rng
+} // game_data
@@ -0,0 +1,136 @@
+#pragma once
+
+#include "game_data.hpp"
+#include "clearing_data.hpp"
+#include "rng_stream.hpp"
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+
+namespace game_data
+{
+namespace board_data
+{
+namespace suit_setup
+{
+
+namespace clearing_data = ::game_data::board_data::clearing_data;
+
+/*
+    Balanced suit setups for the boards whose clearings are not printed with a suit (Winter, Lake and Mountain).
+    Every setup puts each suit on exactly four clearings, so there are 12! / (4! 4! 4!) = 34650 of them.
+
+    24 Bits: Packed Suit Setup {
+        2 Bits: Suit of clearing i (0 = Mouse, 1 = Fox, 2 = Rabbit, 3 = unused)
+    } x 12 for each clearing
+*/
+using PackedSuitSetup = uint32_t;
+
+static constexpr uint8_t kTotalSuits = 3;
+static constexpr uint8_t kClearingsPerSuit = kTotalClearings / kTotalSuits;
+static constexpr uint8_t kSuitBits = 2;
+static_assert(kClearingsPerSuit * kTotalSuits == kTotalClearings, "Clearings must split evenly between the suits");
+static_assert(kSuitBits * kTotalClearings <= sizeof(PackedSuitSetup) * 8, "Packed suit setup must fit in its word");
+
+static constexpr std::array<uint32_t, kTotalClearings + 1> kFactorials{[]{
+    std::array<uint32_t, kTotalClearings + 1> result{};
+    result[0] = 1;
+    for (uint8_t i = 1; i <= kTotalClearings; ++i)
+        result[i] = result[i - 1] * i;
+    return result;
+}()};
+
+[[nodiscard]] constexpr uint32_t count_arrangements(const std::array<uint8_t, kTotalSuits> &remaining)
+{
+    return kFactorials[remaining[0] + remaining[1] + remaining[2]] /
+        (kFactorials[remaining[0]] * kFactorials[remaining[1]] * kFactorials[remaining[2]]);
+}
+
+static constexpr uint32_t kTotalSuitSetups = count_arrangements({kClearingsPerSuit, kClearingsPerSuit, kClearingsPerSuit});
+static_assert(kTotalSuitSetups == 34650);
+
+// Maps every rank in [0, kTotalSuitSetups) to a distinct balanced setup, walking the arrangements in lexicographic order
+[[nodiscard]] constexpr PackedSuitSetup unrank_suit_setup(uint32_t rank)
+{
+    std::array<uint8_t, kTotalSuits> remaining{kClearingsPerSuit, kClearingsPerSuit, kClearingsPerSuit};
+    PackedSuitSetup result = 0;
+
+    for (uint8_t clearing = 0; clearing < kTotalClearings; ++clearing) {
+        for (uint8_t suit = 0; suit < kTotalSuits; ++suit) {
+            if (remaining[suit] == 0)
+                continue;
+
+            --remaining[suit];
+            const uint32_t arrangements = count_arrangements(remaining);
+            if (rank < arrangements) {
+                result |= static_cast<PackedSuitSetup>(suit) << (clearing * kSuitBits);
+                break;
+            }
+            rank -= arrangements;
+            ++remaining[suit];
+        }
+    }
+    return result;
+}
+
+[[nodiscard]] constexpr clearing_data::ClearingType get_clearing_type(PackedSuitSetup setup, uint8_t clearingIndex)
+{
+    static_assert(
+        static_cast<uint8_t>(clearing_data::ClearingType::kFox) == static_cast<uint8_t>(clearing_data::ClearingType::kMouse) + 1 &&
+        static_cast<uint8_t>(clearing_data::ClearingType::kRabbit) == static_cast<uint8_t>(clearing_data::ClearingType::kMouse) + 2,
+        "Suit clearing types must be consecutive"
+    );
+    constexpr PackedSuitSetup kSuitMask = (1U << kSuitBits) - 1;
+    return static_cast<clearing_data::ClearingType>(
+        static_cast<uint8_t>(clearing_data::ClearingType::kMouse) + ((setup >> (clearingIndex * kSuitBits)) & kSuitMask));
+}
+
+// Produces a reproducible sequence of uniformly random balanced setups, one buffered Threefry word each. Another
+// word is only drawn when one lands in Lemire's rejection zone, about once every 10^5 setups
+class SuitSetupStream
+{
+public:
+    // Streams with the same seed and game id always produce the same setups
+    SuitSetupStream(uint64_t seed, uint32_t gameID);
+    explicit SuitSetupStream(const ::game_data::rng::RngStream &stream) : stream(stream) {}
+
+    [[nodiscard]] PackedSuitSetup next();
+
+private:
+    ::game_data::rng::RngStream stream;
+};
+
+// Ring of setups drawn ahead of time, so a burst of new games only pays for unranking in bulk on refill
+template <size_t capacity>
+class SuitSetupCache
+{
+public:
+    static_assert(capacity > 0, "Suit setup cache cannot be empty");
+
+    explicit SuitSetupCache(SuitSetupStream &stream) : stream(stream) { refill(); }
+
+    [[nodiscard]] inline PackedSuitSetup next()
+    {
+        [[unlikely]] if (readIndex == capacity)
+            refill();
+        return setups[readIndex++];
+    }
+
+    [[nodiscard]] inline size_t get_remaining() const { return capacity - readIndex; }
+
+    inline void refill()
+    {
+        for (PackedSuitSetup &setup : setups)
+            setup = stream.next();
+        readIndex = 0;
+    }
+
+private:
+    SuitSetupStream &stream;
+    std::array<PackedSuitSetup, capacity> setups;
+    size_t readIndex = 0;
+};
+} // suit_setup
+} // board_data
+} // game_data
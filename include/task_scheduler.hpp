@@ -0,0 +1,299 @@
+#pragma once
+
+#include "game_state.hpp"
+#include "rng_stream.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <expected>
+#include <memory>
+#include <new>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace game_data
+{
+namespace task
+{
+
+namespace game_state = ::game_data::game_state;
+namespace rng = ::game_data::rng;
+
+struct SchedulerError {
+    enum class Code : uint8_t {
+        kNoWorkers,
+        kAllocationFailed,
+        kUnknownError
+    } code;
+
+    static constexpr std::array<std::string_view, 3> kMessages = {
+        "Scheduler needs at least one worker",
+        "Could not allocate worker state",
+        "Unknown error"
+    };
+
+    [[nodiscard]] static std::string_view to_string(Code code) {
+        uint8_t idx = static_cast<uint8_t>(code);
+        [[likely]] if (idx < kMessages.size()) return kMessages[idx];
+        return kMessages.back();
+    }
+
+    [[nodiscard]] inline std::string_view message() const { return to_string(code); }
+};
+
+enum class Mode : uint8_t
+{
+    kWorkStealing,
+    // Every task runs inline on the calling thread in submission order, with worker 0's context. Replays are then
+    // identical whatever the worker count, at the price of all parallelism
+    kSerial
+};
+
+struct SchedulerConfig
+{
+    // Counts the thread that creates the scheduler, which is worker 0
+    uint8_t workerCount = 1;
+    // Pins worker i to core i modulo the core count. Worker 0 is left alone, it is the caller's thread
+    bool pinThreads = false;
+    Mode mode = Mode::kWorkStealing;
+    // Worker streams are keyed from this, see WorkerContext
+    uint64_t seed = 0;
+    size_t arenaBytes = size_t(1) << 20;
+};
+
+/*
+    Bump allocator owned by one worker. Only trivially destructible types, nothing is ever destroyed; memory comes
+    back all at once through reset or rewind
+*/
+class Arena
+{
+public:
+    [[nodiscard]] static std::expected<Arena, SchedulerError> create(size_t capacity);
+
+    Arena() = default;
+
+    // nullptr once the arena is full
+    template <typename T>
+    [[nodiscard]] inline T *allocate(size_t count = 1)
+    {
+        static_assert(std::is_trivially_destructible_v<T>, "Arena memory is never destroyed");
+        const size_t aligned = (used + alignof(T) - 1) & ~(alignof(T) - 1);
+        [[unlikely]] if (aligned > capacity || (capacity - aligned) / sizeof(T) < count)
+            return nullptr;
+
+        std::byte *address = storage.get() + aligned;
+        used = aligned + count * sizeof(T);
+        for (size_t index = 0; index < count; ++index)
+            ::new (static_cast<void *>(address + index * sizeof(T))) T;
+        return std::launder(reinterpret_cast<T *>(address));
+    }
+
+    // Frees everything allocated since get_used returned mark
+    inline void rewind(size_t mark) { used = mark < used ? mark : used; }
+    inline void reset() { used = 0; }
+
+    [[nodiscard]] inline size_t get_used() const { return used; }
+    [[nodiscard]] inline size_t get_capacity() const { return capacity; }
+
+private:
+    std::unique_ptr<std::byte[]> storage;
+    size_t capacity = 0;
+    size_t used = 0;
+};
+
+/*
+    What a task gets from the worker running it. rng is split off the scheduler seed's worker stream by worker
+    index, so it depends on which worker picked the task up; work that has to replay under stealing should split a
+    stream off its own index instead, the way playouts do
+*/
+struct WorkerContext
+{
+    uint8_t index;
+    ::game_data::rng::RngStream rng;
+    Arena arena;
+};
+
+// Type erased unit of work. Tasks are never copied once submitted, whoever submits one keeps it alive until it ran
+struct Task
+{
+    void (*execute)(Task &task, WorkerContext &worker);
+    // Decremented once the task finished, may be null
+    std::atomic<uint32_t> *pending;
+};
+
+/*
+    Chase-Lev deque with a fixed capacity. The owner pushes and pops at the bottom, any other worker steals from the
+    top. Memory orders follow Le, Pop, Cohen and Zappa Nardelli, "Correct and efficient work-stealing for weak
+    memory models"
+*/
+class WorkStealingDeque
+{
+public:
+    static constexpr uint32_t kCapacity = 1U << 12;
+    static_assert((kCapacity & (kCapacity - 1)) == 0, "Deque indices wrap with a mask");
+
+    // Owner only. False when full, the owner then runs the task itself
+    [[nodiscard]] bool push(Task *task);
+    // Owner only
+    [[nodiscard]] Task *pop();
+    // Any thread. nullptr when empty or when another thief won the race
+    [[nodiscard]] Task *steal();
+
+private:
+    static constexpr int64_t kMask = kCapacity - 1;
+
+    alignas(game_state::kCacheLineBytes) std::atomic<int64_t> top = 0;
+    alignas(game_state::kCacheLineBytes) std::atomic<int64_t> bottom = 0;
+    alignas(game_state::kCacheLineBytes) std::array<std::atomic<Task *>, kCapacity> slots{};
+};
+
+/*
+    Work stealing thread pool. Each worker owns a deque; a worker that runs dry steals from the others and sleeps
+    after a while without finding anything. Waiting on tasks never blocks: the waiter runs queued tasks until the
+    ones it waits for are done, so nested fork-join cannot deadlock.
+
+    Call it from the thread that created it or from inside its tasks
+*/
+class TaskScheduler
+{
+public:
+    [[nodiscard]] static std::expected<std::unique_ptr<TaskScheduler>, SchedulerError> create(const SchedulerConfig &config);
+
+    TaskScheduler(const TaskScheduler &) = delete;
+    TaskScheduler &operator=(const TaskScheduler &) = delete;
+    // Waits for detached tasks, then stops and joins the workers
+    ~TaskScheduler();
+
+    [[nodiscard]] inline uint8_t get_worker_count() const { return static_cast<uint8_t>(workers.size()); }
+    [[nodiscard]] inline Mode get_mode() const { return mode; }
+
+    /*
+        Calls body(index, worker) for every index in [begin, end). The range is halved until pieces are at most
+        grain long; the halves go to the deque for thieves while the caller keeps working on the front half, so
+        splitting stays lazy when nobody is idle. Returns once every index ran
+    */
+    template <typename Body>
+    void parallel_for(uint64_t begin, uint64_t end, uint64_t grain, Body &&body)
+    {
+        WorkerContext &context = get_current_worker().context;
+        if (mode == Mode::kSerial) {
+            for (uint64_t index = begin; index < end; ++index)
+                body(index, context);
+            return;
+        }
+        run_range(get_current_worker(), begin, end, grain == 0 ? 1 : grain, body);
+    }
+
+    // Runs body(index, worker) for index in [0, count) as separate tasks and waits for all of them
+    template <typename Body>
+    inline void fork_join(uint32_t count, Body &&body) { parallel_for(0, count, 1, std::forward<Body>(body)); }
+
+    // Queues body(worker) to run at some point. False if the task could not be allocated
+    template <typename Body>
+    [[nodiscard]] bool spawn(Body &&body)
+    {
+        using Callable = std::decay_t<Body>;
+        if (mode == Mode::kSerial) {
+            body(get_current_worker().context);
+            return true;
+        }
+
+        DetachedTask<Callable> *detached = new (std::nothrow) DetachedTask<Callable>{{&DetachedTask<Callable>::run, &detachedPending}, std::forward<Body>(body)};
+        [[unlikely]] if (detached == nullptr)
+            return false;
+        detachedPending.fetch_add(1, std::memory_order_relaxed);
+        submit(get_current_worker(), *detached);
+        return true;
+    }
+
+    // Runs queued tasks until every detached task finished
+    void wait_detached() { wait(get_current_worker(), detachedPending); }
+
+private:
+    struct alignas(game_state::kCacheLineBytes) Worker
+    {
+        WorkStealingDeque deque;
+        WorkerContext context;
+        TaskScheduler *owner;
+        // Next worker to try stealing from
+        uint8_t victim;
+        std::thread thread;
+    };
+
+    template <typename Body>
+    struct RangeTask : Task
+    {
+        TaskScheduler *scheduler;
+        Body *body;
+        uint64_t begin;
+        uint64_t end;
+        uint64_t grain;
+
+        static void run(Task &task, WorkerContext &worker)
+        {
+            RangeTask &range = static_cast<RangeTask &>(task);
+            TaskScheduler &scheduler = *range.scheduler;
+            scheduler.run_range(*scheduler.workers[worker.index], range.begin, range.end, range.grain, *range.body);
+        }
+    };
+
+    template <typename Callable>
+    struct DetachedTask : Task
+    {
+        Callable callable;
+
+        static void run(Task &task, WorkerContext &worker)
+        {
+            DetachedTask *detached = static_cast<DetachedTask *>(&task);
+            detached->callable(worker);
+            delete detached;
+        }
+    };
+
+    // Halvings of one range, enough to split any 64 bit range down to single indices
+    static constexpr uint8_t kMaxSplits = 64;
+    // Failed steal rounds before an idle worker goes to sleep
+    static constexpr uint32_t kSpinRounds = 64;
+
+    TaskScheduler(Mode mode) : mode(mode) {}
+
+    template <typename Body>
+    void run_range(Worker &self, uint64_t begin, uint64_t end, uint64_t grain, Body &body)
+    {
+        std::atomic<uint32_t> pending = 0;
+        std::array<RangeTask<Body>, kMaxSplits> halves;
+        uint8_t splits = 0;
+        while (end - begin > grain && splits < kMaxSplits) {
+            const uint64_t middle = begin + (end - begin) / 2;
+            halves[splits] = RangeTask<Body>{{&RangeTask<Body>::run, &pending}, this, &body, middle, end, grain};
+            pending.fetch_add(1, std::memory_order_relaxed);
+            submit(self, halves[splits++]);
+            end = middle;
+        }
+        for (uint64_t index = begin; index < end; ++index)
+            body(index, self.context);
+        wait(self, pending);
+    }
+
+    [[nodiscard]] Worker &get_current_worker();
+    void submit(Worker &self, Task &task);
+    void run_task(Worker &self, Task &task);
+    [[nodiscard]] bool try_run_one(Worker &self);
+    void wait(Worker &self, const std::atomic<uint32_t> &pending);
+    void worker_loop(Worker &self, bool pinThread);
+
+    Mode mode;
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::atomic<uint32_t> detachedPending = 0;
+    std::atomic<bool> isStopping = false;
+    // Sleeping workers wait for this to change, submit bumps it only while someone sleeps
+    alignas(game_state::kCacheLineBytes) std::atomic<uint32_t> wakeEpoch = 0;
+    std::atomic<uint32_t> sleeperCount = 0;
+};
+} // task
+} // game_data
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "game_data.hpp"
+#include "clearing_data.hpp"
+#include "board_data.hpp"
+
+#include <array>
+#include <cstdint>
+
+namespace game_data
+{
+namespace board_data
+{
+namespace transport_graph
+{
+
+namespace landmark_data = clearing_data::landmark_data;
+
+/*
+    Mask views of how pieces can travel besides roads: along rivers, and on the Lake map by ferry. The ferry links its
+    clearing with its river-adjacent clearings, so only the ferry's own row and its river neighbours' rows change
+    when it moves. Everything else is fixed per board and derived once here instead of per query
+*/
+class TransportGraph
+{
+public:
+    explicit TransportGraph(BoardType boardType, uint8_t ferryClearing = kNoClearing);
+
+    // Clearings a river flows through, grouped by connected stretch of river
+    [[nodiscard]] inline const ComponentList &get_river_components() const { return riverComponents; }
+    // The whole stretch of river the clearing lies on, 0 for a clearing no river touches
+    [[nodiscard]] inline ClearingMask get_river_component(uint8_t clearingIndex) const { return riverComponentOf[clearingIndex]; }
+    [[nodiscard]] inline bool share_river(uint8_t originIndex, uint8_t destinationIndex) const
+    {
+        return (riverComponentOf[originIndex] >> destinationIndex) & 1;
+    }
+
+    [[nodiscard]] inline uint8_t get_ferry_clearing() const { return ferryClearing; }
+    [[nodiscard]] inline const AdjacencyMasks &get_ferry_adjacency() const { return ferryAdjacency; }
+
+    // Roads plus the ferry, for factions that cannot use rivers on their own
+    [[nodiscard]] inline const AdjacencyMasks &get_land_and_ferry_adjacency() const { return landAndFerry; }
+    // Roads and rivers, for the Riverfolk or anything else treating rivers as paths
+    [[nodiscard]] inline const AdjacencyMasks &get_land_and_river_adjacency() const { return adjacency.any; }
+    // Roads, rivers and the ferry
+    [[nodiscard]] inline const AdjacencyMasks &get_all_transport_adjacency() const { return allTransport; }
+
+    // kNoClearing takes the ferry off the board
+    void move_ferry(uint8_t newFerryClearing);
+
+private:
+    const BoardAdjacency &adjacency;
+    ComponentList riverComponents;
+    std::array<ClearingMask, kTotalClearings> riverComponentOf{};
+
+    uint8_t ferryClearing = kNoClearing;
+    AdjacencyMasks ferryAdjacency{};
+    AdjacencyMasks landAndFerry;
+    AdjacencyMasks allTransport;
+
+    void set_ferry_edges(uint8_t clearingIndex, bool present);
+};
+
+template <BoardType boardType>
+[[nodiscard]] inline TransportGraph make_transport_graph(const Board<boardType> &board)
+{
+    return TransportGraph(boardType, board.get_landmark_clearing(landmark_data::Landmark::kFerry));
+}
+} // transport_graph
+} // board_data
+} // game_data
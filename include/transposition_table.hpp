@@ -0,0 +1,143 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <expected>
+#include <optional>
+#include <string_view>
+
+namespace game_data
+{
+namespace transposition_table
+{
+
+struct TableError {
+    enum class Code : uint8_t {
+        kTooSmall,
+        kAllocationFailed,
+        kUnknownError
+    } code;
+
+    static constexpr std::array<std::string_view, 3> kMessages = {
+        "Table needs room for at least one bucket",
+        "Could not allocate the table",
+        "Unknown error"
+    };
+
+    [[nodiscard]] static std::string_view to_string(Code code) {
+        uint8_t idx = static_cast<uint8_t>(code);
+        [[likely]] if (idx < kMessages.size()) return kMessages[idx];
+        return kMessages.back();
+    }
+
+    [[nodiscard]] inline std::string_view message() const { return to_string(code); }
+};
+
+// What a search knows about a position. bestAction is opaque to the table
+struct TableEntry
+{
+    uint32_t visits;
+    float value;
+    uint32_t bestAction;
+    uint8_t depth;
+};
+
+/*
+    Counters for one thread's probes and stores. Each search thread keeps its own and they are summed afterwards,
+    so counting never puts a shared cache line between the threads.
+
+    A collision is a probe whose bucket was full of other positions, or a store that evicted another position.
+    Torn reads from a racing store fail the key check and count as misses
+*/
+struct TableStats
+{
+    uint64_t probes = 0;
+    uint64_t hits = 0;
+    uint64_t probeCollisions = 0;
+    uint64_t stores = 0;
+    uint64_t replacements = 0;
+
+    [[nodiscard]] inline double get_hit_rate() const { return probes == 0 ? 0.0 : double(hits) / double(probes); }
+    [[nodiscard]] inline double get_collision_rate() const { return probes == 0 ? 0.0 : double(probeCollisions) / double(probes); }
+
+    inline TableStats &operator+=(const TableStats &other)
+    {
+        probes += other.probes;
+        hits += other.hits;
+        probeCollisions += other.probeCollisions;
+        stores += other.stores;
+        replacements += other.replacements;
+        return *this;
+    }
+};
+
+/*
+    Fixed size cache shared by every search thread, keyed by game_state::get_zobrist_key.
+
+    Entries are three atomic words written with relaxed stores and no lock. The check word holds the key XORed with
+    both data words, so a reader that sees half of one store and half of another gets a key that matches nothing and
+    treats it as a miss.
+
+    Each key maps to one cache line sized bucket. A store keeps the slot already holding its key, else takes an empty
+    slot, else evicts the slot with the lowest depth, counting kAgeWeight of depth per search since it was written
+*/
+class TranspositionTable
+{
+public:
+    static constexpr uint8_t kEntriesPerBucket = 2;
+    static constexpr uint8_t kAgeWeight = 8;
+
+    // Rounds sizeInBytes down to a power of two buckets. Huge pages are a hint and fall back to normal pages
+    [[nodiscard]] static std::expected<TranspositionTable, TableError> create(size_t sizeInBytes, bool useHugePages = true);
+
+    TranspositionTable(TranspositionTable &&other) noexcept;
+    TranspositionTable &operator=(TranspositionTable &&other) noexcept;
+    TranspositionTable(const TranspositionTable &) = delete;
+    TranspositionTable &operator=(const TranspositionTable &) = delete;
+    ~TranspositionTable();
+
+    [[nodiscard]] std::optional<TableEntry> probe(uint64_t key, TableStats &stats) const;
+    void store(uint64_t key, const TableEntry &entry, TableStats &stats);
+
+    // Pulls key's bucket into cache, for when the key is known a while before the probe
+    inline void prefetch(uint64_t key) const { __builtin_prefetch(&buckets[key & bucketMask]); }
+
+    // Ages every entry by one search. Only the thread driving the searches calls this, between searches
+    inline void new_search() { generation = static_cast<uint8_t>(generation + 1); }
+
+    // Empties every entry. Not safe while other threads use the table
+    void clear();
+
+    [[nodiscard]] inline size_t get_bucket_count() const { return bucketMask + 1; }
+    [[nodiscard]] inline bool is_using_huge_pages() const { return isUsingHugePages; }
+
+    // Share of the slots written in the current search, sampled from the first buckets
+    [[nodiscard]] double get_fill_rate() const;
+
+private:
+    struct Entry
+    {
+        std::atomic<uint64_t> check;
+        std::atomic<uint64_t> stats;
+        std::atomic<uint64_t> info;
+    };
+
+    // The spare bytes keep every bucket on its own cache line
+    struct alignas(64) Bucket
+    {
+        std::array<Entry, kEntriesPerBucket> entries;
+    };
+    static_assert(sizeof(Bucket) == 64, "A bucket has to fill exactly one cache line");
+
+    TranspositionTable(Bucket *buckets, size_t bucketCount, size_t allocationSize, bool isUsingHugePages);
+
+    Bucket *buckets = nullptr;
+    size_t bucketMask = 0;
+    size_t allocationSize = 0;
+    bool isUsingHugePages = false;
+    uint8_t generation = 0;
+};
+} // transposition_table
+} // game_data
@@ -0,0 +1,197 @@
+#pragma once
+
+#include "board_data.hpp"
+#include "game_state.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <expected>
+#include <functional>
+#include <memory>
+#include <string_view>
+#include <type_traits>
+
+#ifndef NDEBUG
+#include <cassert>
+#include <vector>
+#endif
+
+namespace game_data
+{
+namespace undo_stack
+{
+
+namespace board_data = ::game_data::board_data;
+namespace game_state = ::game_data::game_state;
+
+// Deepest line a search applies before unwinding, and the words all of those actions may change together
+static constexpr size_t kMaxUndoActions = 256;
+static constexpr size_t kMaxUndoEntries = 4096;
+
+struct UndoError {
+    enum class Code : uint8_t {
+        kTooManyActions,
+        kTooManyEntries,
+        kComponentOutsideState,
+        kNoActionToUndo,
+        kUnknownError
+    } code;
+
+    static constexpr std::array<std::string_view, 5> kMessages = {
+        "Undo stack cannot hold another action",
+        "Undo stack cannot hold the entries of this change",
+        "Component does not lie inside the state",
+        "No action to undo",
+        "Unknown error"
+    };
+
+    [[nodiscard]] static std::string_view to_string(Code code) {
+        uint8_t idx = static_cast<uint8_t>(code);
+        [[likely]] if (idx < kMessages.size()) return kMessages[idx];
+        return kMessages.back();
+    }
+
+    [[nodiscard]] inline std::string_view message() const { return to_string(code); }
+};
+
+// Up to one word of a state's bytes as they were before an action changed them
+struct UndoEntry
+{
+    uint16_t offset;
+    uint8_t size;
+    uint64_t oldBits;
+};
+
+/*
+    Applies actions to a flat state in place and reverts them exactly. Every change goes through modify, which diffs
+    the touched component word by word afterwards and keeps only the words that changed, so a typical action costs a
+    few entries instead of a copy of the whole state.
+
+    Debug builds also keep a full snapshot per action and check every unmake against it
+*/
+template <typename State, size_t maxEntries, size_t maxActions>
+class UndoStack
+{
+public:
+    static_assert(std::is_trivially_copyable_v<State>, "Only flat states can be restored byte for byte");
+    static_assert(sizeof(State) <= UINT16_MAX, "Entry offsets are 16 bits");
+
+    // Starts a new action, every modify until the next begin_action is undone together
+    [[nodiscard]] inline std::expected<void, UndoError> begin_action([[maybe_unused]] const State &state)
+    {
+        [[unlikely]] if (actionCount == maxActions)
+            return std::unexpected(UndoError{UndoError::Code::kTooManyActions});
+
+        actionStarts[actionCount++] = entryCount;
+#ifndef NDEBUG
+        snapshots.push_back(state);
+#endif
+        return {};
+    }
+
+    /*
+        Calls function(component) and records the words of component it changed. component has to be part of state.
+        The result of function is passed through; it is only called if the stack has room for every word of component
+    */
+    template <typename Component, typename Function>
+    [[nodiscard]] inline auto modify(State &state, Component &component, Function &&function)
+        -> std::expected<std::invoke_result_t<Function, Component &>, UndoError>
+    {
+        static_assert(std::is_trivially_copyable_v<Component>, "Only flat components can be diffed");
+        constexpr size_t kWords = (sizeof(Component) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+        const std::byte *stateBytes = reinterpret_cast<const std::byte *>(std::addressof(state));
+        const std::byte *componentBytes = reinterpret_cast<const std::byte *>(std::addressof(component));
+        [[unlikely]] if (componentBytes < stateBytes || componentBytes + sizeof(Component) > stateBytes + sizeof(State))
+            return std::unexpected(UndoError{UndoError::Code::kComponentOutsideState});
+
+        [[unlikely]] if (entryCount + kWords > maxEntries)
+            return std::unexpected(UndoError{UndoError::Code::kTooManyEntries});
+
+        std::array<std::byte, sizeof(Component)> before;
+        std::memcpy(before.data(), componentBytes, sizeof(Component));
+
+        using Result = std::invoke_result_t<Function, Component &>;
+        if constexpr (std::is_void_v<Result>) {
+            std::invoke(function, component);
+            record_changes(static_cast<uint16_t>(componentBytes - stateBytes), before.data(), componentBytes, sizeof(Component));
+            return {};
+        } else {
+            Result result = std::invoke(function, component);
+            record_changes(static_cast<uint16_t>(componentBytes - stateBytes), before.data(), componentBytes, sizeof(Component));
+            return result;
+        }
+    }
+
+    // Writes a plain field of the state, such as the turn or the phase
+    template <typename Field>
+    [[nodiscard]] inline std::expected<void, UndoError> set(State &state, Field &field, const Field &newValue)
+    {
+        return modify(state, field, [&newValue](Field &value) { value = newValue; });
+    }
+
+    // Restores every word the last action changed, newest first
+    [[nodiscard]] inline std::expected<void, UndoError> unmake(State &state)
+    {
+        [[unlikely]] if (actionCount == 0)
+            return std::unexpected(UndoError{UndoError::Code::kNoActionToUndo});
+
+        std::byte *stateBytes = reinterpret_cast<std::byte *>(std::addressof(state));
+        const size_t actionStart = actionStarts[--actionCount];
+        while (entryCount > actionStart) {
+            const UndoEntry &entry = entries[--entryCount];
+            std::memcpy(stateBytes + entry.offset, &entry.oldBits, entry.size);
+        }
+
+#ifndef NDEBUG
+        assert(std::memcmp(&snapshots.back(), &state, sizeof(State)) == 0 && "unmake did not restore the state");
+        snapshots.pop_back();
+#endif
+        return {};
+    }
+
+    [[nodiscard]] inline size_t get_action_count() const { return actionCount; }
+    [[nodiscard]] inline size_t get_entry_count() const { return entryCount; }
+
+    inline void clear()
+    {
+        actionCount = 0;
+        entryCount = 0;
+#ifndef NDEBUG
+        snapshots.clear();
+#endif
+    }
+
+private:
+    inline void record_changes(uint16_t offset, const std::byte *before, const std::byte *after, size_t size)
+    {
+        for (size_t start = 0; start < size; start += sizeof(uint64_t)) {
+            const uint8_t wordSize = static_cast<uint8_t>(std::min(sizeof(uint64_t), size - start));
+            if (std::memcmp(before + start, after + start, wordSize) == 0)
+                continue;
+
+            UndoEntry &entry = entries[entryCount++];
+            entry.offset = static_cast<uint16_t>(offset + start);
+            entry.size = wordSize;
+            entry.oldBits = 0;
+            std::memcpy(&entry.oldBits, before + start, wordSize);
+        }
+    }
+
+    std::array<UndoEntry, maxEntries> entries;
+    std::array<size_t, maxActions> actionStarts;
+    size_t entryCount = 0;
+    size_t actionCount = 0;
+
+#ifndef NDEBUG
+    std::vector<State> snapshots;
+#endif
+};
+
+template <board_data::BoardType boardType>
+using GameUndoStack = UndoStack<game_state::GameState<boardType>, kMaxUndoEntries, kMaxUndoActions>;
+} // undo_stack
+} // game_data
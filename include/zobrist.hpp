@@ -0,0 +1,158 @@
+#pragma once
+
+#include "game_data.hpp"
+#include "card_data.hpp"
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <span>
+
+namespace game_data
+{
+namespace zobrist
+{
+
+namespace card_data = ::game_data::card_data;
+
+/*
+    Zobrist keys for every piece of state a search can change. Each component (clearing, pile, faction) keeps its own
+    running key and updates it inside its packed setters. Board pieces are XORed in and out. Cards are added and
+    subtracted instead, so a pile or hand keys as the multiset it holds and repeated copies of a card do not cancel.
+
+    Board pieces are keyed by clearing, field and value, so no two clearings share a key. Cards and scores have a
+    second set of tables keyed by who holds them, for the game state's own running key: it is the sum of the clearing
+    keys, the held card and seat score keys and the turn keys, updated alongside the components and never rebuilt
+    during play.
+
+    Index 0 of every count and score table is 0, so empty fields cost nothing and a freshly built component keys to 0
+*/
+static constexpr uint64_t kZobristSeed = 0x526F6F74'5A6F6272ULL;
+
+static constexpr uint8_t kClearings = 12;
+static constexpr uint8_t kPawnFields = 12;
+static constexpr uint8_t kPawnValues = 32;
+static constexpr uint8_t kTokenFields = 21;
+// Wood is the widest token field at 4 bits
+static constexpr uint8_t kTokenValues = 16;
+static constexpr uint8_t kBuildingSlots = 4;
+static constexpr uint8_t kBuildingValues = 32;
+static constexpr uint8_t kScoreValues = 32;
+static constexpr uint8_t kCardValues = 1U << card_data::kCardIDBits;
+static constexpr uint8_t kMaxSeats = 6;
+static constexpr uint8_t kFactions = 11;
+static constexpr uint8_t kPhases = 5;
+
+// Every table draws from its own stream, so growing one table never shifts the keys of another
+enum class KeyStream : uint8_t
+{
+    kPawn,
+    kToken,
+    kHiddenPlotToggle,
+    kBuilding,
+    kRazed,
+    kClosedPath,
+    kCard,
+    kScore,
+    kSeatedFaction,
+    kCurrentPlayer,
+    kPhase,
+    kTurnState,
+    kHeldCard,
+    kSeatScore
+};
+
+[[nodiscard]] constexpr uint64_t make_key(KeyStream stream, uint64_t index)
+{
+    return ::game_data::hash_mix(kZobristSeed ^ ::game_data::hash_mix((uint64_t(stream) << 56) ^ index));
+}
+
+template <size_t fields, size_t values, bool zeroIsEmpty>
+[[nodiscard]] consteval std::array<std::array<uint64_t, values>, fields> make_key_table(KeyStream stream)
+{
+    std::array<std::array<uint64_t, values>, fields> result{};
+    for (size_t field = 0; field < fields; ++field)
+        for (size_t value = (zeroIsEmpty ? 1 : 0); value < values; ++value)
+            result[field][value] = make_key(stream, field * values + value);
+    return result;
+}
+
+template <size_t values, bool zeroIsEmpty>
+[[nodiscard]] consteval std::array<uint64_t, values> make_key_row(KeyStream stream)
+{
+    return make_key_table<1, values, zeroIsEmpty>(stream)[0];
+}
+
+template <size_t fields, size_t values, bool zeroIsEmpty>
+[[nodiscard]] consteval std::array<std::array<std::array<uint64_t, values>, fields>, kClearings> make_clearing_key_table(KeyStream stream)
+{
+    std::array<std::array<std::array<uint64_t, values>, fields>, kClearings> result{};
+    for (size_t clearing = 0; clearing < kClearings; ++clearing)
+        for (size_t field = 0; field < fields; ++field)
+            for (size_t value = (zeroIsEmpty ? 1 : 0); value < values; ++value)
+                result[clearing][field][value] = make_key(stream, (clearing * fields + field) * values + value);
+    return result;
+}
+
+// kPawnKeys[clearing][field][count], fields as laid out by clearing_data::kPawnDataInfoField
+static constexpr auto kPawnKeys = make_clearing_key_table<kPawnFields, kPawnValues, true>(KeyStream::kPawn);
+// kTokenKeys[clearing][token][count]
+static constexpr auto kTokenKeys = make_clearing_key_table<kTokenFields, kTokenValues, true>(KeyStream::kToken);
+static constexpr auto kHiddenPlotToggleKeys = make_key_row<kClearings, false>(KeyStream::kHiddenPlotToggle);
+// kBuildingKeys[clearing][slot][building]. A ruin is building 0, so only occupied slots are keyed
+static constexpr auto kBuildingKeys = make_clearing_key_table<kBuildingSlots, kBuildingValues, false>(KeyStream::kBuilding);
+static constexpr auto kRazedKeys = make_key_row<kClearings, false>(KeyStream::kRazed);
+
+static constexpr auto kCardKeys = make_key_row<kCardValues, false>(KeyStream::kCard);
+static constexpr auto kScoreKeys = make_key_row<kScoreValues, true>(KeyStream::kScore);
+
+// kSeatedFactionKeys[seat][faction], advanced setup fills seats in during play
+static constexpr auto kSeatedFactionKeys = make_key_table<kMaxSeats, kFactions, false>(KeyStream::kSeatedFaction);
+static constexpr auto kCurrentPlayerKeys = make_key_row<kMaxSeats, false>(KeyStream::kCurrentPlayer);
+static constexpr auto kPhaseKeys = make_key_row<kPhases, false>(KeyStream::kPhase);
+
+// Who holds a card, for the game state's key: the piles, then one holder per seat
+enum class CardHolder : uint8_t
+{
+    kDeck,
+    kDiscard,
+    kFirstSeat
+};
+
+static constexpr uint8_t kCardHolders = static_cast<uint8_t>(CardHolder::kFirstSeat) + kMaxSeats;
+
+// kHeldCardKeys[holder][card] and kSeatScoreKeys[seat][score]
+static constexpr auto kHeldCardKeys = make_key_table<kCardHolders, kCardValues, false>(KeyStream::kHeldCard);
+static constexpr auto kSeatScoreKeys = make_key_table<kMaxSeats, kScoreValues, true>(KeyStream::kSeatScore);
+
+[[nodiscard]] inline constexpr CardHolder get_seat_holder(uint8_t seat)
+{
+    return static_cast<CardHolder>(static_cast<uint8_t>(CardHolder::kFirstSeat) + seat);
+}
+
+[[nodiscard]] inline constexpr uint64_t get_held_card_key(CardHolder holder, card_data::CardID card)
+{
+    return kHeldCardKeys[static_cast<uint8_t>(holder)][static_cast<uint8_t>(card) & (kCardValues - 1)];
+}
+
+[[nodiscard]] inline constexpr uint64_t get_card_key(card_data::CardID card)
+{
+    return kCardKeys[static_cast<uint8_t>(card) & (kCardValues - 1)];
+}
+
+// Sum of the card keys, the same for any order of the same cards
+[[nodiscard]] inline constexpr uint64_t get_cards_key(std::span<const card_data::CardID> cards)
+{
+    uint64_t key = 0;
+    for (const card_data::CardID card : cards)
+        key += get_card_key(card);
+    return key;
+}
+
+// Steps inside a phase are few and change once per action, so they are keyed whole instead of per field
+[[nodiscard]] inline constexpr uint64_t get_turn_state_key(uint32_t turnStateWord)
+{
+    return make_key(KeyStream::kTurnState, turnStateWord);
+}
+} // zobrist
+} // game_data
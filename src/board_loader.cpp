@@ -0,0 +1,602 @@
+#include "../include/board_loader.hpp"
+
+#include <cstdio>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <system_error>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace game_data
+{
+namespace board_data
+{
+namespace board_loader
+{
+
+namespace
+{
+
+using Code = LoaderError::Code;
+
+struct JsonValue
+{
+    enum class Type : uint8_t {
+        kNull,
+        kBool,
+        kNumber,
+        kString,
+        kArray,
+        kObject
+    } type = Type::kNull;
+
+    bool boolean = false;
+    bool isInteger = false;
+    int64_t number = 0;
+    // Raw text between the quotes, escapes are left in place
+    std::string_view string;
+    std::vector<JsonValue> items;
+    std::vector<std::string_view> keys;
+
+    [[nodiscard]] const JsonValue *find(std::string_view key) const
+    {
+        for (size_t i = 0; i < keys.size(); ++i)
+            if (keys[i] == key)
+                return &items[i];
+        return nullptr;
+    }
+};
+
+// Recursive descent over the subset of JSON the board files need. Fractions and exponents are accepted but mark the
+// number as non-integral, which every field the loader reads rejects
+class JsonParser
+{
+public:
+    explicit JsonParser(std::string_view text) : text(text) {}
+
+    [[nodiscard]] std::expected<JsonValue, LoaderError> parse_document()
+    {
+        auto value = parse_value(0);
+        if (!value.has_value())
+            return value;
+
+        skip_whitespace();
+        [[unlikely]] if (position != text.size())
+            return std::unexpected(LoaderError{Code::kUnexpectedCharacter});
+        return value;
+    }
+
+private:
+    static constexpr uint8_t kMaxDepth = 32;
+
+    std::string_view text;
+    size_t position = 0;
+
+    inline void skip_whitespace()
+    {
+        while (position < text.size() && (text[position] == ' ' || text[position] == '\n' || text[position] == '\r' || text[position] == '\t'))
+            ++position;
+    }
+
+    [[nodiscard]] inline bool consume(char expected)
+    {
+        skip_whitespace();
+        if (position < text.size() && text[position] == expected) {
+            ++position;
+            return true;
+        }
+        return false;
+    }
+
+    [[nodiscard]] inline bool consume_literal(std::string_view literal)
+    {
+        if (text.substr(position, literal.size()) != literal)
+            return false;
+        position += literal.size();
+        return true;
+    }
+
+    [[nodiscard]] std::expected<JsonValue, LoaderError> parse_value(uint8_t depth)
+    {
+        [[unlikely]] if (depth > kMaxDepth)
+            return std::unexpected(LoaderError{Code::kNestingTooDeep});
+
+        skip_whitespace();
+        [[unlikely]] if (position >= text.size())
+            return std::unexpected(LoaderError{Code::kUnexpectedEndOfInput});
+
+        JsonValue value;
+        switch (text[position]) {
+            case '{': return parse_object(depth);
+            case '[': return parse_array(depth);
+            case '"': {
+                auto string = parse_string();
+                if (!string.has_value())
+                    return std::unexpected(string.error());
+                value.type = JsonValue::Type::kString;
+                value.string = string.value();
+                return value;
+            }
+            case 't':
+            case 'f':
+                value.type = JsonValue::Type::kBool;
+                value.boolean = text[position] == 't';
+                [[unlikely]] if (!consume_literal(value.boolean ? "true" : "false"))
+                    return std::unexpected(LoaderError{Code::kUnexpectedCharacter});
+                return value;
+            case 'n':
+                [[unlikely]] if (!consume_literal("null"))
+                    return std::unexpected(LoaderError{Code::kUnexpectedCharacter});
+                return value;
+            default:
+                return parse_number();
+        }
+    }
+
+    [[nodiscard]] std::expected<std::string_view, LoaderError> parse_string()
+    {
+        ++position; // opening quote
+        const size_t begin = position;
+        while (position < text.size() && text[position] != '"')
+            position += (text[position] == '\\') ? 2 : 1;
+
+        [[unlikely]] if (position >= text.size())
+            return std::unexpected(LoaderError{Code::kUnexpectedEndOfInput});
+
+        const std::string_view result = text.substr(begin, position - begin);
+        ++position; // closing quote
+        return result;
+    }
+
+    [[nodiscard]] std::expected<JsonValue, LoaderError> parse_number()
+    {
+        JsonValue value;
+        value.type = JsonValue::Type::kNumber;
+        value.isInteger = true;
+
+        const bool negative = text[position] == '-';
+        if (negative)
+            ++position;
+
+        const size_t digitsBegin = position;
+        // Saturates long before overflowing, any index that large is out of range anyway
+        constexpr int64_t kSaturation = int64_t(1) << 40;
+        while (position < text.size() && text[position] >= '0' && text[position] <= '9') {
+            value.number = std::min(value.number * 10 + (text[position] - '0'), kSaturation);
+            ++position;
+        }
+        [[unlikely]] if (position == digitsBegin)
+            return std::unexpected(LoaderError{Code::kUnexpectedCharacter});
+
+        while (position < text.size() && (text[position] == '.' || text[position] == 'e' || text[position] == 'E' ||
+                text[position] == '+' || text[position] == '-' || (text[position] >= '0' && text[position] <= '9'))) {
+            value.isInteger = false;
+            ++position;
+        }
+
+        if (negative)
+            value.number = -value.number;
+        return value;
+    }
+
+    [[nodiscard]] std::expected<JsonValue, LoaderError> parse_array(uint8_t depth)
+    {
+        ++position; // [
+        JsonValue value;
+        value.type = JsonValue::Type::kArray;
+        if (consume(']'))
+            return value;
+
+        do {
+            auto item = parse_value(depth + 1);
+            if (!item.has_value())
+                return item;
+            value.items.push_back(std::move(item.value()));
+        } while (consume(','));
+
+        [[unlikely]] if (!consume(']'))
+            return std::unexpected(LoaderError{position >= text.size() ? Code::kUnexpectedEndOfInput : Code::kUnexpectedCharacter});
+        return value;
+    }
+
+    [[nodiscard]] std::expected<JsonValue, LoaderError> parse_object(uint8_t depth)
+    {
+        ++position; // {
+        JsonValue value;
+        value.type = JsonValue::Type::kObject;
+        if (consume('}'))
+            return value;
+
+        do {
+            skip_whitespace();
+            [[unlikely]] if (position >= text.size() || text[position] != '"')
+                return std::unexpected(LoaderError{position >= text.size() ? Code::kUnexpectedEndOfInput : Code::kUnexpectedCharacter});
+
+            auto key = parse_string();
+            if (!key.has_value())
+                return std::unexpected(key.error());
+
+            [[unlikely]] if (!consume(':'))
+                return std::unexpected(LoaderError{Code::kUnexpectedCharacter});
+
+            auto item = parse_value(depth + 1);
+            if (!item.has_value())
+                return item;
+            value.keys.push_back(key.value());
+            value.items.push_back(std::move(item.value()));
+        } while (consume(','));
+
+        [[unlikely]] if (!consume('}'))
+            return std::unexpected(LoaderError{position >= text.size() ? Code::kUnexpectedEndOfInput : Code::kUnexpectedCharacter});
+        return value;
+    }
+};
+
+[[nodiscard]] std::expected<const JsonValue *, LoaderError> get_field(const JsonValue &object, std::string_view key, JsonValue::Type type)
+{
+    const JsonValue *field = object.find(key);
+    [[unlikely]] if (field == nullptr)
+        return std::unexpected(LoaderError{Code::kMissingField});
+    [[unlikely]] if (field->type != type)
+        return std::unexpected(LoaderError{Code::kWrongFieldType});
+    return field;
+}
+
+// Converts a 1 based index from the file to a 0 based one below limit
+[[nodiscard]] std::expected<uint8_t, LoaderError> get_index(const JsonValue &value, uint8_t limit)
+{
+    [[unlikely]] if (value.type != JsonValue::Type::kNumber || !value.isInteger)
+        return std::unexpected(LoaderError{Code::kWrongFieldType});
+    [[unlikely]] if (value.number < 1 || value.number > limit)
+        return std::unexpected(LoaderError{Code::kIndexOutOfRange});
+    return static_cast<uint8_t>(value.number - 1);
+}
+
+[[nodiscard]] std::expected<clearing_data::ClearingType, LoaderError> get_clearing_type(std::string_view name)
+{
+    using enum clearing_data::ClearingType;
+    if (name == "random") return kRandom;
+    if (name == "mouse") return kMouse;
+    if (name == "fox") return kFox;
+    if (name == "rabbit") return kRabbit;
+    return std::unexpected(LoaderError{Code::kUnknownClearingType});
+}
+
+[[nodiscard]] std::expected<clearing_data::landmark_data::Landmark, LoaderError> get_landmark(std::string_view name)
+{
+    using enum clearing_data::landmark_data::Landmark;
+    if (name == "blackMarket") return kBlackMarket;
+    if (name == "ferry") return kFerry;
+    if (name == "legendaryForge") return kLegendaryForge;
+    if (name == "lostCity") return kLostCity;
+    if (name == "tower") return kTower;
+    return std::unexpected(LoaderError{Code::kUnknownLandmark});
+}
+
+[[nodiscard]] std::expected<void, LoaderError> parse_clearing(const JsonValue &clearing, uint8_t clearingIndex, BoardDescription &result)
+{
+    [[unlikely]] if (clearing.type != JsonValue::Type::kObject)
+        return std::unexpected(LoaderError{Code::kWrongFieldType});
+
+    const auto typeField = get_field(clearing, "clearingType", JsonValue::Type::kString);
+    if (!typeField.has_value())
+        return std::unexpected(typeField.error());
+    const auto clearingType = get_clearing_type(typeField.value()->string);
+    if (!clearingType.has_value())
+        return std::unexpected(clearingType.error());
+    result.clearingTypes[clearingIndex] = clearingType.value();
+
+    const auto slotCount = get_field(clearing, "buildingSlots", JsonValue::Type::kNumber);
+    if (!slotCount.has_value())
+        return std::unexpected(slotCount.error());
+    [[unlikely]] if (!slotCount.value()->isInteger || slotCount.value()->number < 0 || slotCount.value()->number > UINT8_MAX)
+        return std::unexpected(LoaderError{Code::kWrongFieldType});
+    result.buildingSlotCounts[clearingIndex] = static_cast<uint8_t>(slotCount.value()->number);
+
+    const auto hasRuin = get_field(clearing, "startingRuin", JsonValue::Type::kBool);
+    if (!hasRuin.has_value())
+        return std::unexpected(hasRuin.error());
+    result.ruinsMask |= static_cast<ClearingMask>(hasRuin.value()->boolean) << clearingIndex;
+
+    const auto connections = get_field(clearing, "clearingConnections", JsonValue::Type::kArray);
+    if (!connections.has_value())
+        return std::unexpected(connections.error());
+    for (const JsonValue &connection : connections.value()->items) {
+        [[unlikely]] if (connection.type != JsonValue::Type::kObject)
+            return std::unexpected(LoaderError{Code::kWrongFieldType});
+
+        const JsonValue *indexField = connection.find("index");
+        [[unlikely]] if (indexField == nullptr)
+            return std::unexpected(LoaderError{Code::kMissingField});
+        const auto destination = get_index(*indexField, kTotalClearings);
+        if (!destination.has_value())
+            return std::unexpected(destination.error());
+        [[unlikely]] if (destination.value() == clearingIndex)
+            return std::unexpected(LoaderError{Code::kSelfConnection});
+
+        const auto connectionType = get_field(connection, "type", JsonValue::Type::kString);
+        if (!connectionType.has_value())
+            return std::unexpected(connectionType.error());
+
+        const ClearingMask destinationBit = static_cast<ClearingMask>(1U << destination.value());
+        const std::string_view typeName = connectionType.value()->string;
+        if (typeName == "normal")
+            result.adjacency.land[clearingIndex] |= destinationBit;
+        else if (typeName == "water")
+            result.adjacency.water[clearingIndex] |= destinationBit;
+        else if (typeName == "blocked")
+            result.closedPaths[clearingIndex] |= destinationBit;
+        else [[unlikely]]
+            return std::unexpected(LoaderError{Code::kUnknownConnectionType});
+    }
+    result.adjacency.any[clearingIndex] = result.adjacency.land[clearingIndex] | result.adjacency.water[clearingIndex];
+
+    const auto forests = get_field(clearing, "forestConnections", JsonValue::Type::kArray);
+    if (!forests.has_value())
+        return std::unexpected(forests.error());
+    for (const JsonValue &forest : forests.value()->items) {
+        const auto forestIndex = get_index(forest, kTotalForests);
+        if (!forestIndex.has_value())
+            return std::unexpected(forestIndex.error());
+        result.forests.clearingForests[clearingIndex] |= static_cast<ForestMask>(1U << forestIndex.value());
+    }
+
+    const auto landmarks = get_field(clearing, "startingLandmarks", JsonValue::Type::kArray);
+    if (!landmarks.has_value())
+        return std::unexpected(landmarks.error());
+    for (const JsonValue &landmarkName : landmarks.value()->items) {
+        [[unlikely]] if (landmarkName.type != JsonValue::Type::kString)
+            return std::unexpected(LoaderError{Code::kWrongFieldType});
+        const auto landmark = get_landmark(landmarkName.string);
+        if (!landmark.has_value())
+            return std::unexpected(landmark.error());
+        result.landmarkBits[clearingIndex] |= clearing_data::landmark_data::get_landmark_bit(landmark.value());
+    }
+    return {};
+}
+
+[[nodiscard]] std::expected<std::string, LoaderError> read_file(const std::filesystem::path &path)
+{
+    std::FILE *file = std::fopen(path.c_str(), "rb");
+    [[unlikely]] if (file == nullptr)
+        return std::unexpected(LoaderError{Code::kFileOpenFailed});
+
+    std::string result;
+    char buffer[4096];
+    size_t bytesRead;
+    while ((bytesRead = std::fread(buffer, 1, sizeof(buffer), file)) > 0)
+        result.append(buffer, bytesRead);
+
+    const bool failed = std::ferror(file) != 0;
+    std::fclose(file);
+    [[unlikely]] if (failed)
+        return std::unexpected(LoaderError{Code::kFileReadFailed});
+    return result;
+}
+} // namespace
+
+[[nodiscard]] std::expected<BoardDescription, LoaderError> parse_board_description(std::string_view json)
+{
+    const auto document = JsonParser(json).parse_document();
+    if (!document.has_value())
+        return std::unexpected(document.error());
+
+    [[unlikely]] if (document.value().type != JsonValue::Type::kObject)
+        return std::unexpected(LoaderError{Code::kWrongFieldType});
+
+    BoardDescription result{};
+
+    const auto clearings = get_field(document.value(), "Clearings", JsonValue::Type::kArray);
+    if (!clearings.has_value())
+        return std::unexpected(clearings.error());
+    [[unlikely]] if (clearings.value()->items.size() != kTotalClearings)
+        return std::unexpected(LoaderError{Code::kWrongClearingCount});
+
+    for (uint8_t clearingIndex = 0; clearingIndex < kTotalClearings; ++clearingIndex) {
+        const auto parsed = parse_clearing(clearings.value()->items[clearingIndex], clearingIndex, result);
+        if (!parsed.has_value())
+            return std::unexpected(parsed.error());
+    }
+
+    const auto forests = get_field(document.value(), "Forests", JsonValue::Type::kArray);
+    if (!forests.has_value())
+        return std::unexpected(forests.error());
+    [[unlikely]] if (forests.value()->items.size() > kTotalForests)
+        return std::unexpected(LoaderError{Code::kTooManyForests});
+
+    result.totalForests = static_cast<uint8_t>(forests.value()->items.size());
+    for (uint8_t forestIndex = 0; forestIndex < result.totalForests; ++forestIndex) {
+        const JsonValue &forest = forests.value()->items[forestIndex];
+        [[unlikely]] if (forest.type != JsonValue::Type::kObject)
+            return std::unexpected(LoaderError{Code::kWrongFieldType});
+
+        const auto bordering = get_field(forest, "clearingConnections", JsonValue::Type::kArray);
+        if (!bordering.has_value())
+            return std::unexpected(bordering.error());
+        for (const JsonValue &clearing : bordering.value()->items) {
+            const auto clearingIndex = get_index(clearing, kTotalClearings);
+            if (!clearingIndex.has_value())
+                return std::unexpected(clearingIndex.error());
+            result.forests.forestClearings[forestIndex] |= static_cast<ClearingMask>(1U << clearingIndex.value());
+        }
+    }
+
+    result.paths[static_cast<uint8_t>(PathGraph::kLand)] = compute_path_table(result.adjacency.land);
+    result.paths[static_cast<uint8_t>(PathGraph::kLandAndWater)] = compute_path_table(result.adjacency.any);
+    result.paths[static_cast<uint8_t>(PathGraph::kWater)] = compute_path_table(result.adjacency.water);
+    return result;
+}
+
+[[nodiscard]] std::expected<void, LoaderError> validate_board_description(const BoardDescription &description)
+{
+    for (uint8_t origin = 0; origin < kTotalClearings; ++origin) {
+        for (uint8_t destination = 0; destination < kTotalClearings; ++destination) {
+            const auto listedBothWays = [origin, destination](const AdjacencyMasks &masks) {
+                return ((masks[origin] >> destination) & 1) == ((masks[destination] >> origin) & 1);
+            };
+            [[unlikely]] if (!listedBothWays(description.adjacency.land) || !listedBothWays(description.adjacency.water) || !listedBothWays(description.closedPaths))
+                return std::unexpected(LoaderError{Code::kAsymmetricConnection});
+        }
+
+        for (uint8_t forest = 0; forest < kTotalForests; ++forest) {
+            [[unlikely]] if (((description.forests.clearingForests[origin] >> forest) & 1) != ((description.forests.forestClearings[forest] >> origin) & 1))
+                return std::unexpected(LoaderError{Code::kForestListsDisagree});
+        }
+    }
+    return {};
+}
+
+[[nodiscard]] std::expected<void, LoaderError> compare_with_tables(const BoardDescription &description, BoardType boardType)
+{
+    const size_t board = static_cast<size_t>(boardType);
+
+    [[unlikely]] if (description.adjacency.land != clearingAdjacency[board].land || description.adjacency.water != clearingAdjacency[board].water ||
+            description.closedPaths != generated::kClosedPathMasks[board])
+        return std::unexpected(LoaderError{Code::kTableMismatch});
+
+    [[unlikely]] if (description.forests.clearingForests != forestIncidence[board].clearingForests ||
+            description.forests.forestClearings != forestIncidence[board].forestClearings)
+        return std::unexpected(LoaderError{Code::kTableMismatch});
+
+    [[unlikely]] if (description.buildingSlotCounts != startingBuildingSlotCounts[board] || description.ruinsMask != startingRuins[board].to_ulong())
+        return std::unexpected(LoaderError{Code::kTableMismatch});
+
+    for (uint8_t clearing = 0; clearing < kTotalClearings; ++clearing) {
+        [[unlikely]] if (description.clearingTypes[clearing] != clearingTypes[board][clearing] ||
+                description.landmarkBits[clearing] != clearing_data::landmark_data::get_landmark_bit(startingLandmarks[board][clearing]))
+            return std::unexpected(LoaderError{Code::kTableMismatch});
+    }
+    return {};
+}
+
+BoardCache::BoardCache(void *mapping, size_t mappingSize) :
+    mapping(mapping),
+    mappingSize(mappingSize),
+    description(reinterpret_cast<const BoardDescription *>(static_cast<const std::byte *>(mapping) + sizeof(Header)))
+{}
+
+BoardCache::BoardCache(BoardCache &&other) noexcept :
+    mapping(std::exchange(other.mapping, nullptr)),
+    mappingSize(std::exchange(other.mappingSize, 0)),
+    description(std::exchange(other.description, nullptr))
+{}
+
+BoardCache &BoardCache::operator=(BoardCache &&other) noexcept
+{
+    if (this != &other) {
+        if (mapping != nullptr)
+            munmap(mapping, mappingSize);
+        mapping = std::exchange(other.mapping, nullptr);
+        mappingSize = std::exchange(other.mappingSize, 0);
+        description = std::exchange(other.description, nullptr);
+    }
+    return *this;
+}
+
+BoardCache::~BoardCache()
+{
+    if (mapping != nullptr)
+        munmap(mapping, mappingSize);
+}
+
+[[nodiscard]] std::expected<BoardCache, LoaderError> BoardCache::map(const std::filesystem::path &cachePath, const Header &expected)
+{
+    const int fd = ::open(cachePath.c_str(), O_RDONLY);
+    [[unlikely]] if (fd < 0)
+        return std::unexpected(LoaderError{Code::kCacheMapFailed});
+
+    struct stat status;
+    constexpr size_t kMappingSize = sizeof(Header) + sizeof(BoardDescription);
+    [[unlikely]] if (fstat(fd, &status) != 0 || static_cast<size_t>(status.st_size) != kMappingSize) {
+        ::close(fd);
+        return std::unexpected(LoaderError{Code::kCacheMapFailed});
+    }
+
+    void *mapping = mmap(nullptr, kMappingSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    [[unlikely]] if (mapping == MAP_FAILED)
+        return std::unexpected(LoaderError{Code::kCacheMapFailed});
+
+    // Anything that got this far but was written for another layout or source is just stale
+    const Header &header = *static_cast<const Header *>(mapping);
+    if (header.magic != expected.magic || header.version != expected.version || header.payloadSize != expected.payloadSize ||
+            header.sourceSize != expected.sourceSize || header.sourceWriteTime != expected.sourceWriteTime) {
+        munmap(mapping, kMappingSize);
+        return std::unexpected(LoaderError{Code::kCacheMapFailed});
+    }
+    return BoardCache(mapping, kMappingSize);
+}
+
+[[nodiscard]] std::expected<void, LoaderError> BoardCache::write(const std::filesystem::path &cachePath, const Header &header, const BoardDescription &description)
+{
+    // Written next to the cache and renamed over it, so a reader never maps a half written file
+    std::filesystem::path temporaryPath = cachePath;
+    temporaryPath += ".tmp";
+
+    std::FILE *file = std::fopen(temporaryPath.c_str(), "wb");
+    [[unlikely]] if (file == nullptr)
+        return std::unexpected(LoaderError{Code::kCacheWriteFailed});
+
+    const bool written = std::fwrite(&header, sizeof(header), 1, file) == 1 && std::fwrite(&description, sizeof(description), 1, file) == 1;
+    const bool closed = std::fclose(file) == 0;
+
+    std::error_code error;
+    [[unlikely]] if (!written || !closed) {
+        std::filesystem::remove(temporaryPath, error);
+        return std::unexpected(LoaderError{Code::kCacheWriteFailed});
+    }
+
+    std::filesystem::rename(temporaryPath, cachePath, error);
+    [[unlikely]] if (error)
+        return std::unexpected(LoaderError{Code::kCacheWriteFailed});
+    return {};
+}
+
+[[nodiscard]] std::expected<BoardCache, LoaderError> BoardCache::open(const std::filesystem::path &jsonPath, const std::filesystem::path &cachePath)
+{
+    std::error_code error;
+    const uintmax_t sourceSize = std::filesystem::file_size(jsonPath, error);
+    [[unlikely]] if (error)
+        return std::unexpected(LoaderError{Code::kFileOpenFailed});
+    const std::filesystem::file_time_type sourceWriteTime = std::filesystem::last_write_time(jsonPath, error);
+    [[unlikely]] if (error)
+        return std::unexpected(LoaderError{Code::kFileOpenFailed});
+
+    Header header{};
+    header.magic = kMagic;
+    header.version = kVersion;
+    header.payloadSize = sizeof(BoardDescription);
+    header.sourceSize = sourceSize;
+    header.sourceWriteTime = static_cast<int64_t>(sourceWriteTime.time_since_epoch().count());
+
+    auto cached = map(cachePath, header);
+    if (cached.has_value())
+        return cached;
+
+    const auto json = read_file(jsonPath);
+    if (!json.has_value())
+        return std::unexpected(json.error());
+
+    const auto description = parse_board_description(json.value());
+    if (!description.has_value())
+        return std::unexpected(description.error());
+
+    // A broken description must not end up in the cache, where later opens would map it without parsing
+    const auto valid = validate_board_description(description.value());
+    if (!valid.has_value())
+        return std::unexpected(valid.error());
+
+    const auto written = write(cachePath, header, description.value());
+    if (!written.has_value())
+        return std::unexpected(written.error());
+
+    return map(cachePath, header);
+}
+} // board_loader
+} // board_data
+} // game_data
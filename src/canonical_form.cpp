@@ -0,0 +1,89 @@
+#include "../include/canonical_form.hpp"
+
+#include <algorithm>
+
+namespace game_data
+{
+namespace canonical_form
+{
+
+namespace
+{
+
+// Negative, zero or positive like memcmp, comparing zone by zone in the order given
+[[nodiscard]] int compare_card_zones(std::span<const CardCounts> cardZones, uint8_t first, uint8_t second)
+{
+    for (const CardCounts &zone : cardZones) {
+        for (uint8_t card = 0; card < kTotalCardIDs; ++card) {
+            // The count at card after relabeling is the count of whichever card relabels onto it. Families are
+            // closed under every permutation, so the inverse image is found by applying the inverse permutation
+            const uint8_t firstCount = zone[static_cast<uint8_t>(kCardPermutations[kInversePermutations[first]][card])];
+            const uint8_t secondCount = zone[static_cast<uint8_t>(kCardPermutations[kInversePermutations[second]][card])];
+            if (firstCount != secondCount)
+                return firstCount < secondCount ? -1 : 1;
+        }
+    }
+    return 0;
+}
+
+// Clearing by clearing, suit in the high bits so suits decide before pieces
+[[nodiscard]] inline std::array<uint32_t, board_data::kTotalClearings> get_board_key(const SuitedBoard &board, uint8_t permutation)
+{
+    constexpr suit_setup::PackedSuitSetup kSuitMask = (1U << kSuitBits) - 1;
+    const suit_setup::PackedSuitSetup suits = permute_suits(board.suits, permutation);
+
+    std::array<uint32_t, board_data::kTotalClearings> result;
+    for (uint8_t clearing = 0; clearing < board_data::kTotalClearings; ++clearing)
+        result[clearing] = (((suits >> (clearing * kSuitBits)) & kSuitMask) << (kTotalSuits * kSuitedPieceBits)) |
+            permute_pieces(board.pieces[clearing], permutation);
+    return result;
+}
+} // namespace
+
+[[nodiscard]] uint8_t get_allowed_permutations(const SuitedBoard &board, std::span<const CardCounts> cardZones)
+{
+    constexpr uint8_t kIdentityOnly = 1;
+    [[unlikely]] if (board.printedSuits)
+        return kIdentityOnly;
+
+    uint8_t allowed = (1U << kTotalSuitPermutations) - 1;
+    for (const CardCounts &zone : cardZones)
+        for (uint8_t card = 0; card < kTotalCardIDs; ++card)
+            if (zone[card] != 0)
+                allowed &= kCardAllowedPermutations[card];
+    return allowed | kIdentityOnly;
+}
+
+[[nodiscard]] CanonicalForm canonicalize(const SuitedBoard &board, std::span<const CardCounts> cardZones)
+{
+    const uint8_t allowed = get_allowed_permutations(board, cardZones);
+
+    uint8_t best = 0;
+    std::array<uint32_t, board_data::kTotalClearings> bestKey = get_board_key(board, 0);
+    for (uint8_t permutation = 1; permutation < kTotalSuitPermutations; ++permutation) {
+        if ((allowed & (1U << permutation)) == 0)
+            continue;
+
+        const std::array<uint32_t, board_data::kTotalClearings> key = get_board_key(board, permutation);
+        if (key < bestKey || (key == bestKey && compare_card_zones(cardZones, permutation, best) < 0)) {
+            best = permutation;
+            bestKey = key;
+        }
+    }
+
+    uint64_t hash = board.neutralHash;
+    for (uint32_t clearingKey : bestKey)
+        hash = ::game_data::hash_combine(hash, clearingKey);
+    for (const CardCounts &zone : cardZones) {
+        for (uint8_t card = 0; card < kTotalCardIDs; ++card) {
+            const uint8_t count = zone[static_cast<uint8_t>(kCardPermutations[kInversePermutations[best]][card])];
+            if (count != 0)
+                hash = ::game_data::hash_combine(hash, (uint64_t(card) << 8) | count);
+        }
+        // Keeps a card moving between neighbouring zones from hashing the same
+        hash = ::game_data::hash_mix(hash);
+    }
+    return CanonicalForm{best, hash};
+}
+} // canonical_form
+} // game_data
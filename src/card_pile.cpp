@@ -24,6 +24,8 @@ inline void CardPile::set_pile_size()
     if constexpr (newSize == 0)
         this->on_pile_empty();
 
+    const uint8_t oldSize = std::min(read_bits<uint8_t, kPileSizeOffset, kPileSizeBits>(), card_data::kTotalCards);
+    zobristKey += (newSize > oldSize) ? get_range_key(oldSize, newSize) : -get_range_key(newSize, oldSize);
     write_bits<uint8_t, kPileSizeOffset, kPileSizeBits>(newSize);
 }
 
@@ -32,7 +34,9 @@ inline std::expected<void, PileError> CardPile::set_pile_size(uint8_t newSize)
     static_assert(kPileSizeBits > 0 && kPileSizeBits < 9, "Invalid kPileSizeBits value");
     [[unlikely]] if (newSize > card_data::kTotalCards)
         return std::unexpected(PileError{PileError::Code::kNewPileSizeExceededTotalItems});
-        
+
+    const uint8_t oldSize = std::min(read_bits<uint8_t, kPileSizeOffset, kPileSizeBits>(), card_data::kTotalCards);
+    zobristKey += (newSize > oldSize) ? get_range_key(oldSize, newSize) : -get_range_key(newSize, oldSize);
     write_bits<uint8_t, kPileSizeOffset, kPileSizeBits>(newSize);
     return {};
 }
@@ -68,6 +72,7 @@ std::expected<void, PileError> CardPile::set_pile_contents(const std::vector<car
     [[unlikely]] if (newPileSize == 1) {
         write_bits<card_data::CardID, kPileContentOffset, card_data::kCardIDBits>(newPile[0]);
         set_pile_size<1>();
+        zobristKey = zobrist::get_card_key(newPile[0]);
         return {};
     }
 
@@ -75,9 +80,12 @@ std::expected<void, PileError> CardPile::set_pile_contents(const std::vector<car
     [[unlikely]] if (!result.has_value())
         return result;
 
-    return write_bits<std::vector<card_data::CardID>, kPileContentOffset, card_data::kCardIDBits>(newPileSize, newPile)
-        .transform_error([](game_data::ReadWriteError error)
-            { return PileError{static_cast<PileError::Code>(error.code)}; });
+    // Every card is rewritten, so the key is rebuilt instead of patched
+    const std::expected<void, game_data::ReadWriteError> written =
+        write_bits<std::vector<card_data::CardID>, kPileContentOffset, card_data::kCardIDBits>(newPileSize, newPile);
+    zobristKey = get_range_key(0, newPileSize);
+    return written.transform_error([](game_data::ReadWriteError error)
+        { return PileError{static_cast<PileError::Code>(error.code)}; });
 }
 
 [[nodiscard]] std::expected<std::vector<card_data::CardID>, PileError> CardPile::get_cards_in_pile(const std::vector<uint8_t> &desiredCardIndices) const
@@ -174,7 +182,8 @@ std::expected<void, PileError> CardPile::set_cards_in_pile(const std::vector<Ind
             return std::unexpected(PileError{PileError::Code::kDuplicateIndices});
 
         seen.set(pair.index);
-        
+
+        zobristKey += zobrist::get_card_key(pair.cardID) - get_range_key(pair.index, pair.index + 1);
         const std::expected<void, PileError> result = write_bits<card_data::CardID, card_data::kCardIDBits>(pair.cardID, pair.index * card_data::kCardIDBits + kPileContentOffset)
             .transform_error([](game_data::ReadWriteError error)
                 { return PileError{static_cast<PileError::Code>(error.code)}; });
@@ -195,19 +204,20 @@ std::expected<void, PileError> CardPile::add_cards_to_pile(const std::vector<car
     [[unlikely]] if (!oldPileSize.has_value())
         return std::unexpected(oldPileSize.error());
 
+    // Growing the pile first would key whatever stale cards sat past the old size
+    const uint64_t oldZobristKey = zobristKey;
     std::expected<void, PileError> setPileSizeResult = set_pile_size(oldPileSize.value() + newCardsCount);
     [[unlikely]] if (!setPileSizeResult.has_value())
         return setPileSizeResult;
 
     const uint16_t offset = card_data::kCardIDBits * oldPileSize.value() + kPileContentOffset;
-    if (newCardsCount == 1)
-        return write_bits<card_data::CardID, card_data::kCardIDBits>(newCards[0], offset)
-            .transform_error([](game_data::ReadWriteError error)
-                { return PileError{static_cast<PileError::Code>(error.code)}; });
+    const std::expected<void, game_data::ReadWriteError> written = (newCardsCount == 1)
+        ? write_bits<card_data::CardID, card_data::kCardIDBits>(newCards[0], offset)
+        : write_bits<std::vector<card_data::CardID>, card_data::kCardIDBits>(newCardsCount, newCards, offset);
+    zobristKey = oldZobristKey + get_range_key(oldPileSize.value(), oldPileSize.value() + newCardsCount);
 
-    return write_bits<std::vector<card_data::CardID>, card_data::kCardIDBits>(newCardsCount, newCards, offset)
-        .transform_error([](game_data::ReadWriteError error)
-            { return PileError{static_cast<PileError::Code>(error.code)}; });
+    return written.transform_error([](game_data::ReadWriteError error)
+        { return PileError{static_cast<PileError::Code>(error.code)}; });
 }
 
 std::expected<void, PileError> CardPile::remove_cards_from_pile(const std::vector<uint8_t> &indices)
@@ -257,5 +267,42 @@ inline std::expected<void, PileError> CardPile::pop_cards_from_pile(uint8_t coun
     return set_pile_size(oldSizeResult.value() - count);
 }
 
+[[nodiscard]] uint64_t CardPile::get_hash(uint64_t seed) const
+{
+    const uint8_t pileSize = std::min(read_bits<uint8_t, kPileSizeOffset, kPileSizeBits>(), card_data::kTotalCards);
+    return game_data::hash_bits(pileData, kPileSizeOffset, kPileContentOffset + pileSize * card_data::kCardIDBits, seed);
+}
+
+[[nodiscard]] uint64_t CardPile::get_range_key(uint8_t begin, uint8_t end) const
+{
+    uint64_t key = 0;
+    for (uint8_t index = begin; index < std::min(end, card_data::kTotalCards); ++index)
+        key += zobrist::get_card_key(game_data::read_bits<card_data::CardID, sizeof(pileData), card_data::kCardIDBits>(
+            pileData, kPileContentOffset + index * card_data::kCardIDBits).value_or(card_data::CardID{}));
+    return key;
+}
+
+[[nodiscard]] bool CardPile::operator==(const CardPile &other) const
+{
+    const uint8_t pileSize = std::min(read_bits<uint8_t, kPileSizeOffset, kPileSizeBits>(), card_data::kTotalCards);
+    return game_data::equal_bits(pileData, other.pileData, kPileSizeOffset, kPileContentOffset + pileSize * card_data::kCardIDBits);
+}
+
+[[nodiscard]] std::expected<CardPile::CardPileData, PileError> CardPile::pack_pile(std::span<const card_data::CardID> cards)
+{
+    [[unlikely]] if (cards.size() > card_data::kTotalCards)
+        return std::unexpected(PileError{PileError::Code::kNewPileSizeExceededTotalItems});
+
+    CardPileData result{};
+    game_data::write_bits<uint8_t, sizeof(result), kPileSizeOffset, kPileSizeBits>(result, static_cast<uint8_t>(cards.size()));
+    for (uint8_t index = 0; index < cards.size(); ++index) {
+        const std::expected<void, game_data::ReadWriteError> written = game_data::write_bits<card_data::CardID, sizeof(result), card_data::kCardIDBits>(
+            result, cards[index], kPileContentOffset + index * card_data::kCardIDBits);
+        [[unlikely]] if (!written.has_value())
+            return std::unexpected(PileError{static_cast<PileError::Code>(written.error().code)});
+    }
+    return result;
+}
+
 } // namespace pile_data
 } // namespace game_data
@@ -7,15 +7,39 @@ namespace board_data
 namespace clearing_data
 {
 
-template<ClearingType clearingTypeValue, uint8_t initialSlotCount, bool hasRuinInitially>
-[[nodiscard]] inline uint8_t Clearing<clearingTypeValue, initialSlotCount, hasRuinInitially>::get_occupied_slot_count_unsafe() const
+template<ClearingType clearingTypeValue, uint8_t initialSlotCount, bool hasRuinInitially, landmark_data::Landmark startingLandmark>
+[[nodiscard]] inline uint8_t Clearing<clearingTypeValue, initialSlotCount, hasRuinInitially, startingLandmark>::get_occupied_slot_count_unsafe() const
 {
     static_assert(kBuildingSlotCountBits > 0 && kBuildingSlotCountBits <= 8, "Invalid kBuildingSlotCountBits value");
     return read_bits<uint8_t, kOccupiedBuildingSlotCountOffset, kOccupiedBuildingSlotCountBits>();
-}   
+}
 
-template<ClearingType clearingTypeValue, uint8_t initialSlotCount, bool hasRuinInitially>
-[[nodiscard]] inline std::expected<uint8_t, building_data::BuildingError> Clearing<clearingTypeValue, initialSlotCount, hasRuinInitially>::get_slot_count() const 
+template<ClearingType clearingTypeValue, uint8_t initialSlotCount, bool hasRuinInitially, landmark_data::Landmark startingLandmark>
+[[nodiscard]] inline uint64_t Clearing<clearingTypeValue, initialSlotCount, hasRuinInitially, startingLandmark>::get_token_word_key(TokenWord tokenWord) const
+{
+    uint64_t key = (tokenWord & kHiddenPlotToggleMask) ? zobrist::kHiddenPlotToggleKeys[boardIndex] : 0;
+    for (uint8_t token = 0; token < kTokenDataInfoField.size(); ++token) {
+        const TokenDataInfo &info = kTokenDataInfoField[token];
+        key ^= zobrist::kTokenKeys[boardIndex][token][(tokenWord >> info.offset) & ((TokenWord(1) << info.width) - 1)];
+    }
+    return key;
+}
+
+template<ClearingType clearingTypeValue, uint8_t initialSlotCount, bool hasRuinInitially, landmark_data::Landmark startingLandmark>
+[[nodiscard]] inline uint64_t Clearing<clearingTypeValue, initialSlotCount, hasRuinInitially, startingLandmark>::get_buildings_key() const
+{
+    static constexpr uint32_t kBuildingSlotMask = (1U << kBuildingSlotBits) - 1;
+    const uint8_t occupiedSlotCount = std::min(get_occupied_slot_count_unsafe(), kMaxBuildingSlotCount);
+    const uint32_t buildingSlotBits = read_bits<uint32_t, kBuildingSlotsOffset, kBuildingSlotsBits>();
+
+    uint64_t key = 0;
+    for (uint8_t slot = 0; slot < occupiedSlotCount; ++slot)
+        key ^= zobrist::kBuildingKeys[boardIndex][slot][(buildingSlotBits >> (slot * kBuildingSlotBits)) & kBuildingSlotMask];
+    return key;
+}
+
+template<ClearingType clearingTypeValue, uint8_t initialSlotCount, bool hasRuinInitially, landmark_data::Landmark startingLandmark>
+[[nodiscard]] inline std::expected<uint8_t, building_data::BuildingError> Clearing<clearingTypeValue, initialSlotCount, hasRuinInitially, startingLandmark>::get_slot_count() const 
 {
     static_assert(kBuildingSlotCountBits > 0 && kBuildingSlotCountBits <= 8, "Invalid kBuildingSlotCountBits value");
 
@@ -30,8 +54,8 @@ template<ClearingType clearingTypeValue, uint8_t initialSlotCount, bool hasRuinI
     return std::expected<uint8_t, building_data::BuildingError>{count};
 }
 
-template<ClearingType clearingTypeValue, uint8_t initialSlotCount, bool hasRuinInitially>
-[[nodiscard]] inline std::expected<uint8_t, building_data::BuildingError> Clearing<clearingTypeValue, initialSlotCount, hasRuinInitially>::get_occupied_slot_count() const
+template<ClearingType clearingTypeValue, uint8_t initialSlotCount, bool hasRuinInitially, landmark_data::Landmark startingLandmark>
+[[nodiscard]] inline std::expected<uint8_t, building_data::BuildingError> Clearing<clearingTypeValue, initialSlotCount, hasRuinInitially, startingLandmark>::get_occupied_slot_count() const
 {
     static_assert(kOccupiedBuildingSlotCountBits > 0 && kOccupiedBuildingSlotCountBits <= 8, "Invalid kOccupiedBuildingSlotCountBits value");
 
@@ -46,8 +70,8 @@ template<ClearingType clearingTypeValue, uint8_t initialSlotCount, bool hasRuinI
             { return std::unexpected<building_data::BuildingError>(error); });
 }
 
-template<ClearingType clearingTypeValue, uint8_t initialSlotCount, bool hasRuinInitially>
-[[nodiscard]] inline std::expected<uint8_t, building_data::BuildingError> Clearing<clearingTypeValue, initialSlotCount, hasRuinInitially>::get_remaining_slot_count() const
+template<ClearingType clearingTypeValue, uint8_t initialSlotCount, bool hasRuinInitially, landmark_data::Landmark startingLandmark>
+[[nodiscard]] inline std::expected<uint8_t, building_data::BuildingError> Clearing<clearingTypeValue, initialSlotCount, hasRuinInitially, startingLandmark>::get_remaining_slot_count() const
 {
     static_assert(kBuildingSlotCountBits + kOccupiedBuildingSlotCountBits > 0 && kBuildingSlotCountBits + kOccupiedBuildingSlotCountBits <= 8, "Invalid combined kBuildingSlotCountBits and kOccupiedBuildingSlotCountOffset value");
 
@@ -60,9 +84,9 @@ template<ClearingType clearingTypeValue, uint8_t initialSlotCount, bool hasRuinI
     return std::expected<uint8_t, building_data::BuildingError>{remainingSlots};
 }
 
-template<ClearingType clearingTypeValue, uint8_t initialSlotCount, bool hasRuinInitially>
+template<ClearingType clearingTypeValue, uint8_t initialSlotCount, bool hasRuinInitially, landmark_data::Landmark startingLandmark>
 template<uint8_t newCount>
-inline std::expected<void, building_data::BuildingError> Clearing<clearingTypeValue, initialSlotCount, hasRuinInitially>::set_slot_count()
+inline std::expected<void, building_data::BuildingError> Clearing<clearingTypeValue, initialSlotCount, hasRuinInitially, startingLandmark>::set_slot_count()
 {
     static_assert(kBuildingSlotCountBits > 0 && kBuildingSlotCountBits <= 8, "Invalid kBuildingSlotCountBits value");
     static_assert(newCount <= kMaxBuildingSlotCount, "newCount must not exceed max building slot count");
@@ -78,8 +102,8 @@ inline std::expected<void, building_data::BuildingError> Clearing<clearingTypeVa
             { return std::unexpected<building_data::BuildingError>(error); });
 }
 
-template<ClearingType clearingTypeValue, uint8_t initialSlotCount, bool hasRuinInitially>
-inline std::expected<void, building_data::BuildingError> Clearing<clearingTypeValue, initialSlotCount, hasRuinInitially>::set_slot_count(uint8_t newCount)
+template<ClearingType clearingTypeValue, uint8_t initialSlotCount, bool hasRuinInitially, landmark_data::Landmark startingLandmark>
+inline std::expected<void, building_data::BuildingError> Clearing<clearingTypeValue, initialSlotCount, hasRuinInitially, startingLandmark>::set_slot_count(uint8_t newCount)
 {
     static_assert(kBuildingSlotCountBits > 0 && kBuildingSlotCountBits <= 8, "Invalid kBuildingSlotCountBits value");
     [[unlikely]] if (newCount > kMaxBuildingSlotCount)
@@ -95,21 +119,23 @@ inline std::expected<void, building_data::BuildingError> Clearing<clearingTypeVa
     std::expected<void, building_data::BuildingError> { return std::unexpected<building_data::BuildingError>(error); });
 }
 
-template<ClearingType clearingTypeValue, uint8_t initialSlotCount, bool hasRuinInitially>
-inline std::expected<void, building_data::BuildingError> Clearing<clearingTypeValue, initialSlotCount, hasRuinInitially>::set_occupied_slot_count(uint8_t newCount)
+template<ClearingType clearingTypeValue, uint8_t initialSlotCount, bool hasRuinInitially, landmark_data::Landmark startingLandmark>
+inline std::expected<void, building_data::BuildingError> Clearing<clearingTypeValue, initialSlotCount, hasRuinInitially, startingLandmark>::set_occupied_slot_count(uint8_t newCount)
 {
     static_assert(kOccupiedBuildingSlotCountBits > 0 && kOccupiedBuildingSlotCountBits <= 8, "Invalid kOccupiedBuildingSlotCountBitss value");
 
     return get_slot_count().and_then([this, newCount](uint8_t slotCount) -> std::expected<void, building_data::BuildingError> {
         [[unlikely]] if (newCount > slotCount)
             return std::unexpected(building_data::BuildingError{building_data::BuildingError::Code::kNewOccupiedCountExceededCurrentSlotCount});
+        const uint64_t oldBuildingsKey = get_buildings_key();
         write_bits<uint8_t, kOccupiedBuildingSlotCountOffset, kOccupiedBuildingSlotCountBits>(newCount);
+        zobristKey ^= oldBuildingsKey ^ get_buildings_key();
         return {};
     }).or_else([](building_data::BuildingError error) -> std::expected<void, building_data::BuildingError> { return std::unexpected<building_data::BuildingError>(error); });
 }
 
-template<ClearingType clearingTypeValue, uint8_t initialSlotCount, bool hasRuinInitially>
-[[nodiscard]] inline std::expected<ElderTreetopIndex, building_data::BuildingError> Clearing<clearingTypeValue, initialSlotCount, hasRuinInitially>::get_elder_treetop_index() const
+template<ClearingType clearingTypeValue, uint8_t initialSlotCount, bool hasRuinInitially, landmark_data::Landmark startingLandmark>
+[[nodiscard]] inline std::expected<ElderTreetopIndex, building_data::BuildingError> Clearing<clearingTypeValue, initialSlotCount, hasRuinInitially, startingLandmark>::get_elder_treetop_index() const
 {
     static_assert(kTreetopIndexBits > 0 && kTreetopIndexBits <= 8, "Invalid kTreetopIndexBits value");
     static_assert(kMaxBuildingSlotCount > 0 && kMaxBuildingSlotCount < static_cast<uint8_t>(ElderTreetopIndex::kNotPresent) - 1, "Invalid kMaxBuildingSlotCount value");
@@ -126,8 +152,8 @@ template<ClearingType clearingTypeValue, uint8_t initialSlotCount, bool hasRuinI
     return std::expected<ElderTreetopIndex, building_data::BuildingError>{index};
 }
 
-template<ClearingType clearingTypeValue, uint8_t initialSlotCount, bool hasRuinInitially>
-inline std::expected<void, building_data::BuildingError> Clearing<clearingTypeValue, initialSlotCount, hasRuinInitially>::set_elder_treetop_index(ElderTreetopIndex newIndex)
+template<ClearingType clearingTypeValue, uint8_t initialSlotCount, bool hasRuinInitially, landmark_data::Landmark startingLandmark>
+inline std::expected<void, building_data::BuildingError> Clearing<clearingTypeValue, initialSlotCount, hasRuinInitially, startingLandmark>::set_elder_treetop_index(ElderTreetopIndex newIndex)
 {
     static_assert(kTreetopIndexBits > 0 && kTreetopIndexBits <= 8, "Invalid kTreetopIndexBits value");
     static_assert(kMaxBuildingSlotCount > 0 && kMaxBuildingSlotCount < static_cast<uint8_t>(ElderTreetopIndex::kNotPresent) - 1, "Invalid kMaxBuildingSlotCount value");
@@ -145,8 +171,8 @@ inline std::expected<void, building_data::BuildingError> Clearing<clearingTypeVa
     return {};
 }
 
-template<ClearingType clearingTypeValue, uint8_t initialSlotCount, bool hasRuinInitially>
-[[nodiscard]] std::expected<std::vector<building_data::Building>, building_data::BuildingError> Clearing<clearingTypeValue, initialSlotCount, hasRuinInitially>::get_occupied_building_slots() const
+template<ClearingType clearingTypeValue, uint8_t initialSlotCount, bool hasRuinInitially, landmark_data::Landmark startingLandmark>
+[[nodiscard]] std::expected<std::vector<building_data::Building>, building_data::BuildingError> Clearing<clearingTypeValue, initialSlotCount, hasRuinInitially, startingLandmark>::get_occupied_building_slots() const
 {
     static_assert(kBuildingSlotBits > 0 && kBuildingSlotBits <= 8, "Invalid kBuildingBits value");
 
@@ -169,8 +195,29 @@ template<ClearingType clearingTypeValue, uint8_t initialSlotCount, bool hasRuinI
             { return building_data::BuildingError{static_cast<building_data::BuildingError::Code>(error.code)}; });
 }
 
-template<ClearingType clearingTypeValue, uint8_t initialSlotCount, bool hasRuinInitially>
-std::expected<void, building_data::BuildingError> Clearing<clearingTypeValue, initialSlotCount, hasRuinInitially>::set_buildings(const std::vector<building_data::Building> &newBuildings)
+template<ClearingType clearingTypeValue, uint8_t initialSlotCount, bool hasRuinInitially, landmark_data::Landmark startingLandmark>
+[[nodiscard]] inline building_data::Building Clearing<clearingTypeValue, initialSlotCount, hasRuinInitially, startingLandmark>::get_building_in_slot(uint8_t slot) const
+{
+    static constexpr uint32_t kBuildingSlotMask = (1U << kBuildingSlotBits) - 1;
+    const uint32_t buildingSlotBits = read_bits<uint32_t, kBuildingSlotsOffset, kBuildingSlotsBits>();
+    return static_cast<building_data::Building>((buildingSlotBits >> (slot * kBuildingSlotBits)) & kBuildingSlotMask);
+}
+
+template<ClearingType clearingTypeValue, uint8_t initialSlotCount, bool hasRuinInitially, landmark_data::Landmark startingLandmark>
+[[nodiscard]] inline uint8_t Clearing<clearingTypeValue, initialSlotCount, hasRuinInitially, startingLandmark>::count_buildings(building_data::Building building) const
+{
+    static constexpr uint32_t kBuildingSlotMask = (1U << kBuildingSlotBits) - 1;
+    const uint8_t occupiedSlotCount = std::min(get_occupied_slot_count_unsafe(), kMaxBuildingSlotCount);
+    const uint32_t buildingSlotBits = read_bits<uint32_t, kBuildingSlotsOffset, kBuildingSlotsBits>();
+
+    uint8_t count = 0;
+    for (uint8_t slot = 0; slot < occupiedSlotCount; ++slot)
+        count += ((buildingSlotBits >> (slot * kBuildingSlotBits)) & kBuildingSlotMask) == static_cast<uint32_t>(building);
+    return count;
+}
+
+template<ClearingType clearingTypeValue, uint8_t initialSlotCount, bool hasRuinInitially, landmark_data::Landmark startingLandmark>
+std::expected<void, building_data::BuildingError> Clearing<clearingTypeValue, initialSlotCount, hasRuinInitially, startingLandmark>::set_buildings(const std::vector<building_data::Building> &newBuildings)
 {
     static_assert(kBuildingSlotBits > 0 && kBuildingSlotBits <= 8, "Invalid kBuildingBits value");
 
@@ -184,20 +231,24 @@ std::expected<void, building_data::BuildingError> Clearing<clearingTypeValue, in
     [[unlikely]] if (!result.has_value())
         return result;
 
+    const uint64_t oldBuildingsKey = get_buildings_key();
     if (newOccupiedBuildingSlotCount == 1) {
         // Fast path for a single building
         write_bits<building_data::Building, kBuildingSlotsOffset, kBuildingSlotBits>(newBuildings[0]);
+        zobristKey ^= oldBuildingsKey ^ get_buildings_key();
         return {};
     }
-    
 
-    return write_bits<std::vector<building_data::Building>, kBuildingSlotsOffset, kBuildingSlotBits>(newOccupiedBuildingSlotCount, newBuildings)
-        .transform_error([](game_data::ReadWriteError error)
-            { return building_data::BuildingError{static_cast<building_data::BuildingError::Code>(error.code)}; });
+
+    const std::expected<void, game_data::ReadWriteError> written =
+        write_bits<std::vector<building_data::Building>, kBuildingSlotsOffset, kBuildingSlotBits>(newOccupiedBuildingSlotCount, newBuildings);
+    zobristKey ^= oldBuildingsKey ^ get_buildings_key();
+    return written.transform_error([](game_data::ReadWriteError error)
+        { return building_data::BuildingError{static_cast<building_data::BuildingError::Code>(error.code)}; });
 }
 
-template<ClearingType clearingTypeValue, uint8_t initialSlotCount, bool hasRuinInitially>
-std::expected<void, building_data::BuildingError> Clearing<clearingTypeValue, initialSlotCount, hasRuinInitially>::set_buildings(const std::vector<building_data::IndexBuildingPair> &newIndexBuildingPairs)
+template<ClearingType clearingTypeValue, uint8_t initialSlotCount, bool hasRuinInitially, landmark_data::Landmark startingLandmark>
+std::expected<void, building_data::BuildingError> Clearing<clearingTypeValue, initialSlotCount, hasRuinInitially, startingLandmark>::set_buildings(const std::vector<building_data::IndexBuildingPair> &newIndexBuildingPairs)
 {
     static_assert(kBuildingSlotBits > 0 && kBuildingSlotBits <= 8, "Invalid kBuildingBits value");
     static_assert(kBuildingSlotsBits > 0 && kBuildingSlotsBits <= 32);
@@ -227,12 +278,14 @@ std::expected<void, building_data::BuildingError> Clearing<clearingTypeValue, in
         buildingSlotBits |= (static_cast<uint32_t>(pair.building) & kBuildingSlotMask) << (pair.index * kBuildingSlotBits);
     }
 
+    const uint64_t oldBuildingsKey = get_buildings_key();
     write_bits<uint32_t, kBuildingSlotsOffset, kBuildingSlotsBits>(buildingSlotBits);
+    zobristKey ^= oldBuildingsKey ^ get_buildings_key();
     return {};
 }
 
-template<ClearingType clearingTypeValue, uint8_t initialSlotCount, bool hasRuinInitially>
-std::expected<void, building_data::BuildingError> Clearing<clearingTypeValue, initialSlotCount, hasRuinInitially>::add_buildings(const std::vector<building_data::Building> &newBuildings)
+template<ClearingType clearingTypeValue, uint8_t initialSlotCount, bool hasRuinInitially, landmark_data::Landmark startingLandmark>
+std::expected<void, building_data::BuildingError> Clearing<clearingTypeValue, initialSlotCount, hasRuinInitially, startingLandmark>::add_buildings(const std::vector<building_data::Building> &newBuildings)
 {
     static_assert(kBuildingSlotBits > 0 && kBuildingSlotBits <= 8, "Invalid kBuildingSlotBits value");
     
@@ -250,18 +303,40 @@ std::expected<void, building_data::BuildingError> Clearing<clearingTypeValue, in
         return setOccupiedCountResult;
 
     const uint8_t offset = kBuildingSlotBits * oldOccupiedBuildingSlotCount.value() + kBuildingSlotsOffset;
-    if (newBuildingCount == 1)
-        return write_bits<building_data::Building, kBuildingSlotBits>(newBuildings[0], offset)
-            .transform_error([](game_data::ReadWriteError error)
-                { return building_data::BuildingError{static_cast<building_data::BuildingError::Code>(error.code)}; });
+    const uint64_t oldBuildingsKey = get_buildings_key();
+    const std::expected<void, game_data::ReadWriteError> written = (newBuildingCount == 1)
+        ? write_bits<building_data::Building, kBuildingSlotBits>(newBuildings[0], offset)
+        : write_bits<std::vector<building_data::Building>, kBuildingSlotBits>(newBuildingCount, newBuildings, offset);
+    zobristKey ^= oldBuildingsKey ^ get_buildings_key();
+
+    return written.transform_error([](game_data::ReadWriteError error)
+        { return building_data::BuildingError{static_cast<building_data::BuildingError::Code>(error.code)}; });
+}
 
-    return write_bits<std::vector<building_data::Building>, kBuildingSlotBits>(newBuildingCount, newBuildings, offset)
-        .transform_error([](game_data::ReadWriteError error)
-            { return building_data::BuildingError{static_cast<building_data::BuildingError::Code>(error.code)}; });
+template<ClearingType clearingTypeValue, uint8_t initialSlotCount, bool hasRuinInitially, landmark_data::Landmark startingLandmark>
+std::expected<void, building_data::BuildingError> Clearing<clearingTypeValue, initialSlotCount, hasRuinInitially, startingLandmark>::add_building(building_data::Building newBuilding)
+{
+    static_assert(kBuildingSlotBits > 0 && kBuildingSlotBits <= 8, "Invalid kBuildingSlotBits value");
+
+    const auto oldOccupiedBuildingSlotCount = get_occupied_slot_count();
+    [[unlikely]] if (!oldOccupiedBuildingSlotCount.has_value())
+        return std::unexpected(oldOccupiedBuildingSlotCount.error());
+
+    const std::expected<void, building_data::BuildingError> setOccupiedCountResult = set_occupied_slot_count(oldOccupiedBuildingSlotCount.value() + 1);
+    [[unlikely]] if (!setOccupiedCountResult.has_value())
+        return setOccupiedCountResult;
+
+    const uint8_t offset = kBuildingSlotBits * oldOccupiedBuildingSlotCount.value() + kBuildingSlotsOffset;
+    const uint64_t oldBuildingsKey = get_buildings_key();
+    const std::expected<void, game_data::ReadWriteError> written = write_bits<building_data::Building, kBuildingSlotBits>(newBuilding, offset);
+    zobristKey ^= oldBuildingsKey ^ get_buildings_key();
+
+    return written.transform_error([](game_data::ReadWriteError error)
+        { return building_data::BuildingError{static_cast<building_data::BuildingError::Code>(error.code)}; });
 }
 
-template<ClearingType clearingTypeValue, uint8_t initialSlotCount, bool hasRuinInitially>
-std::expected<void, building_data::BuildingError> Clearing<clearingTypeValue, initialSlotCount, hasRuinInitially>::remove_buildings(const std::vector<uint8_t> &indices)
+template<ClearingType clearingTypeValue, uint8_t initialSlotCount, bool hasRuinInitially, landmark_data::Landmark startingLandmark>
+std::expected<void, building_data::BuildingError> Clearing<clearingTypeValue, initialSlotCount, hasRuinInitially, startingLandmark>::remove_buildings(const std::vector<uint8_t> &indices)
 {
     static_assert(kBuildingSlotBits > 0 && kBuildingSlotBits <= 8, "Invalid kBuildingSlotBits value");
 
@@ -301,9 +376,36 @@ std::expected<void, building_data::BuildingError> Clearing<clearingTypeValue, in
     return set_buildings(newBuildings); 
 }
 
-template<ClearingType clearingTypeValue, uint8_t initialSlotCount, bool hasRuinInitially>
+template<ClearingType clearingTypeValue, uint8_t initialSlotCount, bool hasRuinInitially, landmark_data::Landmark startingLandmark>
+std::expected<void, building_data::BuildingError> Clearing<clearingTypeValue, initialSlotCount, hasRuinInitially, startingLandmark>::remove_building(uint8_t slot)
+{
+    static_assert(kBuildingSlotBits > 0 && kBuildingSlotBits <= 8, "Invalid kBuildingSlotBits value");
+
+    const auto occupiedBuildingSlotCount = get_occupied_slot_count();
+    [[unlikely]] if (!occupiedBuildingSlotCount.has_value())
+        return std::unexpected(occupiedBuildingSlotCount.error());
+
+    [[unlikely]] if (slot >= occupiedBuildingSlotCount.value())
+        return std::unexpected(building_data::BuildingError{building_data::BuildingError::Code::kIndexExceededOccupiedSlotCount});
+
+    const uint64_t oldBuildingsKey = get_buildings_key();
+    for (uint8_t next = slot + 1; next < occupiedBuildingSlotCount.value(); ++next) {
+        const uint8_t offset = kBuildingSlotBits * (next - 1) + kBuildingSlotsOffset;
+        const std::expected<void, game_data::ReadWriteError> written = write_bits<building_data::Building, kBuildingSlotBits>(get_building_in_slot(next), offset);
+        [[unlikely]] if (!written.has_value()) {
+            zobristKey ^= oldBuildingsKey ^ get_buildings_key();
+            return std::unexpected(building_data::BuildingError{static_cast<building_data::BuildingError::Code>(written.error().code)});
+        }
+    }
+    zobristKey ^= oldBuildingsKey ^ get_buildings_key();
+
+    // Dropping the now duplicated last slot keys it out
+    return set_occupied_slot_count(occupiedBuildingSlotCount.value() - 1);
+}
+
+template<ClearingType clearingTypeValue, uint8_t initialSlotCount, bool hasRuinInitially, landmark_data::Landmark startingLandmark>
 template<token_data::Token token>
-[[nodiscard]] inline std::expected<uint8_t, TokenError> Clearing<clearingTypeValue, initialSlotCount, hasRuinInitially>::get_token_count() const
+[[nodiscard]] inline std::expected<uint8_t, TokenError> Clearing<clearingTypeValue, initialSlotCount, hasRuinInitially, startingLandmark>::get_token_count() const
 {
     constexpr TokenDataInfo kTokenDataInfo = kTokenDataInfoField[static_cast<uint8_t>(token)];
 
@@ -315,85 +417,175 @@ template<token_data::Token token>
     return std::expected<uint8_t, TokenError>{count};
 }
 
-template<ClearingType clearingTypeValue, uint8_t initialSlotCount, bool hasRuinInitially>
+template<ClearingType clearingTypeValue, uint8_t initialSlotCount, bool hasRuinInitially, landmark_data::Landmark startingLandmark>
 template <token_data::Token token, uint8_t newCount>
-inline void Clearing<clearingTypeValue, initialSlotCount, hasRuinInitially>::set_token_count()
+inline void Clearing<clearingTypeValue, initialSlotCount, hasRuinInitially, startingLandmark>::set_token_count()
 {
     constexpr TokenDataInfo kTokenDataInfo = kTokenDataInfoField[static_cast<uint8_t>(token)];
     static_assert(newCount <= kTokenDataInfo.maxCount, "Cannot set token count above maximum for token type");
 
+    const uint8_t oldCount = read_bits<uint8_t, kTokenDataInfo.offset + kTokenDataOffset, kTokenDataInfo.width>();
+    zobristKey ^= zobrist::kTokenKeys[boardIndex][static_cast<uint8_t>(token)][oldCount] ^ zobrist::kTokenKeys[boardIndex][static_cast<uint8_t>(token)][newCount];
     write_bits<uint8_t, kTokenDataInfo.offset + kTokenDataOffset, kTokenDataInfo.width>(newCount);
 }
 
-template<ClearingType clearingTypeValue, uint8_t initialSlotCount, bool hasRuinInitially>
+template<ClearingType clearingTypeValue, uint8_t initialSlotCount, bool hasRuinInitially, landmark_data::Landmark startingLandmark>
 template <token_data::Token token>
-inline std::expected<void, TokenError> Clearing<clearingTypeValue, initialSlotCount, hasRuinInitially>::set_token_count(uint8_t newCount)
+inline std::expected<void, TokenError> Clearing<clearingTypeValue, initialSlotCount, hasRuinInitially, startingLandmark>::set_token_count(uint8_t newCount)
 {
     constexpr TokenDataInfo kTokenDataInfo = kTokenDataInfoField[static_cast<uint8_t>(token)];
     [[unlikely]] if (newCount > kTokenDataInfo.maxCount)
         return std::unexpected(TokenError{TokenError::Code::kNewCountExceededMaximumCount});
 
+    const uint8_t oldCount = read_bits<uint8_t, kTokenDataInfo.offset + kTokenDataOffset, kTokenDataInfo.width>();
+    zobristKey ^= zobrist::kTokenKeys[boardIndex][static_cast<uint8_t>(token)][oldCount] ^ zobrist::kTokenKeys[boardIndex][static_cast<uint8_t>(token)][newCount];
     write_bits<uint8_t, kTokenDataInfo.offset + kTokenDataOffset, kTokenDataInfo.width>(newCount);
     return {};
 }
 
-template<ClearingType clearingTypeValue, uint8_t initialSlotCount, bool hasRuinInitially>
-[[nodiscard]] inline bool Clearing<clearingTypeValue, initialSlotCount, hasRuinInitially>::contains_plot() const
+template<ClearingType clearingTypeValue, uint8_t initialSlotCount, bool hasRuinInitially, landmark_data::Landmark startingLandmark>
+[[nodiscard]] inline typename Clearing<clearingTypeValue, initialSlotCount, hasRuinInitially, startingLandmark>::TokenWord Clearing<clearingTypeValue, initialSlotCount, hasRuinInitially, startingLandmark>::get_token_word() const
+{
+    return read_bits<TokenWord, kTokenDataOffset, kTokenWordBits>();
+}
+
+template<ClearingType clearingTypeValue, uint8_t initialSlotCount, bool hasRuinInitially, landmark_data::Landmark startingLandmark>
+inline void Clearing<clearingTypeValue, initialSlotCount, hasRuinInitially, startingLandmark>::set_token_word(TokenWord newWord)
+{
+    zobristKey ^= get_token_word_key(get_token_word()) ^ get_token_word_key(newWord & kTokenWordMask);
+    write_bits<TokenWord, kTokenDataOffset, kTokenWordBits>(newWord & kTokenWordMask);
+}
+
+template<ClearingType clearingTypeValue, uint8_t initialSlotCount, bool hasRuinInitially, landmark_data::Landmark startingLandmark>
+[[nodiscard]] constexpr inline bool Clearing<clearingTypeValue, initialSlotCount, hasRuinInitially, startingLandmark>::contains_plot(TokenWord tokenWord)
+{
+    return (tokenWord & kAnyPlotMask) != 0;
+}
+
+template<ClearingType clearingTypeValue, uint8_t initialSlotCount, bool hasRuinInitially, landmark_data::Landmark startingLandmark>
+[[nodiscard]] constexpr inline bool Clearing<clearingTypeValue, initialSlotCount, hasRuinInitially, startingLandmark>::contains_face_up_plot(TokenWord tokenWord)
+{
+    // A bomb plot is face up whenever the hidden plot toggle is cleared
+    return (tokenWord & kFaceUpPlotMask) != 0 ||
+        ((tokenWord & kBombPlotMask) != 0 && (tokenWord & kHiddenPlotToggleMask) == 0);
+}
+
+template<ClearingType clearingTypeValue, uint8_t initialSlotCount, bool hasRuinInitially, landmark_data::Landmark startingLandmark>
+[[nodiscard]] constexpr inline bool Clearing<clearingTypeValue, initialSlotCount, hasRuinInitially, startingLandmark>::contains_relic(TokenWord tokenWord)
+{
+    return (tokenWord & kAnyRelicMask) != 0;
+}
+
+template<ClearingType clearingTypeValue, uint8_t initialSlotCount, bool hasRuinInitially, landmark_data::Landmark startingLandmark>
+[[nodiscard]] constexpr inline bool Clearing<clearingTypeValue, initialSlotCount, hasRuinInitially, startingLandmark>::contains_trade_post(TokenWord tokenWord)
+{
+    return (tokenWord & kAnyTradePostMask) != 0;
+}
+
+template<ClearingType clearingTypeValue, uint8_t initialSlotCount, bool hasRuinInitially, landmark_data::Landmark startingLandmark>
+[[nodiscard]] constexpr inline uint8_t Clearing<clearingTypeValue, initialSlotCount, hasRuinInitially, startingLandmark>::get_plot_count(TokenWord tokenWord)
+{
+    // Fold the high bit of every two bit plot field onto its low bit so face up and face down plots both count once
+    const TokenWord presentPlots = (tokenWord & kBombPlotMask) | ((tokenWord | (tokenWord >> 1)) & kTwoBitPlotLowMask);
+    return static_cast<uint8_t>(std::popcount(presentPlots));
+}
+
+template<ClearingType clearingTypeValue, uint8_t initialSlotCount, bool hasRuinInitially, landmark_data::Landmark startingLandmark>
+[[nodiscard]] constexpr inline uint8_t Clearing<clearingTypeValue, initialSlotCount, hasRuinInitially, startingLandmark>::get_trade_post_count(TokenWord tokenWord)
+{
+    return static_cast<uint8_t>(std::popcount(tokenWord & kAnyTradePostMask));
+}
+
+template<ClearingType clearingTypeValue, uint8_t initialSlotCount, bool hasRuinInitially, landmark_data::Landmark startingLandmark>
+[[nodiscard]] constexpr inline uint8_t Clearing<clearingTypeValue, initialSlotCount, hasRuinInitially, startingLandmark>::get_relic_count(TokenWord tokenWord)
+{
+    static constexpr TokenWord kNibbleMask = (TokenWord(1) << kRelicNibbleBits) - 1;
+    return
+        kRelicNibbleCounts[(tokenWord >> kRelicNibblesOffset) & kNibbleMask] +
+        kRelicNibbleCounts[(tokenWord >> (kRelicNibblesOffset + kRelicNibbleBits)) & kNibbleMask] +
+        kRelicNibbleCounts[(tokenWord >> (kRelicNibblesOffset + 2 * kRelicNibbleBits)) & kNibbleMask];
+}
+
+template<ClearingType clearingTypeValue, uint8_t initialSlotCount, bool hasRuinInitially, landmark_data::Landmark startingLandmark>
+[[nodiscard]] constexpr inline uint8_t Clearing<clearingTypeValue, initialSlotCount, hasRuinInitially, startingLandmark>::get_relic_value(TokenWord tokenWord)
+{
+    static constexpr TokenWord kNibbleMask = (TokenWord(1) << kRelicNibbleBits) - 1;
+    return
+        kRelicNibbleValues[(tokenWord >> kRelicNibblesOffset) & kNibbleMask] +
+        kRelicNibbleValues[(tokenWord >> (kRelicNibblesOffset + kRelicNibbleBits)) & kNibbleMask] +
+        kRelicNibbleValues[(tokenWord >> (kRelicNibblesOffset + 2 * kRelicNibbleBits)) & kNibbleMask];
+}
+
+template<ClearingType clearingTypeValue, uint8_t initialSlotCount, bool hasRuinInitially, landmark_data::Landmark startingLandmark>
+[[nodiscard]] inline bool Clearing<clearingTypeValue, initialSlotCount, hasRuinInitially, startingLandmark>::contains_plot() const
 {
-    constexpr TokenDataInfo kBombPlotDataInfo = kTokenDataInfoField[static_cast<uint8_t>(token_data::Token::kBombPlot)];
-    constexpr TokenDataInfo kSnarePlotDataInfo = kTokenDataInfoField[static_cast<uint8_t>(token_data::Token::kSnarePlot)];
-    constexpr TokenDataInfo kExtorsionPlotDataInfo = kTokenDataInfoField[static_cast<uint8_t>(token_data::Token::kExtortionPlot)];
-    constexpr TokenDataInfo kRaidPlotDataInfo = kTokenDataInfoField[static_cast<uint8_t>(token_data::Token::kRaidPlot)];
+    return contains_plot(get_token_word());
+}
 
-    constexpr uint8_t totalWidth =
-        kBombPlotDataInfo.width +
-        kSnarePlotDataInfo.width +
-        kExtorsionPlotDataInfo.width +
-        kRaidPlotDataInfo.width;
-    static_assert(totalWidth > 0 && totalWidth <= 8, "Invalid sum of the bit width of all plots");
+template<ClearingType clearingTypeValue, uint8_t initialSlotCount, bool hasRuinInitially, landmark_data::Landmark startingLandmark>
+[[nodiscard]] inline bool Clearing<clearingTypeValue, initialSlotCount, hasRuinInitially, startingLandmark>::contains_face_up_plot() const
+{
+    return contains_face_up_plot(get_token_word());
+}
 
-    // Anything >0 = true when cast to bool
-    return static_cast<bool>(read_bits<uint8_t, kTokenDataOffset + kBombPlotDataInfo.offset, totalWidth>() == 0);
+template<ClearingType clearingTypeValue, uint8_t initialSlotCount, bool hasRuinInitially, landmark_data::Landmark startingLandmark>
+[[nodiscard]] inline bool Clearing<clearingTypeValue, initialSlotCount, hasRuinInitially, startingLandmark>::contains_relic() const
+{
+    return contains_relic(get_token_word());
+}
+
+template<ClearingType clearingTypeValue, uint8_t initialSlotCount, bool hasRuinInitially, landmark_data::Landmark startingLandmark>
+[[nodiscard]] inline bool Clearing<clearingTypeValue, initialSlotCount, hasRuinInitially, startingLandmark>::contains_trade_post() const
+{
+    return contains_trade_post(get_token_word());
 }
 
-template<ClearingType clearingTypeValue, uint8_t initialSlotCount, bool hasRuinInitially>
-[[nodiscard]] inline bool Clearing<clearingTypeValue, initialSlotCount, hasRuinInitially>::is_plot_face_down() const
+template<ClearingType clearingTypeValue, uint8_t initialSlotCount, bool hasRuinInitially, landmark_data::Landmark startingLandmark>
+[[nodiscard]] inline uint8_t Clearing<clearingTypeValue, initialSlotCount, hasRuinInitially, startingLandmark>::get_relic_value() const
+{
+    return get_relic_value(get_token_word());
+}
+
+template<ClearingType clearingTypeValue, uint8_t initialSlotCount, bool hasRuinInitially, landmark_data::Landmark startingLandmark>
+[[nodiscard]] inline bool Clearing<clearingTypeValue, initialSlotCount, hasRuinInitially, startingLandmark>::is_plot_face_down() const
 {
     static_assert(kHiddenPlotToggleBits == 1, "Hidden plot toggle bits must equal 1");
     return read_bits<bool, kHiddenPlotToggleOffset, kHiddenPlotToggleBits>();
 }
 
-template<ClearingType clearingTypeValue, uint8_t initialSlotCount, bool hasRuinInitially>
-inline void Clearing<clearingTypeValue, initialSlotCount, hasRuinInitially>::set_is_plot_face_down(bool newStatus)
+template<ClearingType clearingTypeValue, uint8_t initialSlotCount, bool hasRuinInitially, landmark_data::Landmark startingLandmark>
+inline void Clearing<clearingTypeValue, initialSlotCount, hasRuinInitially, startingLandmark>::set_is_plot_face_down(bool newStatus)
 {
     static_assert(kHiddenPlotToggleBits == 1, "Hidden plot toggle bits must equal 1");
+    if (newStatus != is_plot_face_down())
+        zobristKey ^= zobrist::kHiddenPlotToggleKeys[boardIndex];
     write_bits<bool, kHiddenPlotToggleOffset, kHiddenPlotToggleBits>(newStatus);
 }
 
-template<ClearingType clearingTypeValue, uint8_t initialSlotCount, bool hasRuinInitially>
-[[nodiscard]] inline bool Clearing<clearingTypeValue, initialSlotCount, hasRuinInitially>::is_lord_of_the_hundreds_warlord_present() const
+template<ClearingType clearingTypeValue, uint8_t initialSlotCount, bool hasRuinInitially, landmark_data::Landmark startingLandmark>
+[[nodiscard]] inline bool Clearing<clearingTypeValue, initialSlotCount, hasRuinInitially, startingLandmark>::is_lord_of_the_hundreds_warlord_present() const
 {
-    constexpr PawnDataInfo warlordPawnDataInfo = kPawnDataInfoField[static_cast<uint8_t>(faction_data::FactionID::kLordOfTheHundreds) + 1];
+    constexpr PawnDataInfo warlordPawnDataInfo = kPawnDataInfoField[kWarlordPawnDataIndex];
     static_assert(warlordPawnDataInfo.width == 1, "Warlord pawn data width must equal 1");
 
     return read_bits<bool, warlordPawnDataInfo.offset + kPawnDataOffset, warlordPawnDataInfo.width>();
 }
 
-template<ClearingType clearingTypeValue, uint8_t initialSlotCount, bool hasRuinInitially>
-inline void Clearing<clearingTypeValue, initialSlotCount, hasRuinInitially>::set_is_lord_of_the_hundreds_warlord_present(bool newStatus)
+template<ClearingType clearingTypeValue, uint8_t initialSlotCount, bool hasRuinInitially, landmark_data::Landmark startingLandmark>
+inline void Clearing<clearingTypeValue, initialSlotCount, hasRuinInitially, startingLandmark>::set_is_lord_of_the_hundreds_warlord_present(bool newStatus)
 {
-    constexpr PawnDataInfo warlordPawnDataInfo = kPawnDataInfoField[static_cast<uint8_t>(faction_data::FactionID::kLordOfTheHundreds) + 1];
+    constexpr PawnDataInfo warlordPawnDataInfo = kPawnDataInfoField[kWarlordPawnDataIndex];
     static_assert(warlordPawnDataInfo.width == 1, "Warlord pawn data width must equal 1");
 
+    zobristKey ^= zobrist::kPawnKeys[boardIndex][kWarlordPawnDataIndex][is_lord_of_the_hundreds_warlord_present()] ^ zobrist::kPawnKeys[boardIndex][kWarlordPawnDataIndex][newStatus];
     write_bits<bool, warlordPawnDataInfo.offset + kPawnDataOffset, warlordPawnDataInfo.width>(newStatus);
 }
 
-template<ClearingType clearingTypeValue, uint8_t initialSlotCount, bool hasRuinInitially>
+template<ClearingType clearingTypeValue, uint8_t initialSlotCount, bool hasRuinInitially, landmark_data::Landmark startingLandmark>
 template <faction_data::FactionID factionID>
-[[nodiscard]] inline std::expected<uint8_t, PawnError> Clearing<clearingTypeValue, initialSlotCount, hasRuinInitially>::get_pawn_count() const
+[[nodiscard]] inline std::expected<uint8_t, PawnError> Clearing<clearingTypeValue, initialSlotCount, hasRuinInitially, startingLandmark>::get_pawn_count() const
 {
-    // Account for lord of the hundreds warlord taking an extra index
-    constexpr uint8_t index = (factionID > faction_data::FactionID::kLordOfTheHundreds) ? static_cast<uint8_t>(factionID) + 1 : static_cast<uint8_t>(factionID);
+    constexpr uint8_t index = get_pawn_data_index(factionID);
     constexpr PawnDataInfo kPawnDataInfo = kPawnDataInfoField[index];
 
     if constexpr (factionID == faction_data::FactionID::kLordOfTheHundreds) {
@@ -414,41 +606,47 @@ template <faction_data::FactionID factionID>
     return read_bits<uint8_t, kPawnDataInfo.offset + kPawnDataOffset, kPawnDataInfo.width>(); 
 }
 
-template<ClearingType clearingTypeValue, uint8_t initialSlotCount, bool hasRuinInitially>
+template<ClearingType clearingTypeValue, uint8_t initialSlotCount, bool hasRuinInitially, landmark_data::Landmark startingLandmark>
 template<faction_data::FactionID factionID>
-inline std::expected<void, PawnError> Clearing<clearingTypeValue, initialSlotCount, hasRuinInitially>::set_pawn_count_generic(uint8_t newCount)
+inline std::expected<void, PawnError> Clearing<clearingTypeValue, initialSlotCount, hasRuinInitially, startingLandmark>::set_pawn_count_generic(uint8_t newCount)
 {
-    // Account for lord of the hundreds warlord taking an extra index
-    constexpr uint8_t index = (factionID > faction_data::FactionID::kLordOfTheHundreds) ? static_cast<uint8_t>(factionID) + 1 : static_cast<uint8_t>(factionID);
+    constexpr uint8_t index = get_pawn_data_index(factionID);
     constexpr PawnDataInfo kPawnDataInfo = kPawnDataInfoField[static_cast<uint8_t>(index)];
     
     [[unlikely]] if (newCount > kPawnDataInfo.maxCount)
         return std::unexpected(PawnError{PawnError::Code::kNewCountExceededMaximumCount});
 
-    write_bits<uint8_t, kPawnDataInfo.offset + Clearing<clearingTypeValue, initialSlotCount, hasRuinInitially>::kPawnDataOffset, kPawnDataInfo.width>(newCount);
+    const uint8_t oldCount = read_bits<uint8_t, kPawnDataInfo.offset + kPawnDataOffset, kPawnDataInfo.width>();
+    zobristKey ^= zobrist::kPawnKeys[boardIndex][index][oldCount] ^ zobrist::kPawnKeys[boardIndex][index][newCount];
+    write_bits<uint8_t, kPawnDataInfo.offset + Clearing<clearingTypeValue, initialSlotCount, hasRuinInitially, startingLandmark>::kPawnDataOffset, kPawnDataInfo.width>(newCount);
     return {};
 }
 
-template<ClearingType clearingTypeValue, uint8_t initialSlotCount, bool hasRuinInitially>
+template<ClearingType clearingTypeValue, uint8_t initialSlotCount, bool hasRuinInitially, landmark_data::Landmark startingLandmark>
 template <faction_data::FactionID factionID>
-inline std::expected<void, PawnError> Clearing<clearingTypeValue, initialSlotCount, hasRuinInitially>::set_pawn_count(uint8_t newCount)
+inline std::expected<void, PawnError> Clearing<clearingTypeValue, initialSlotCount, hasRuinInitially, startingLandmark>::set_pawn_count(uint8_t newCount)
 {
     static_assert(factionID != faction_data::FactionID::kLordOfTheHundreds, "Incorrect override for setting lord of the hundreds pawn count");
     return set_pawn_count_generic<factionID>(newCount);
 }
 
-template<ClearingType clearingTypeValue, uint8_t initialSlotCount, bool hasRuinInitially>
+template<ClearingType clearingTypeValue, uint8_t initialSlotCount, bool hasRuinInitially, landmark_data::Landmark startingLandmark>
 template<faction_data::FactionID factionID, bool isWarlordPresent>
-inline std::expected<void, PawnError> Clearing<clearingTypeValue, initialSlotCount, hasRuinInitially>::set_pawn_count(uint8_t newCount)
+inline std::expected<void, PawnError> Clearing<clearingTypeValue, initialSlotCount, hasRuinInitially, startingLandmark>::set_pawn_count(uint8_t newCount)
 {
     static_assert(factionID == faction_data::FactionID::kLordOfTheHundreds, "Incorrect override for setting generic faction pawn count");
     if constexpr (isWarlordPresent) {
         constexpr PawnDataInfo kPawnDataInfo = kPawnDataInfoField[static_cast<uint8_t>(faction_data::FactionID::kLordOfTheHundreds)];
-        constexpr PawnDataInfo warlordDataInfo = kPawnDataInfoField[static_cast<uint8_t>(faction_data::FactionID::kLordOfTheHundreds) + 1];
+        constexpr PawnDataInfo warlordDataInfo = kPawnDataInfoField[kWarlordPawnDataIndex];
         constexpr uint8_t totalWidth = kPawnDataInfo.width + warlordDataInfo.width;
         static_assert(warlordDataInfo.width == 1, "Warlord pawn data width must equal 1");
         static_assert(totalWidth > 0 && totalWidth <= 8, "Invalid sum of max standard and warlord lord of the hundreds pawns");
 
+        constexpr uint8_t index = get_pawn_data_index(factionID);
+        const uint8_t oldCombined = read_bits<uint8_t, kPawnDataInfo.offset + kPawnDataOffset, totalWidth>();
+        zobristKey ^=
+            zobrist::kPawnKeys[boardIndex][index][oldCombined & ((1U << kPawnDataInfo.width) - 1)] ^ zobrist::kPawnKeys[boardIndex][index][newCount] ^
+            zobrist::kPawnKeys[boardIndex][kWarlordPawnDataIndex][oldCombined >> kPawnDataInfo.width] ^ zobrist::kPawnKeys[boardIndex][kWarlordPawnDataIndex][1];
         write_bits<uint8_t, kPawnDataInfo.offset + kPawnDataOffset, totalWidth>(
             (static_cast<uint8_t>(true) << kPawnDataInfo.width) | newCount
         );
@@ -458,49 +656,61 @@ inline std::expected<void, PawnError> Clearing<clearingTypeValue, initialSlotCou
     }
 }
 
-template<ClearingType clearingTypeValue, uint8_t initialSlotCount, bool hasRuinInitially>
-[[nodiscard]] inline bool Clearing<clearingTypeValue, initialSlotCount, hasRuinInitially>::is_razed() const
+template<ClearingType clearingTypeValue, uint8_t initialSlotCount, bool hasRuinInitially, landmark_data::Landmark startingLandmark>
+[[nodiscard]] inline typename Clearing<clearingTypeValue, initialSlotCount, hasRuinInitially, startingLandmark>::PawnWord Clearing<clearingTypeValue, initialSlotCount, hasRuinInitially, startingLandmark>::get_pawn_word() const
+{
+    return read_bits<PawnWord, kPawnDataOffset, kPawnDataBits>();
+}
+
+template<ClearingType clearingTypeValue, uint8_t initialSlotCount, bool hasRuinInitially, landmark_data::Landmark startingLandmark>
+[[nodiscard]] inline bool Clearing<clearingTypeValue, initialSlotCount, hasRuinInitially, startingLandmark>::is_razed() const
 {
     static_assert(kRazedBits == 1, "Razed bits must equal 1");
 
     return read_bits<bool, kRazedOffset, kRazedBits>();
 }
 
-template<ClearingType clearingTypeValue, uint8_t initialSlotCount, bool hasRuinInitially>
-inline void Clearing<clearingTypeValue, initialSlotCount, hasRuinInitially>::set_is_razed(bool newStatus)
+template<ClearingType clearingTypeValue, uint8_t initialSlotCount, bool hasRuinInitially, landmark_data::Landmark startingLandmark>
+inline void Clearing<clearingTypeValue, initialSlotCount, hasRuinInitially, startingLandmark>::set_is_razed(bool newStatus)
 {
     static_assert(kRazedBits == 1, "Razed bits must equal 1");
 
+    if (newStatus != is_razed())
+        zobristKey ^= zobrist::kRazedKeys[boardIndex];
     write_bits<bool, kRazedOffset, kRazedBits>(newStatus);
 }
 
-template<ClearingType clearingTypeValue, uint8_t initialSlotCount, bool hasRuinInitially>
-[[nodiscard]] inline std::vector<landmark_data::Landmark> Clearing<clearingTypeValue, initialSlotCount, hasRuinInitially>::get_landmarks() const
+template<ClearingType clearingTypeValue, uint8_t initialSlotCount, bool hasRuinInitially, landmark_data::Landmark startingLandmark>
+[[nodiscard]] inline uint8_t Clearing<clearingTypeValue, initialSlotCount, hasRuinInitially, startingLandmark>::get_landmark_bits() const
+{
+    return read_bits<uint8_t, kLandMarkOffset, kLandmarkBits>();
+}
+
+template<ClearingType clearingTypeValue, uint8_t initialSlotCount, bool hasRuinInitially, landmark_data::Landmark startingLandmark>
+[[nodiscard]] inline std::vector<landmark_data::Landmark> Clearing<clearingTypeValue, initialSlotCount, hasRuinInitially, startingLandmark>::get_landmarks() const
 {
     static_assert(kLandmarkBits > 0 && kLandmarkBits < 8, "Invalid kLandmarkBitsValue");
     uint8_t combined = read_bits<uint8_t, kLandMarkOffset, kLandmarkBits>();
 
     std::vector<landmark_data::Landmark> result;
+    // Bit i holds landmark i + 1, since kNone has no bit
     auto dispatch = [&combined, &result]<size_t... Is>(std::index_sequence<Is...>) {
-        ((combined & (1 << Is) ? result.push_back(static_cast<landmark_data::Landmark>(Is)) : void()), ...);
+        ((combined & (1 << Is) ? result.push_back(static_cast<landmark_data::Landmark>(Is + 1)) : void()), ...);
     };
     dispatch(std::make_index_sequence<kLandmarkBits>{});
     return result;
 }
 
-template<ClearingType clearingTypeValue, uint8_t initialSlotCount, bool hasRuinInitially>
-[[nodiscard]] inline std::expected<bool, landmark_data::LandmarkError> Clearing<clearingTypeValue, initialSlotCount, hasRuinInitially>::is_landmark_present(landmark_data::Landmark desiredLandmark) const
+template<ClearingType clearingTypeValue, uint8_t initialSlotCount, bool hasRuinInitially, landmark_data::Landmark startingLandmark>
+[[nodiscard]] inline std::expected<bool, landmark_data::LandmarkError> Clearing<clearingTypeValue, initialSlotCount, hasRuinInitially, startingLandmark>::is_landmark_present(landmark_data::Landmark desiredLandmark) const
 {
     static_assert(kLandmarkBits > 0 && kLandmarkBits < 8, "Invalid kLandmarkBitsValue");
 
-    const uint8_t offset = static_cast<uint8_t>(desiredLandmark) + kLandMarkOffset;
-    return read_bits<bool, 1>(offset)
-        .transform_error([](game_data::ReadWriteError error)
-            { return landmark_data::LandmarkError{static_cast<landmark_data::LandmarkError::Code>(error.code)}; });
+    return (get_landmark_bits() & landmark_data::get_landmark_bit(desiredLandmark)) != 0;
 }
 
-template<ClearingType clearingTypeValue, uint8_t initialSlotCount, bool hasRuinInitially>
-std::expected<void, landmark_data::LandmarkError> Clearing<clearingTypeValue, initialSlotCount, hasRuinInitially>::set_landmarks(const std::vector<landmark_data::LandmarkStatusPair> &newLandmarkStatusPairs)
+template<ClearingType clearingTypeValue, uint8_t initialSlotCount, bool hasRuinInitially, landmark_data::Landmark startingLandmark>
+std::expected<void, landmark_data::LandmarkError> Clearing<clearingTypeValue, initialSlotCount, hasRuinInitially, startingLandmark>::set_landmarks(const std::vector<landmark_data::LandmarkStatusPair> &newLandmarkStatusPairs)
 {
     static_assert(kLandmarkBits > 0 && kLandmarkBits < 8, "Invalid kLandmarkBits value");
     static_assert(kLandmarkBits == landmark_data::kTotalLandmarks, "kLandMarkBits must be equal to kTotalLandmarks");
@@ -508,25 +718,26 @@ std::expected<void, landmark_data::LandmarkError> Clearing<clearingTypeValue, in
     [[unlikely]] if (newLandmarkStatusPairs.empty())
         return std::unexpected(landmark_data::LandmarkError{landmark_data::LandmarkError::Code::kSetZeroLandmarks});
     
-    std::bitset<landmark_data::kTotalLandmarks> seen;
-    uint8_t landmarkBits = read_bits<uint8_t, kLandMarkOffset, kLandmarkBits>();
+    uint8_t seen = 0;
+    uint8_t landmarkBits = get_landmark_bits();
     for (const auto &pair : newLandmarkStatusPairs)
     {
-        [[unlikely]] if (seen.test(static_cast<size_t>(pair.landmark)))
+        const uint8_t landmarkBit = landmark_data::get_landmark_bit(pair.landmark);
+        [[unlikely]] if (seen & landmarkBit)
             return std::unexpected(landmark_data::LandmarkError{landmark_data::LandmarkError::Code::kDuplicateLandmarks});
 
-        seen.set(static_cast<size_t>(pair.landmark));
+        seen |= landmarkBit;
 
-        if (pair.status) { landmarkBits |= (1 << static_cast<uint8_t>(pair.landmark)); } 
-        else { landmarkBits &= ~(1 << static_cast<uint8_t>(pair.landmark)); }
+        if (pair.status) { landmarkBits |= landmarkBit; } 
+        else { landmarkBits &= ~landmarkBit; }
     }
 
     write_bits<uint8_t, kLandMarkOffset, kLandmarkBits>(landmarkBits);
     return {};
 }
 
-template<ClearingType clearingTypeValue, uint8_t initialSlotCount, bool hasRuinInitially>
-std::expected<void, landmark_data::LandmarkError> Clearing<clearingTypeValue, initialSlotCount, hasRuinInitially>::set_landmarks(const std::vector<landmark_data::Landmark> &newLandmarks)
+template<ClearingType clearingTypeValue, uint8_t initialSlotCount, bool hasRuinInitially, landmark_data::Landmark startingLandmark>
+std::expected<void, landmark_data::LandmarkError> Clearing<clearingTypeValue, initialSlotCount, hasRuinInitially, startingLandmark>::set_landmarks(const std::vector<landmark_data::Landmark> &newLandmarks)
 {
     static_assert(kLandmarkBits > 0 && kLandmarkBits < 8, "Invalid kLandmarkBitsValue");
     static_assert(kLandmarkBits == landmark_data::kTotalLandmarks, "kLandmarkBits must be equal to kTotalLandmarks");
@@ -538,19 +749,44 @@ std::expected<void, landmark_data::LandmarkError> Clearing<clearingTypeValue, in
         return std::unexpected(landmark_data::LandmarkError{landmark_data::LandmarkError::Code::kNewLandmarkCountExceedsMaxLandmarks});
 
     // surely the compiler will auto-unroll this
-    std::bitset<kLandmarkBits> seen;
     uint8_t landmarkBits = 0;
     for (const auto &landmark : newLandmarks) {
-        [[unlikely]] if (seen.test(static_cast<size_t>(landmark)))
+        const uint8_t landmarkBit = landmark_data::get_landmark_bit(landmark);
+        [[unlikely]] if (landmarkBits & landmarkBit)
             return std::unexpected(landmark_data::LandmarkError{landmark_data::LandmarkError::Code::kDuplicateLandmarks});
 
-        seen.set(static_cast<size_t>(landmark));
-        landmarkBits |= (1 << static_cast<uint8_t>(landmark));
+        landmarkBits |= landmarkBit;
     }
     write_bits<uint8_t, kLandMarkOffset, kLandmarkBits>(landmarkBits);
 
     return {};
 }
+
+template<ClearingType clearingTypeValue, uint8_t initialSlotCount, bool hasRuinInitially, landmark_data::Landmark startingLandmark>
+[[nodiscard]] inline uint64_t Clearing<clearingTypeValue, initialSlotCount, hasRuinInitially, startingLandmark>::get_hash(uint64_t seed) const
+{
+    const uint8_t occupiedSlotCount = std::min(
+        read_bits<uint8_t, kOccupiedBuildingSlotCountOffset, kOccupiedBuildingSlotCountBits>(), kMaxBuildingSlotCount);
+    const uint16_t staleSlotsOffset = kBuildingSlotsOffset + occupiedSlotCount * kBuildingSlotBits;
+
+    // The dealt suit lives outside clearingData, boards with different deals must not collide
+    uint64_t hash = game_data::hash_combine(seed, static_cast<uint64_t>(clearingType));
+    hash = game_data::hash_bits(clearingData, kBuildingSlotCountOffset, staleSlotsOffset, hash);
+    return game_data::hash_bits<kTreetopIndexOffset, kUsedBits>(clearingData, hash);
+}
+
+template<ClearingType clearingTypeValue, uint8_t initialSlotCount, bool hasRuinInitially, landmark_data::Landmark startingLandmark>
+[[nodiscard]] inline bool Clearing<clearingTypeValue, initialSlotCount, hasRuinInitially, startingLandmark>::operator==(const Clearing &other) const
+{
+    const uint8_t occupiedSlotCount = std::min(
+        read_bits<uint8_t, kOccupiedBuildingSlotCountOffset, kOccupiedBuildingSlotCountBits>(), kMaxBuildingSlotCount);
+    const uint16_t staleSlotsOffset = kBuildingSlotsOffset + occupiedSlotCount * kBuildingSlotBits;
+
+    return
+        clearingType == other.clearingType &&
+        game_data::equal_bits(clearingData, other.clearingData, kBuildingSlotCountOffset, staleSlotsOffset) &&
+        game_data::equal_bits<kTreetopIndexOffset, kUsedBits>(clearingData, other.clearingData);
+}
 } // clearing_data
 } // board_data
 } // game_data
\ No newline at end of file
@@ -44,28 +44,21 @@ template <DeckType deckType>
 }
 
 template <DeckType deckType>
-[[nodiscard]] consteval std::expected<void, pile_data::PileError> Deck<deckType>::shuffle()
+[[nodiscard]] std::expected<void, pile_data::PileError> Deck<deckType>::shuffle()
 {
-    r123::Threefry2x32_R<12> rng;
-    const auto fetchResult = get_pile_contents();
+    auto fetchResult = get_pile_contents();
     [[unlikely]] if (!fetchResult)
-        return std::unexpected(fetchResult.error);
+        return std::unexpected(fetchResult.error());
 
-    auto& pile = fetchResult.value();
-
-    for (uint8_t i = pile.size() - 1; i > 0; --i) {
-        ++ctr[0];
-        auto rand = rng(ctr, key);
-        const uint8_t r = rand[0] % (i + 1);
-
-        std::swap(pile[i], pile[r]);       
-    }
+    std::vector<card_data::CardID> &pile = fetchResult.value();
+    for (size_t remaining = pile.size(); remaining > 1; --remaining)
+        std::swap(pile[remaining - 1], pile[rng.draw_below(static_cast<uint32_t>(remaining))]);
 
     return set_pile_contents(pile);
 }
 
 template <DeckType deckType>
-[[nodiscard]] inline consteval std::expected<void, pile_data::PileError> Deck<deckType>::turnover_discard(discard_pile_data::DiscardPile &discardPile) 
+[[nodiscard]] std::expected<void, pile_data::PileError> Deck<deckType>::turnover_discard(discard_pile_data::DiscardPile &discardPile) 
 {
     auto getDiscardResult = discardPile.get_pile_contents();
     [[unlikely]] if (!getDiscardResult)
@@ -12,9 +12,24 @@ template <typename FactionType, bool isAI>
 
 template <typename FactionType, bool isAI>
 inline void Faction<FactionType, isAI>::set_score(ExpandedScore newScore) {
+    static constexpr uint8_t kScoreMask = (1U << kScoreBits) - 1;
+    zobristKey += zobrist::kScoreKeys[static_cast<uint8_t>(newScore) & kScoreMask] - zobrist::kScoreKeys[static_cast<uint8_t>(get_score())];
     write_bits<ExpandedScore, kScoreOffset, kScoreBits>(newScore);
 }
 
+template <typename FactionType, bool isAI>
+[[nodiscard]] inline uint64_t Faction<FactionType, isAI>::get_hand_range_key(uint8_t begin, uint8_t end) const {
+    uint64_t key = 0;
+    for (uint8_t index = begin; index < std::min(end, kMaxHandSize); ++index)
+        key += zobrist::get_card_key(read_bits<card_data::CardID, card_data::kCardIDBits>(index * card_data::kCardIDBits + kHandContentOffset));
+    return key;
+}
+
+template <typename FactionType, bool isAI>
+[[nodiscard]] inline uint64_t Faction<FactionType, isAI>::compute_zobrist_key() const {
+    return zobrist::kScoreKeys[static_cast<uint8_t>(get_score())] + get_hand_range_key(0, get_hand_size());
+}
+
 
 template <typename FactionType, bool isAI>
 [[nodiscard]] inline uint8_t Faction<FactionType, isAI>::get_hand_size() const {
@@ -27,6 +42,8 @@ inline void Faction<FactionType, isAI>::set_hand_size(uint8_t newSize) {
     //     throw std::invalid_argument("New hand size cannot exceed maximum hand size");
     // }
 
+    const uint8_t oldSize = std::min(get_hand_size(), kMaxHandSize);
+    zobristKey += (newSize > oldSize) ? get_hand_range_key(oldSize, newSize) : -get_hand_range_key(newSize, oldSize);
     write_bits<uint8_t, kHandSizeOffset, kHandSizeBits>(newSize);
 }
 
@@ -34,7 +51,9 @@ template <typename FactionType, bool isAI>
 template <uint8_t newSize>
 inline void Faction<FactionType, isAI>::set_hand_size() {
     static_assert(newSize <= kMaxHandSize, "New hand size cannot exceed maximum hand size");
-    
+
+    const uint8_t oldSize = std::min(get_hand_size(), kMaxHandSize);
+    zobristKey += (newSize > oldSize) ? get_hand_range_key(oldSize, newSize) : -get_hand_range_key(newSize, oldSize);
     write_bits<uint8_t, kHandSizeOffset, kHandSizeBits>(newSize);
 }
 
@@ -101,6 +120,9 @@ void Faction<FactionType, isAI>::set_hand_contents(const std::vector<card_data::
     } /*else {
         throw std::invalid_argument("Hand size exceeds maximum");
     }*/
+
+    // Every card may have moved, so the key is rebuilt instead of patched
+    zobristKey = compute_zobrist_key();
 }
 
 template <typename FactionType, bool isAI>
@@ -164,6 +186,7 @@ void Faction<FactionType, isAI>::set_cards_in_hand(const std::vector<std::pair<u
             // bool handled = false;
             (((pair.first == Ns) ?
                 ([&] {
+                    zobristKey += zobrist::get_card_key(pair.second) - get_hand_range_key(Ns, Ns + 1);
                     write_bits<card_data::CardID, Ns * card_data::kCardIDBits + kHandContentOffset, card_data::kCardIDBits>(pair.second);
                     // handled = true;
                 }(), void()) : void()), ...);
@@ -180,6 +203,8 @@ void Faction<FactionType, isAI>::add_cards_to_hand(const std::vector<card_data::
     
     const uint8_t newCardsCount = newCards.size();
     const uint8_t oldHandSize = get_hand_size();
+    // Growing the hand keys whichever stale cards sat past the old size, so the key is patched once at the end
+    const uint64_t oldZobristKey = zobristKey;
     // [[unlikely]] if (newCardsCount + oldHandSize <= kMaxHandSize)
     //     throw std::invalid_argument("Attempted to add zero cards to hand");
 
@@ -224,6 +249,7 @@ void Faction<FactionType, isAI>::add_cards_to_hand(const std::vector<card_data::
         // Generate the sequence [0, 1, ..., kMaxHandSize] at compile time and call dispatch with it
         dispatch(std::make_index_sequence<kMaxHandSize - 1>{});
     }
+    zobristKey = oldZobristKey + zobrist::get_cards_key(newCards);
 }
 
 template <typename FactionType, bool isAI>
@@ -291,6 +317,22 @@ inline void Faction<FactionType, isAI>::discard_card_from_hand(::game_data::disc
     remove_cards_from_hand(cardIndex);
 }
 
+template <typename FactionType, bool isAI>
+[[nodiscard]] uint64_t Faction<FactionType, isAI>::get_hash(uint64_t seed) const
+{
+    const uint8_t handSize = std::min(get_hand_size(), kMaxHandSize);
+    const uint64_t hash = ::game_data::hash_bits(factionData, kScoreOffset, kHandContentOffset + handSize * card_data::kCardIDBits, seed);
+    return ::game_data::hash_bits<kHandTailOffset, get_used_bits()>(factionData, hash);
+}
+
+template <typename FactionType, bool isAI>
+[[nodiscard]] bool Faction<FactionType, isAI>::operator==(const Faction &other) const
+{
+    const uint8_t handSize = std::min(get_hand_size(), kMaxHandSize);
+    return
+        ::game_data::equal_bits(factionData, other.factionData, kScoreOffset, kHandContentOffset + handSize * card_data::kCardIDBits) &&
+        ::game_data::equal_bits<kHandTailOffset, get_used_bits()>(factionData, other.factionData);
+}
 
 } // faction_data
 } // game_data
\ No newline at end of file
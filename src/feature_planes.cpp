@@ -0,0 +1,183 @@
+#include "../include/feature_planes.hpp"
+
+#include <algorithm>
+#include <bit>
+
+namespace game_data
+{
+namespace board_data
+{
+namespace feature_planes
+{
+
+namespace
+{
+
+using Planes = std::array<LaneArray<uint8_t>, kTotalClearingPlanes>;
+
+// Multi source breadth first search over masks, one step per frontier instead of one per clearing
+[[nodiscard]] inline LaneArray<uint8_t> get_distances_to(ClearingMask targets, const AdjacencyMasks &adjacency)
+{
+    LaneArray<uint8_t> result{};
+    std::fill_n(result.begin(), kTotalClearings, static_cast<uint8_t>(kUnreachable));
+
+    ClearingMask reached = targets;
+    ClearingMask frontier = targets;
+    for (uint8_t distance = 0; frontier != 0; ++distance) {
+        for (ClearingMask remaining = frontier; remaining != 0; remaining &= remaining - 1)
+            result[std::countr_zero(remaining)] = distance;
+        frontier = get_neighbours(frontier, adjacency) & ~reached;
+        reached |= frontier;
+    }
+    return result;
+}
+
+inline void set_mask_plane(LaneArray<uint8_t> &plane, ClearingMask mask)
+{
+    for (uint8_t lane = 0; lane < kClearingLanes; ++lane)
+        plane[lane] = (mask >> lane) & 1;
+}
+
+// Fills every clearing plane as uint8_t lanes and the global features, leaving only the conversion to T
+void build_planes(
+    const FeatureInputs &inputs,
+    faction_data::FactionID perspective,
+    Planes &planes,
+    std::array<uint8_t, kTotalGlobalFeatures> &globals
+) {
+    using enum ClearingPlane;
+    const auto plane = [&planes](ClearingPlane index) -> LaneArray<uint8_t> & { return planes[static_cast<uint8_t>(index)]; };
+    const uint8_t perspectiveIndex = static_cast<uint8_t>(perspective);
+
+    planes = {};
+    globals = {};
+
+    for (uint8_t lane = 0; lane < kClearingLanes; ++lane) {
+        const uint8_t clearingType = inputs.clearingTypes[lane];
+        plane(kMouse)[lane] = clearingType == static_cast<uint8_t>(clearing_data::ClearingType::kMouse);
+        plane(kFox)[lane] = clearingType == static_cast<uint8_t>(clearing_data::ClearingType::kFox);
+        plane(kRabbit)[lane] = clearingType == static_cast<uint8_t>(clearing_data::ClearingType::kRabbit);
+    }
+    plane(kBuildingSlots) = inputs.buildingSlots;
+    plane(kOpenBuildingSlots) = inputs.openBuildingSlots;
+    set_mask_plane(plane(kRuin), inputs.ruins);
+    set_mask_plane(plane(kRazed), inputs.razed);
+    if (inputs.treetopClearing < kTotalClearings)
+        plane(kElderTreetop)[inputs.treetopClearing] = 1;
+
+    // Landmark bit i is Landmark i + 1, the planes follow the same order
+    for (uint8_t landmark = 0; landmark < clearing_data::landmark_data::kTotalLandmarks; ++landmark) {
+        LaneArray<uint8_t> &landmarkPlane = planes[static_cast<uint8_t>(kBlackMarket) + landmark];
+        for (uint8_t lane = 0; lane < kClearingLanes; ++lane)
+            landmarkPlane[lane] = (inputs.landmarkBits[lane] >> landmark) & 1;
+    }
+
+    const ForestIncidence &forests = forestIncidence[static_cast<size_t>(inputs.boardType)];
+    for (uint8_t clearing = 0; clearing < kTotalClearings; ++clearing) {
+        plane(kLandDegree)[clearing] = static_cast<uint8_t>(std::popcount(inputs.adjacency.land[clearing]));
+        plane(kWaterDegree)[clearing] = static_cast<uint8_t>(std::popcount(inputs.adjacency.water[clearing]));
+        plane(kForestDegree)[clearing] = static_cast<uint8_t>(std::popcount(forests.clearingForests[clearing]));
+    }
+
+    const pawn_histogram::PawnHistogram histogram(inputs.pawnWords);
+    for (uint8_t faction = 0; faction < kTotalPawnFactions; ++faction) {
+        planes[kFactionWarriorsPlane + faction] = histogram.get_counts(static_cast<faction_data::FactionID>(faction));
+        planes[kFactionPresencePlane + faction] = inputs.presence[faction];
+    }
+
+    const reachability::RuleMasks rule = reachability::compute_rule_masks(inputs.presence);
+    ClearingMask enemyRule = 0, enemyBuildings = 0;
+    for (uint8_t faction = 0; faction < kTotalPawnFactions; ++faction) {
+        set_mask_plane(planes[kFactionRulePlane + faction], rule[faction]);
+        if (faction != perspectiveIndex) {
+            enemyRule |= rule[faction];
+            enemyBuildings |= inputs.buildings[faction];
+        }
+    }
+
+    plane(kOwnPresence) = inputs.presence[perspectiveIndex];
+    plane(kEnemyWarriors) = histogram.get_enemy_counts(perspective);
+    set_mask_plane(plane(kRuledByPerspective), rule[perspectiveIndex]);
+    set_mask_plane(plane(kRuledByEnemy), enemyRule);
+
+    ClearingMask enemyWarriors = 0;
+    for (uint8_t lane = 0; lane < kTotalClearings; ++lane)
+        enemyWarriors |= static_cast<ClearingMask>((plane(kEnemyWarriors)[lane] != 0) << lane);
+    plane(kDistanceToEnemyBuilding) = get_distances_to(enemyBuildings, inputs.adjacency.land);
+    plane(kDistanceToEnemyWarriors) = get_distances_to(enemyWarriors, inputs.adjacency.land);
+
+    const auto global = [&globals](GlobalFeature feature) -> uint8_t & { return globals[static_cast<uint8_t>(feature)]; };
+    global(GlobalFeature::kRuinsRemaining) = static_cast<uint8_t>(std::popcount(inputs.ruins));
+    global(GlobalFeature::kRazedClearings) = static_cast<uint8_t>(std::popcount(inputs.razed));
+    globals[static_cast<uint8_t>(GlobalFeature::kBoardType) + static_cast<uint8_t>(inputs.boardType)] = 1;
+    globals[static_cast<uint8_t>(GlobalFeature::kPerspective) + perspectiveIndex] = 1;
+    for (uint8_t faction = 0; faction < kTotalPawnFactions; ++faction) {
+        uint16_t warriorsOnBoard = 0;
+        for (uint8_t lane = 0; lane < kClearingLanes; ++lane)
+            warriorsOnBoard += planes[kFactionWarriorsPlane + faction][lane];
+        globals[static_cast<uint8_t>(GlobalFeature::kWarriorsOnBoard) + faction] = static_cast<uint8_t>(std::min<uint16_t>(warriorsOnBoard, UINT8_MAX));
+        globals[static_cast<uint8_t>(GlobalFeature::kRuledClearings) + faction] = static_cast<uint8_t>(std::popcount(rule[faction]));
+    }
+}
+
+template <FeatureElement T>
+[[nodiscard]] inline T convert(uint8_t value)
+{
+    if constexpr (std::same_as<T, int8_t>)
+        return static_cast<int8_t>(std::min<uint8_t>(value, INT8_MAX));
+    else
+        return static_cast<T>(value);
+}
+
+template <FeatureElement T>
+inline void write_position(const FeatureInputs &inputs, faction_data::FactionID perspective, T *output)
+{
+    Planes planes;
+    std::array<uint8_t, kTotalGlobalFeatures> globals;
+    build_planes(inputs, perspective, planes, globals);
+
+    // Padding lanes are dropped here so the output is dense
+    for (uint8_t index = 0; index < kTotalClearingPlanes; ++index) {
+        T *row = output + size_t(index) * kTotalClearings;
+        for (uint8_t clearing = 0; clearing < kTotalClearings; ++clearing)
+            row[clearing] = convert<T>(planes[index][clearing]);
+    }
+    for (uint8_t feature = 0; feature < kTotalGlobalFeatures; ++feature)
+        output[kClearingFeatureSize + feature] = convert<T>(globals[feature]);
+}
+} // namespace
+
+template <FeatureElement T>
+[[nodiscard]] std::expected<void, EncodeError> encode(const FeatureInputs &inputs, faction_data::FactionID perspective, std::span<T> output)
+{
+    [[unlikely]] if (output.size() != kEncodedSize)
+        return std::unexpected(EncodeError{EncodeError::Code::kBufferSizeMismatch});
+
+    write_position(inputs, perspective, output.data());
+    return {};
+}
+
+template <FeatureElement T>
+[[nodiscard]] std::expected<void, EncodeError> encode_batch(
+    std::span<const FeatureInputs> inputs,
+    std::span<const faction_data::FactionID> perspectives,
+    std::span<T> output
+) {
+    [[unlikely]] if (perspectives.size() != inputs.size())
+        return std::unexpected(EncodeError{EncodeError::Code::kPerspectiveCountMismatch});
+
+    [[unlikely]] if (output.size() != inputs.size() * kEncodedSize)
+        return std::unexpected(EncodeError{EncodeError::Code::kBufferSizeMismatch});
+
+    for (size_t position = 0; position < inputs.size(); ++position)
+        write_position(inputs[position], perspectives[position], output.data() + position * kEncodedSize);
+    return {};
+}
+
+template std::expected<void, EncodeError> encode<float>(const FeatureInputs &, faction_data::FactionID, std::span<float>);
+template std::expected<void, EncodeError> encode<int8_t>(const FeatureInputs &, faction_data::FactionID, std::span<int8_t>);
+template std::expected<void, EncodeError> encode_batch<float>(std::span<const FeatureInputs>, std::span<const faction_data::FactionID>, std::span<float>);
+template std::expected<void, EncodeError> encode_batch<int8_t>(std::span<const FeatureInputs>, std::span<const faction_data::FactionID>, std::span<int8_t>);
+} // feature_planes
+} // board_data
+} // game_data
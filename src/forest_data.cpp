@@ -181,6 +181,16 @@ void Forest::set_is_vagabond_present(bool value)
 
     return write_bits<bool, kVagabondsOffset + kVagabondBits, kVagabondBits>(value);
 }
+
+[[nodiscard]] uint64_t Forest::get_hash(uint64_t seed) const
+{
+    return game_data::hash_bits<0, kUsedBits>(forestData, seed);
+}
+
+[[nodiscard]] bool Forest::operator==(const Forest &other) const
+{
+    return game_data::equal_bits<0, kUsedBits>(forestData, other.forestData);
+}
 } // forest_data
 } // board_data
 } // game_data
\ No newline at end of file
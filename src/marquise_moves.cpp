@@ -0,0 +1,61 @@
+#include "../include/marquise_moves.hpp"
+
+#include <algorithm>
+
+namespace game_data
+{
+namespace marquise_moves
+{
+
+namespace
+{
+
+[[nodiscard]] inline uint16_t sum_wood(ClearingMask clearings, const LaneArray<uint8_t> &wood)
+{
+    uint16_t total = 0;
+    for (ClearingMask remaining = clearings; remaining != 0; remaining &= remaining - 1)
+        total += wood[std::countr_zero(remaining)];
+    return total;
+}
+} // namespace
+
+AffordableSites get_affordable_sites(ClearingMask sites, ClearingMask ruled, const LaneArray<uint8_t> &wood, const AdjacencyMasks &adjacency)
+{
+    AffordableSites result{};
+    const board_data::ComponentList components = board_data::get_connected_components(adjacency, ruled);
+    for (uint8_t component = 0; component < components.count; ++component) {
+        const ClearingMask componentSites = components.components[component] & sites;
+        if (componentSites == 0)
+            continue;
+
+        const uint16_t total = sum_wood(components.components[component], wood);
+        for (uint8_t cost = 0; cost <= kMaxBuildCost && cost <= total; ++cost)
+            result[cost] |= componentSites;
+    }
+    return result;
+}
+
+LaneArray<uint8_t> plan_wood_payment(
+    uint8_t site,
+    uint8_t cost,
+    ClearingMask ruled,
+    const LaneArray<uint8_t> &wood,
+    const AdjacencyMasks &adjacency)
+{
+    LaneArray<uint8_t> result{};
+    ClearingMask reached = static_cast<ClearingMask>(1U << site);
+    ClearingMask ring = reached;
+    while (cost > 0 && ring != 0) {
+        for (ClearingMask remaining = ring; remaining != 0 && cost > 0; remaining &= remaining - 1) {
+            const uint8_t clearing = static_cast<uint8_t>(std::countr_zero(remaining));
+            const uint8_t taken = std::min(wood[clearing], cost);
+            result[clearing] = taken;
+            cost -= taken;
+        }
+        ring = board_data::get_neighbours(ring, adjacency) & ruled & ~reached;
+        reached |= ring;
+    }
+    return result;
+}
+} // marquise_moves
+} // game_data
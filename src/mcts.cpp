@@ -0,0 +1,200 @@
+#include "../include/mcts.hpp"
+
+#include <new>
+#include <queue>
+
+namespace game_data
+{
+namespace mcts
+{
+
+Tree::Tree(uint32_t capacity) : capacity(capacity) {}
+
+std::expected<Tree, SearchError> Tree::create(uint32_t capacity)
+{
+    [[unlikely]] if (capacity == 0 || capacity == UINT32_MAX)
+        return std::unexpected(SearchError{SearchError::Code::kTreeTooSmall});
+
+    Tree tree(capacity);
+    tree.nodes.reset(new (std::nothrow) Node[size_t(capacity) + 1]);
+    tree.actions.reset(new (std::nothrow) action::Action[capacity]);
+    tree.priors.reset(new (std::nothrow) float[capacity]);
+    tree.visits.reset(new (std::nothrow) std::atomic<uint32_t>[capacity]);
+    tree.virtualLosses.reset(new (std::nothrow) std::atomic<uint32_t>[capacity]);
+    tree.valueSums.reset(new (std::nothrow) std::atomic<float>[capacity]);
+    [[unlikely]] if (!tree.nodes || !tree.actions || !tree.priors || !tree.visits || !tree.virtualLosses || !tree.valueSums)
+        return std::unexpected(SearchError{SearchError::Code::kAllocationFailed});
+
+    tree.clear();
+    return tree;
+}
+
+Tree::Tree(Tree &&other) noexcept
+    : capacity(other.capacity),
+      edgeCount(other.edgeCount.load(std::memory_order_relaxed)),
+      nodes(std::move(other.nodes)),
+      actions(std::move(other.actions)),
+      priors(std::move(other.priors)),
+      visits(std::move(other.visits)),
+      virtualLosses(std::move(other.virtualLosses)),
+      valueSums(std::move(other.valueSums))
+{
+    other.capacity = 0;
+    other.edgeCount.store(0, std::memory_order_relaxed);
+}
+
+Tree &Tree::operator=(Tree &&other) noexcept
+{
+    if (this == &other)
+        return *this;
+
+    capacity = other.capacity;
+    edgeCount.store(other.edgeCount.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    nodes = std::move(other.nodes);
+    actions = std::move(other.actions);
+    priors = std::move(other.priors);
+    visits = std::move(other.visits);
+    virtualLosses = std::move(other.virtualLosses);
+    valueSums = std::move(other.valueSums);
+    other.capacity = 0;
+    other.edgeCount.store(0, std::memory_order_relaxed);
+    return *this;
+}
+
+void Tree::clear()
+{
+    edgeCount.store(0, std::memory_order_relaxed);
+    nodes[kRootNode].firstEdge = 0;
+    nodes[kRootNode].edgeCount = 0;
+    nodes[kRootNode].state.store(NodeState::kLeaf, std::memory_order_release);
+}
+
+bool Tree::allocate_edges(uint16_t count, EdgeIndex &firstEdge)
+{
+    uint32_t current = edgeCount.load(std::memory_order_relaxed);
+    do {
+        [[unlikely]] if (capacity - current < count)
+            return false;
+    } while (!edgeCount.compare_exchange_weak(current, current + count, std::memory_order_relaxed));
+    firstEdge = current;
+    return true;
+}
+
+bool Tree::expand(NodeIndex node, std::span<const action::Action> newActions, std::span<const float> newPriors)
+{
+    const uint16_t count = static_cast<uint16_t>(newActions.size());
+    EdgeIndex firstEdge = 0;
+    [[unlikely]] if (!allocate_edges(count, firstEdge))
+        return false;
+
+    for (uint16_t index = 0; index < count; ++index) {
+        const EdgeIndex edge = firstEdge + index;
+        actions[edge] = newActions[index];
+        priors[edge] = newPriors[index];
+        visits[edge].store(0, std::memory_order_relaxed);
+        virtualLosses[edge].store(0, std::memory_order_relaxed);
+        valueSums[edge].store(0.0f, std::memory_order_relaxed);
+
+        Node &child = nodes[get_child(edge)];
+        child.firstEdge = 0;
+        child.edgeCount = 0;
+        child.state.store(NodeState::kLeaf, std::memory_order_relaxed);
+    }
+
+    nodes[node].firstEdge = firstEdge;
+    nodes[node].edgeCount = count;
+    // Publishes the edges and children written above to every thread that sees the node expanded
+    nodes[node].state.store(NodeState::kExpanded, std::memory_order_release);
+    return true;
+}
+
+NodeIndex Tree::find_child(NodeIndex node, action::Action edgeAction) const
+{
+    if (get_state(node) != NodeState::kExpanded)
+        return kNoNode;
+
+    const EdgeIndex firstEdge = nodes[node].firstEdge;
+    for (EdgeIndex edge = firstEdge; edge < firstEdge + nodes[node].edgeCount; ++edge)
+        if (actions[edge] == edgeAction)
+            return get_child(edge);
+    return kNoNode;
+}
+
+void Tree::compact_into(Tree &destination, NodeIndex sourceRoot, uint32_t nodeBudget) const
+{
+    struct Pending
+    {
+        uint32_t visits;
+        NodeIndex source;
+        NodeIndex target;
+
+        [[nodiscard]] inline bool operator<(const Pending &other) const { return visits < other.visits; }
+    };
+
+    destination.clear();
+    std::priority_queue<Pending> pending;
+    pending.push({UINT32_MAX, sourceRoot, kRootNode});
+
+    // Nodes go out in visit order, so the busiest part of the tree also ends up packed at the front of the arena
+    while (!pending.empty()) {
+        const Pending next = pending.top();
+        pending.pop();
+
+        if (get_state(next.source) != NodeState::kExpanded)
+            continue;
+        const EdgeIndex sourceFirst = nodes[next.source].firstEdge;
+        const uint16_t count = nodes[next.source].edgeCount;
+        if (destination.get_node_count() + count > nodeBudget)
+            continue;
+        if (!destination.expand(next.target, std::span(actions.get() + sourceFirst, count), std::span(priors.get() + sourceFirst, count)))
+            continue;
+
+        const EdgeIndex targetFirst = destination.get_first_edge(next.target);
+        for (uint16_t index = 0; index < count; ++index) {
+            const uint32_t edgeVisits = get_visits(sourceFirst + index);
+            destination.visits[targetFirst + index].store(edgeVisits, std::memory_order_relaxed);
+            destination.valueSums[targetFirst + index].store(get_value_sum(sourceFirst + index), std::memory_order_relaxed);
+            if (edgeVisits != 0)
+                pending.push({edgeVisits, get_child(sourceFirst + index), get_child(targetFirst + index)});
+        }
+    }
+}
+
+float get_reward(const playout::PlayoutResult &result, uint8_t seat)
+{
+    if (result.winner != playout::kNoWinner)
+        return result.winner == seat ? 1.0f : 0.0f;
+    return 0.5f * float(std::min(result.scores[seat], playout::kWinningScore)) / float(playout::kWinningScore);
+}
+
+void determinize(
+    rng::RngStream &rng,
+    pile_data::PackedPile &deck,
+    uint64_t &deckKey,
+    std::span<game_state::FactionBlock> seats,
+    uint8_t observer,
+    uint64_t &stateKey
+)
+{
+    std::array<uint8_t, game_state::kMaxPlayers> handSizes{};
+    for (uint8_t seat = 0; seat < seats.size(); ++seat) {
+        if (seat == observer)
+            continue;
+
+        handSizes[seat] = playout::get_hand_size(seats[seat].data);
+        for (uint8_t remaining = handSizes[seat]; remaining > 0; --remaining) {
+            const card_data::CardID card = playout::get_card_in_hand(seats[seat].data, remaining - 1);
+            (void)playout::remove_card_from_hand(seats[seat], seat, card, stateKey);
+            (void)playout::push_card(deck, deckKey, zobrist::CardHolder::kDeck, card, stateKey);
+        }
+    }
+
+    playout::shuffle_pile(rng, deck);
+
+    for (uint8_t seat = 0; seat < seats.size(); ++seat)
+        for (uint8_t dealt = 0; dealt < handSizes[seat]; ++dealt)
+            if (const std::optional<card_data::CardID> card = playout::pop_card(deck, deckKey, zobrist::CardHolder::kDeck, stateKey))
+                (void)playout::add_card_to_hand(seats[seat], seat, card.value(), stateKey);
+}
+} // mcts
+} // game_data
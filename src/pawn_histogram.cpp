@@ -0,0 +1,103 @@
+#include "../include/pawn_histogram.hpp"
+
+namespace game_data
+{
+namespace board_data
+{
+namespace pawn_histogram
+{
+
+PawnHistogram::PawnHistogram(const PawnWords &pawnWords) : counts{}, totals{}
+{
+    using faction_data::FactionID;
+
+    for (uint8_t faction = 0; faction < kTotalPawnFactions; ++faction) {
+        const uint8_t dataIndex = (faction > static_cast<uint8_t>(FactionID::kLordOfTheHundreds)) ? faction + 1 : faction;
+        const clearing_data::PawnDataInfo info = clearing_data::kPawnDataInfoField[dataIndex];
+        const uint64_t mask = (uint64_t(1) << info.width) - 1;
+
+        for (uint8_t clearing = 0; clearing < kTotalClearings; ++clearing)
+            counts[faction][clearing] = static_cast<uint8_t>((pawnWords[clearing] >> info.offset) & mask);
+    }
+
+    // The warlord is a Lord of the Hundreds warrior in its own bit
+    constexpr clearing_data::PawnDataInfo kWarlordInfo = clearing_data::kPawnDataInfoField[clearing_data::kWarlordPawnDataIndex];
+    for (uint8_t clearing = 0; clearing < kTotalClearings; ++clearing)
+        counts[static_cast<uint8_t>(FactionID::kLordOfTheHundreds)][clearing] += (pawnWords[clearing] >> kWarlordInfo.offset) & 1;
+
+    for (uint8_t faction = 0; faction < kTotalPawnFactions; ++faction)
+        for (uint8_t lane = 0; lane < kClearingLanes; ++lane)
+            totals[lane] += counts[faction][lane];
+}
+
+[[nodiscard]] ClearingMask PawnHistogram::get_clearings_with_at_least(faction_data::FactionID factionID, uint8_t minimumCount) const
+{
+    const LaneArray<uint8_t> &row = counts[static_cast<uint8_t>(factionID)];
+
+    ClearingMask result = 0;
+    for (uint8_t lane = 0; lane < kClearingLanes; ++lane)
+        result |= static_cast<ClearingMask>(row[lane] >= minimumCount) << lane;
+
+    // Padding lanes hold zero, which passes a minimum of zero
+    return result & kAllClearingsMask;
+}
+
+[[nodiscard]] std::array<TopTwo, kTotalClearings> PawnHistogram::get_top_two() const
+{
+    LaneArray<uint8_t> firstCount{}, firstFaction{}, secondCount{}, secondFaction{};
+
+    // Strict comparisons keep the lower FactionID in front on ties since factions are visited in order
+    for (uint8_t faction = 0; faction < kTotalPawnFactions; ++faction) {
+        for (uint8_t lane = 0; lane < kClearingLanes; ++lane) {
+            const uint8_t count = counts[faction][lane];
+            const bool beatsFirst = count > firstCount[lane];
+            const bool beatsSecond = count > secondCount[lane];
+
+            secondCount[lane] = beatsFirst ? firstCount[lane] : (beatsSecond ? count : secondCount[lane]);
+            secondFaction[lane] = beatsFirst ? firstFaction[lane] : (beatsSecond ? faction : secondFaction[lane]);
+            firstCount[lane] = beatsFirst ? count : firstCount[lane];
+            firstFaction[lane] = beatsFirst ? faction : firstFaction[lane];
+        }
+    }
+
+    std::array<TopTwo, kTotalClearings> result;
+    for (uint8_t clearing = 0; clearing < kTotalClearings; ++clearing) {
+        result[clearing].places[0] = {static_cast<faction_data::FactionID>(firstFaction[clearing]), firstCount[clearing]};
+        result[clearing].places[1] = {static_cast<faction_data::FactionID>(secondFaction[clearing]), secondCount[clearing]};
+    }
+    return result;
+}
+
+[[nodiscard]] LaneArray<uint8_t> PawnHistogram::get_enemy_counts(faction_data::FactionID factionID) const
+{
+    const LaneArray<uint8_t> &row = counts[static_cast<uint8_t>(factionID)];
+
+    LaneArray<uint8_t> result;
+    for (uint8_t lane = 0; lane < kClearingLanes; ++lane)
+        result[lane] = totals[lane] - row[lane];
+    return result;
+}
+
+[[nodiscard]] LaneArray<uint16_t> PawnHistogram::get_adjacent_enemy_counts(faction_data::FactionID factionID, const std::array<ClearingMask, kTotalClearings> &adjacency) const
+{
+    const LaneArray<uint8_t> enemyCounts = get_enemy_counts(factionID);
+
+    LaneArray<uint16_t> result{};
+    for (uint8_t neighbour = 0; neighbour < kTotalClearings; ++neighbour)
+        for (uint8_t clearing = 0; clearing < kTotalClearings; ++clearing)
+            result[clearing] += ((adjacency[clearing] >> neighbour) & 1) ? enemyCounts[neighbour] : 0;
+    return result;
+}
+
+[[nodiscard]] uint16_t PawnHistogram::get_enemy_count_in(faction_data::FactionID factionID, ClearingMask clearings) const
+{
+    const LaneArray<uint8_t> enemyCounts = get_enemy_counts(factionID);
+
+    uint16_t result = 0;
+    for (uint8_t lane = 0; lane < kClearingLanes; ++lane)
+        result += ((clearings >> lane) & 1) ? enemyCounts[lane] : 0;
+    return result;
+}
+} // pawn_histogram
+} // board_data
+} // game_data
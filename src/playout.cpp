@@ -0,0 +1,185 @@
+#include "../include/playout.hpp"
+
+namespace game_data
+{
+namespace playout
+{
+
+namespace
+{
+
+// Score and hand sit at the same offsets for every faction, so any faction's layout reads them
+using HandLayout = faction_data::Faction<faction_data::MarquiseDeCatFaction<false>, false>;
+using PileLayout = pile_data::CardPile;
+
+static constexpr uint8_t kMaxScore = (1U << HandLayout::kScoreBits) - 1;
+
+[[nodiscard]] inline uint16_t get_hand_card_offset(uint8_t index)
+{
+    return static_cast<uint16_t>(HandLayout::kHandContentOffset + index * card_data::kCardIDBits);
+}
+
+[[nodiscard]] inline uint16_t get_pile_card_offset(uint8_t index)
+{
+    return static_cast<uint16_t>(PileLayout::kPileContentOffset + index * card_data::kCardIDBits);
+}
+
+[[nodiscard]] inline card_data::CardID read_pile_card(const pile_data::PackedPile &pile, uint8_t index)
+{
+    return ::game_data::read_bits<card_data::CardID, sizeof(pile_data::PackedPile), card_data::kCardIDBits>(pile, get_pile_card_offset(index))
+        .value_or(card_data::CardID{});
+}
+
+inline void write_pile_card(pile_data::PackedPile &pile, uint8_t index, card_data::CardID card)
+{
+    (void)::game_data::write_bits<card_data::CardID, sizeof(pile_data::PackedPile), card_data::kCardIDBits>(pile, card, get_pile_card_offset(index));
+}
+
+inline void set_hand_size(faction_data::PackedFaction &data, uint8_t newSize)
+{
+    ::game_data::write_bits<uint8_t, faction_data::kFactionDataBytes, HandLayout::kHandSizeOffset, HandLayout::kHandSizeBits>(data, newSize);
+}
+
+inline void set_pile_size(pile_data::PackedPile &pile, uint8_t newSize)
+{
+    ::game_data::write_bits<uint8_t, sizeof(pile_data::PackedPile), PileLayout::kPileSizeOffset, PileLayout::kPileSizeBits>(pile, newSize);
+}
+} // namespace
+
+uint8_t get_score(const faction_data::PackedFaction &data)
+{
+    return ::game_data::read_bits<uint8_t, faction_data::kFactionDataBytes, HandLayout::kScoreOffset, HandLayout::kScoreBits>(data);
+}
+
+void add_score(game_state::FactionBlock &faction, uint8_t seat, uint8_t points, uint64_t &stateKey)
+{
+    const uint8_t oldScore = get_score(faction.data);
+    const uint8_t newScore = static_cast<uint8_t>(std::min<uint16_t>(oldScore + points, kMaxScore));
+    faction.zobristKey += zobrist::kScoreKeys[newScore] - zobrist::kScoreKeys[oldScore];
+    stateKey += zobrist::kSeatScoreKeys[seat][newScore] - zobrist::kSeatScoreKeys[seat][oldScore];
+    ::game_data::write_bits<uint8_t, faction_data::kFactionDataBytes, HandLayout::kScoreOffset, HandLayout::kScoreBits>(faction.data, newScore);
+}
+
+uint8_t get_hand_size(const faction_data::PackedFaction &data)
+{
+    return std::min(
+        ::game_data::read_bits<uint8_t, faction_data::kFactionDataBytes, HandLayout::kHandSizeOffset, HandLayout::kHandSizeBits>(data),
+        HandLayout::kMaxHandSize);
+}
+
+card_data::CardID get_card_in_hand(const faction_data::PackedFaction &data, uint8_t index)
+{
+    return ::game_data::read_bits<card_data::CardID, faction_data::kFactionDataBytes, card_data::kCardIDBits>(data, get_hand_card_offset(index))
+        .value_or(card_data::CardID{});
+}
+
+bool add_card_to_hand(game_state::FactionBlock &faction, uint8_t seat, card_data::CardID card, uint64_t &stateKey)
+{
+    const uint8_t handSize = get_hand_size(faction.data);
+    [[unlikely]] if (handSize == HandLayout::kMaxHandSize)
+        return false;
+
+    (void)::game_data::write_bits<card_data::CardID, faction_data::kFactionDataBytes, card_data::kCardIDBits>(faction.data, card, get_hand_card_offset(handSize));
+    set_hand_size(faction.data, handSize + 1);
+    faction.zobristKey += zobrist::get_card_key(card);
+    stateKey += zobrist::get_held_card_key(zobrist::get_seat_holder(seat), card);
+    return true;
+}
+
+bool remove_card_from_hand(game_state::FactionBlock &faction, uint8_t seat, card_data::CardID card, uint64_t &stateKey)
+{
+    const uint8_t handSize = get_hand_size(faction.data);
+    for (uint8_t index = 0; index < handSize; ++index) {
+        if (get_card_in_hand(faction.data, index) != card)
+            continue;
+
+        const card_data::CardID last = get_card_in_hand(faction.data, handSize - 1);
+        (void)::game_data::write_bits<card_data::CardID, faction_data::kFactionDataBytes, card_data::kCardIDBits>(faction.data, last, get_hand_card_offset(index));
+        set_hand_size(faction.data, handSize - 1);
+        faction.zobristKey -= zobrist::get_card_key(card);
+        stateKey -= zobrist::get_held_card_key(zobrist::get_seat_holder(seat), card);
+        return true;
+    }
+    return false;
+}
+
+uint8_t get_pile_size(const pile_data::PackedPile &pile)
+{
+    return std::min(
+        ::game_data::read_bits<uint8_t, sizeof(pile_data::PackedPile), PileLayout::kPileSizeOffset, PileLayout::kPileSizeBits>(pile),
+        card_data::kTotalCards);
+}
+
+std::optional<card_data::CardID> pop_card(pile_data::PackedPile &pile, uint64_t &zobristKey, zobrist::CardHolder holder, uint64_t &stateKey)
+{
+    const uint8_t pileSize = get_pile_size(pile);
+    if (pileSize == 0)
+        return std::nullopt;
+
+    const card_data::CardID card = read_pile_card(pile, pileSize - 1);
+    set_pile_size(pile, pileSize - 1);
+    zobristKey -= zobrist::get_card_key(card);
+    stateKey -= zobrist::get_held_card_key(holder, card);
+    return card;
+}
+
+bool push_card(pile_data::PackedPile &pile, uint64_t &zobristKey, zobrist::CardHolder holder, card_data::CardID card, uint64_t &stateKey)
+{
+    const uint8_t pileSize = get_pile_size(pile);
+    [[unlikely]] if (pileSize == card_data::kTotalCards)
+        return false;
+
+    write_pile_card(pile, pileSize, card);
+    set_pile_size(pile, pileSize + 1);
+    zobristKey += zobrist::get_card_key(card);
+    stateKey += zobrist::get_held_card_key(holder, card);
+    return true;
+}
+
+void shuffle_pile(rng::RngStream &rng, pile_data::PackedPile &pile)
+{
+    for (uint8_t index = get_pile_size(pile); index > 1; --index) {
+        const uint8_t swapIndex = static_cast<uint8_t>(rng.draw_below(index));
+        const card_data::CardID card = read_pile_card(pile, index - 1);
+        write_pile_card(pile, index - 1, read_pile_card(pile, swapIndex));
+        write_pile_card(pile, swapIndex, card);
+    }
+}
+
+void reshuffle_discard(
+    rng::RngStream &rng,
+    pile_data::PackedPile &deck,
+    uint64_t &deckKey,
+    pile_data::PackedPile &discard,
+    uint64_t &discardKey,
+    uint64_t &stateKey
+)
+{
+    while (const std::optional<card_data::CardID> card = pop_card(discard, discardKey, zobrist::CardHolder::kDiscard, stateKey))
+        (void)push_card(deck, deckKey, zobrist::CardHolder::kDeck, card.value(), stateKey);
+    shuffle_pile(rng, deck);
+}
+
+action::Action select_action(const action::ActionList &actions, Policy policy, rng::RngStream &rng)
+{
+    // A forced action costs no draw
+    if (actions.size() == 1)
+        return actions[0];
+    if (policy == Policy::kUniform)
+        return actions[rng.draw_below(static_cast<uint32_t>(actions.size()))];
+
+    uint32_t totalWeight = 0;
+    for (const action::Action candidate : actions)
+        totalWeight += kHeuristicWeights[static_cast<size_t>(candidate.get_verb())];
+
+    uint32_t pick = rng.draw_below(totalWeight);
+    for (const action::Action candidate : actions) {
+        const uint8_t weight = kHeuristicWeights[static_cast<size_t>(candidate.get_verb())];
+        if (pick < weight)
+            return candidate;
+        pick -= weight;
+    }
+    return actions[actions.size() - 1];
+}
+} // playout
+} // game_data
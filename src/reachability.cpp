@@ -0,0 +1,78 @@
+#include "../include/reachability.hpp"
+
+namespace game_data
+{
+namespace board_data
+{
+namespace reachability
+{
+
+[[nodiscard]] RuleMasks compute_rule_masks(const PresenceCounts &presence)
+{
+    using faction_data::FactionID;
+
+    LaneArray<uint8_t> bestCount{}, bestFaction{}, tied{};
+    for (uint8_t faction = 0; faction < kTotalPawnFactions; ++faction) {
+        // Vagabonds never rule and never break a tie
+        if (faction == static_cast<uint8_t>(FactionID::kVagabond1) || faction == static_cast<uint8_t>(FactionID::kVagabond2))
+            continue;
+
+        for (uint8_t lane = 0; lane < kTotalClearings; ++lane) {
+            const uint8_t count = presence[faction][lane];
+            const bool beatsBest = count > bestCount[lane];
+            const bool tiesBest = count == bestCount[lane];
+
+            tied[lane] = beatsBest ? 0 : (tiesBest ? 1 : tied[lane]);
+            bestFaction[lane] = beatsBest ? faction : bestFaction[lane];
+            bestCount[lane] = beatsBest ? count : bestCount[lane];
+        }
+    }
+
+    constexpr uint8_t kEyrie = static_cast<uint8_t>(FactionID::kEyrieDynasty);
+
+    RuleMasks result{};
+    for (uint8_t lane = 0; lane < kTotalClearings; ++lane) {
+        if (bestCount[lane] == 0)
+            continue;
+
+        const bool eyrieLeads = presence[kEyrie][lane] == bestCount[lane];
+        const uint8_t ruler = eyrieLeads ? kEyrie : (tied[lane] ? kNoOwner : bestFaction[lane]);
+        if (ruler != kNoOwner)
+            result[ruler] |= static_cast<ClearingMask>(1U << lane);
+    }
+    return result;
+}
+
+[[nodiscard]] ReachResult get_reachable(
+    faction_data::FactionID factionID,
+    ClearingMask sources,
+    uint8_t moves,
+    const RuleMasks &rule,
+    const pawn_histogram::PawnHistogram &histogram,
+    const AdjacencyMasks &ruledAdjacency,
+    const AdjacencyMasks &freeAdjacency
+) {
+    const ClearingMask ruled = rule[static_cast<uint8_t>(factionID)];
+    const LaneArray<uint8_t> &warriors = histogram.get_counts(factionID);
+
+    ReachResult result{};
+    for (ClearingMask remaining = sources & kAllClearingsMask; remaining != 0; remaining &= remaining - 1) {
+        const uint8_t source = static_cast<uint8_t>(std::countr_zero(remaining));
+
+        ClearingMask reached = static_cast<ClearingMask>(1U << source);
+        ClearingMask frontier = reached;
+        for (uint8_t move = 0; move < moves && frontier != 0; ++move) {
+            frontier = get_move_step(frontier, ruled, ruledAdjacency, freeAdjacency) & ~reached;
+            reached |= frontier;
+        }
+
+        result.bySource[source] = reached;
+        result.reachable |= reached;
+        for (uint8_t lane = 0; lane < kTotalClearings; ++lane)
+            result.arrivals[lane] += ((reached >> lane) & 1) ? warriors[source] : 0;
+    }
+    return result;
+}
+} // reachability
+} // board_data
+} // game_data
@@ -0,0 +1,20 @@
+#include "../include/suit_setup.hpp"
+
+namespace game_data
+{
+namespace board_data
+{
+namespace suit_setup
+{
+
+SuitSetupStream::SuitSetupStream(uint64_t seed, uint32_t gameID)
+    : stream(seed, gameID, ::game_data::rng::Stream::kSuitSetup)
+{}
+
+[[nodiscard]] PackedSuitSetup SuitSetupStream::next()
+{
+    return unrank_suit_setup(stream.draw_below(kTotalSuitSetups));
+}
+} // suit_setup
+} // board_data
+} // game_data
@@ -0,0 +1,244 @@
+#include "../include/task_scheduler.hpp"
+
+#include <algorithm>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace game_data
+{
+namespace task
+{
+
+namespace
+{
+
+thread_local void *currentWorker = nullptr;
+
+inline void pause_briefly()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#else
+    std::this_thread::yield();
+#endif
+}
+
+// Pins the calling thread. Best effort, a refused request leaves the thread free to move
+void pin_to_core(uint8_t workerIndex)
+{
+#if defined(__linux__)
+    const unsigned coreCount = std::max(std::thread::hardware_concurrency(), 1U);
+    cpu_set_t cores;
+    CPU_ZERO(&cores);
+    CPU_SET(workerIndex % coreCount, &cores);
+    (void)pthread_setaffinity_np(pthread_self(), sizeof(cores), &cores);
+#else
+    (void)workerIndex;
+#endif
+}
+} // namespace
+
+std::expected<Arena, SchedulerError> Arena::create(size_t capacity)
+{
+    Arena arena;
+    arena.storage.reset(new (std::nothrow) std::byte[capacity]);
+    [[unlikely]] if (capacity != 0 && !arena.storage)
+        return std::unexpected(SchedulerError{SchedulerError::Code::kAllocationFailed});
+    arena.capacity = capacity;
+    return arena;
+}
+
+bool WorkStealingDeque::push(Task *task)
+{
+    const int64_t bottomIndex = bottom.load(std::memory_order_relaxed);
+    const int64_t topIndex = top.load(std::memory_order_acquire);
+    [[unlikely]] if (bottomIndex - topIndex >= int64_t(kCapacity))
+        return false;
+
+    slots[bottomIndex & kMask].store(task, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    bottom.store(bottomIndex + 1, std::memory_order_relaxed);
+    return true;
+}
+
+Task *WorkStealingDeque::pop()
+{
+    const int64_t bottomIndex = bottom.load(std::memory_order_relaxed) - 1;
+    bottom.store(bottomIndex, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t topIndex = top.load(std::memory_order_relaxed);
+
+    if (topIndex > bottomIndex) {
+        bottom.store(bottomIndex + 1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    Task *task = slots[bottomIndex & kMask].load(std::memory_order_relaxed);
+    // Last task left, thieves may be after it too
+    if (topIndex == bottomIndex) {
+        if (!top.compare_exchange_strong(topIndex, topIndex + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            task = nullptr;
+        bottom.store(bottomIndex + 1, std::memory_order_relaxed);
+    }
+    return task;
+}
+
+Task *WorkStealingDeque::steal()
+{
+    int64_t topIndex = top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const int64_t bottomIndex = bottom.load(std::memory_order_acquire);
+    if (topIndex >= bottomIndex)
+        return nullptr;
+
+    Task *task = slots[topIndex & kMask].load(std::memory_order_relaxed);
+    if (!top.compare_exchange_strong(topIndex, topIndex + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+        return nullptr;
+    return task;
+}
+
+std::expected<std::unique_ptr<TaskScheduler>, SchedulerError> TaskScheduler::create(const SchedulerConfig &config)
+{
+    [[unlikely]] if (config.workerCount == 0)
+        return std::unexpected(SchedulerError{SchedulerError::Code::kNoWorkers});
+
+    std::unique_ptr<TaskScheduler> scheduler(new (std::nothrow) TaskScheduler(config.mode));
+    [[unlikely]] if (!scheduler)
+        return std::unexpected(SchedulerError{SchedulerError::Code::kAllocationFailed});
+
+    // Serial mode never leaves the calling thread, one worker holds its context
+    const uint8_t workerCount = config.mode == Mode::kSerial ? 1 : config.workerCount;
+    scheduler->workers.reserve(workerCount);
+    for (uint8_t index = 0; index < workerCount; ++index) {
+        std::unique_ptr<Worker> worker(new (std::nothrow) Worker);
+        [[unlikely]] if (!worker)
+            return std::unexpected(SchedulerError{SchedulerError::Code::kAllocationFailed});
+
+        auto arena = Arena::create(config.arenaBytes);
+        [[unlikely]] if (!arena.has_value())
+            return std::unexpected(arena.error());
+
+        worker->context.index = index;
+        worker->context.rng = rng::RngStream(config.seed, 0, rng::Stream::kWorkers).split(index);
+        worker->context.arena = std::move(arena.value());
+        worker->owner = scheduler.get();
+        worker->victim = static_cast<uint8_t>((index + 1) % workerCount);
+        scheduler->workers.push_back(std::move(worker));
+    }
+
+    currentWorker = scheduler->workers[0].get();
+    for (uint8_t index = 1; index < workerCount; ++index) {
+        Worker &worker = *scheduler->workers[index];
+        worker.thread = std::thread(&TaskScheduler::worker_loop, scheduler.get(), std::ref(worker), config.pinThreads);
+    }
+    return scheduler;
+}
+
+TaskScheduler::~TaskScheduler()
+{
+    if (!workers.empty())
+        wait_detached();
+
+    isStopping.store(true, std::memory_order_release);
+    wakeEpoch.fetch_add(1, std::memory_order_release);
+    wakeEpoch.notify_all();
+    for (std::unique_ptr<Worker> &worker : workers)
+        if (worker->thread.joinable())
+            worker->thread.join();
+
+    if (!workers.empty() && currentWorker == workers[0].get())
+        currentWorker = nullptr;
+}
+
+TaskScheduler::Worker &TaskScheduler::get_current_worker()
+{
+    Worker *worker = static_cast<Worker *>(currentWorker);
+    if (worker != nullptr && worker->owner == this)
+        return *worker;
+    return *workers[0];
+}
+
+void TaskScheduler::submit(Worker &self, Task &task)
+{
+    [[unlikely]] if (!self.deque.push(&task)) {
+        run_task(self, task);
+        return;
+    }
+
+    // Pairs with the sleeper count going up before a worker's last look at the deques: either the sleeper sees this
+    // task or this sees the sleeper
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (sleeperCount.load(std::memory_order_relaxed) != 0) {
+        wakeEpoch.fetch_add(1, std::memory_order_release);
+        wakeEpoch.notify_one();
+    }
+}
+
+void TaskScheduler::run_task(Worker &self, Task &task)
+{
+    // The task may live in the frame of whoever waits on it, so it is not touched after the count drops
+    std::atomic<uint32_t> *pending = task.pending;
+    task.execute(task, self.context);
+    if (pending != nullptr)
+        pending->fetch_sub(1, std::memory_order_acq_rel);
+}
+
+bool TaskScheduler::try_run_one(Worker &self)
+{
+    if (Task *task = self.deque.pop()) {
+        run_task(self, *task);
+        return true;
+    }
+
+    const uint8_t workerCount = get_worker_count();
+    for (uint8_t attempt = 0; attempt < workerCount; ++attempt) {
+        Worker &victim = *workers[self.victim];
+        self.victim = static_cast<uint8_t>((self.victim + 1) % workerCount);
+        if (&victim == &self)
+            continue;
+        if (Task *task = victim.deque.steal()) {
+            run_task(self, *task);
+            return true;
+        }
+    }
+    return false;
+}
+
+void TaskScheduler::wait(Worker &self, const std::atomic<uint32_t> &pending)
+{
+    while (pending.load(std::memory_order_acquire) != 0)
+        if (!try_run_one(self))
+            pause_briefly();
+}
+
+void TaskScheduler::worker_loop(Worker &self, bool pinThread)
+{
+    currentWorker = &self;
+    if (pinThread)
+        pin_to_core(self.context.index);
+
+    uint32_t idleRounds = 0;
+    while (!isStopping.load(std::memory_order_acquire)) {
+        if (try_run_one(self)) {
+            idleRounds = 0;
+            continue;
+        }
+        if (++idleRounds < kSpinRounds) {
+            pause_briefly();
+            continue;
+        }
+
+        const uint32_t seenEpoch = wakeEpoch.load(std::memory_order_acquire);
+        sleeperCount.fetch_add(1, std::memory_order_seq_cst);
+        const bool foundWork = try_run_one(self);
+        if (!foundWork && !isStopping.load(std::memory_order_acquire))
+            wakeEpoch.wait(seenEpoch, std::memory_order_acquire);
+        sleeperCount.fetch_sub(1, std::memory_order_relaxed);
+        idleRounds = 0;
+    }
+}
+} // task
+} // game_data
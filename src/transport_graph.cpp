@@ -0,0 +1,59 @@
+#include "../include/transport_graph.hpp"
+
+#include <bit>
+
+namespace game_data
+{
+namespace board_data
+{
+namespace transport_graph
+{
+
+TransportGraph::TransportGraph(BoardType boardType, uint8_t ferryClearing) :
+    adjacency(clearingAdjacency[static_cast<size_t>(boardType)]),
+    landAndFerry(adjacency.land),
+    allTransport(adjacency.any)
+{
+    ClearingMask riverClearings = 0;
+    for (uint8_t clearing = 0; clearing < kTotalClearings; ++clearing)
+        riverClearings |= static_cast<ClearingMask>((adjacency.water[clearing] != 0) << clearing);
+
+    riverComponents = get_connected_components(adjacency.water, riverClearings);
+    for (uint8_t component = 0; component < riverComponents.count; ++component)
+        for (ClearingMask members = riverComponents.components[component]; members != 0; members &= members - 1)
+            riverComponentOf[std::countr_zero(members)] = riverComponents.components[component];
+
+    move_ferry(ferryClearing);
+}
+
+void TransportGraph::set_ferry_edges(uint8_t clearingIndex, bool present)
+{
+    const ClearingMask clearingBit = static_cast<ClearingMask>(1U << clearingIndex);
+    const ClearingMask destinations = adjacency.water[clearingIndex];
+
+    ferryAdjacency[clearingIndex] = present ? destinations : 0;
+    for (ClearingMask remaining = destinations; remaining != 0; remaining &= remaining - 1) {
+        const uint8_t destination = static_cast<uint8_t>(std::countr_zero(remaining));
+        ferryAdjacency[destination] = present ? (ferryAdjacency[destination] | clearingBit) : (ferryAdjacency[destination] & ~clearingBit);
+    }
+
+    // Only the touched rows can differ from the static graphs
+    for (ClearingMask rows = destinations | clearingBit; rows != 0; rows &= rows - 1) {
+        const uint8_t row = static_cast<uint8_t>(std::countr_zero(rows));
+        landAndFerry[row] = adjacency.land[row] | ferryAdjacency[row];
+        allTransport[row] = adjacency.any[row] | ferryAdjacency[row];
+    }
+}
+
+void TransportGraph::move_ferry(uint8_t newFerryClearing)
+{
+    if (ferryClearing != kNoClearing)
+        set_ferry_edges(ferryClearing, false);
+
+    ferryClearing = (newFerryClearing < kTotalClearings) ? newFerryClearing : kNoClearing;
+    if (ferryClearing != kNoClearing)
+        set_ferry_edges(ferryClearing, true);
+}
+} // transport_graph
+} // board_data
+} // game_data
@@ -0,0 +1,226 @@
+#include "../include/transposition_table.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstdlib>
+#include <utility>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+namespace game_data
+{
+namespace transposition_table
+{
+
+namespace
+{
+
+// Info word: best action in the low 32 bits, then depth, then the search it was written in, then the occupied flag
+static constexpr uint8_t kDepthShift = 32;
+static constexpr uint8_t kGenerationShift = 40;
+static constexpr uint64_t kOccupiedBit = 1ULL << 48;
+
+static constexpr size_t kHugePageSize = size_t(2) << 20;
+static constexpr size_t kFillSampleBuckets = 1000;
+
+[[nodiscard]] inline uint64_t pack_stats(const TableEntry &entry)
+{
+    return entry.visits | (uint64_t(std::bit_cast<uint32_t>(entry.value)) << 32);
+}
+
+[[nodiscard]] inline uint64_t pack_info(const TableEntry &entry, uint8_t generation)
+{
+    return entry.bestAction | (uint64_t(entry.depth) << kDepthShift) | (uint64_t(generation) << kGenerationShift) | kOccupiedBit;
+}
+
+[[nodiscard]] inline uint8_t get_depth(uint64_t info) { return static_cast<uint8_t>(info >> kDepthShift); }
+[[nodiscard]] inline uint8_t get_generation(uint64_t info) { return static_cast<uint8_t>(info >> kGenerationShift); }
+
+// Lower is evicted first. Every search since the entry was written costs it kAgeWeight of depth
+[[nodiscard]] inline int get_replacement_score(uint64_t info, uint8_t generation)
+{
+    const uint8_t age = static_cast<uint8_t>(generation - get_generation(info));
+    return int(get_depth(info)) - int(TranspositionTable::kAgeWeight) * int(age);
+}
+
+// Tries explicit huge pages first, then asks for transparent ones on a normal mapping. The pages come back zeroed
+[[nodiscard]] void *allocate_buckets(size_t size, bool useHugePages, bool &isUsingHugePages)
+{
+    isUsingHugePages = false;
+#if defined(__linux__)
+    if (useHugePages && size % kHugePageSize == 0) {
+        void *memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (memory != MAP_FAILED) {
+            isUsingHugePages = true;
+            return memory;
+        }
+    }
+
+    void *memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    [[unlikely]] if (memory == MAP_FAILED)
+        return nullptr;
+    if (useHugePages)
+        isUsingHugePages = madvise(memory, size, MADV_HUGEPAGE) == 0;
+    return memory;
+#else
+    (void)useHugePages;
+    return std::aligned_alloc(64, size);
+#endif
+}
+
+inline void free_buckets(void *memory, size_t size)
+{
+    if (memory == nullptr)
+        return;
+#if defined(__linux__)
+    munmap(memory, size);
+#else
+    (void)size;
+    std::free(memory);
+#endif
+}
+} // namespace
+
+std::expected<TranspositionTable, TableError> TranspositionTable::create(size_t sizeInBytes, bool useHugePages)
+{
+    [[unlikely]] if (sizeInBytes < sizeof(Bucket))
+        return std::unexpected(TableError{TableError::Code::kTooSmall});
+
+    const size_t bucketCount = std::bit_floor(sizeInBytes / sizeof(Bucket));
+    const size_t allocationSize = bucketCount * sizeof(Bucket);
+
+    bool isUsingHugePages = false;
+    void *memory = allocate_buckets(allocationSize, useHugePages, isUsingHugePages);
+    [[unlikely]] if (memory == nullptr)
+        return std::unexpected(TableError{TableError::Code::kAllocationFailed});
+
+    TranspositionTable table(static_cast<Bucket *>(memory), bucketCount, allocationSize, isUsingHugePages);
+#if !defined(__linux__)
+    table.clear();
+#endif
+    return table;
+}
+
+TranspositionTable::TranspositionTable(Bucket *buckets, size_t bucketCount, size_t allocationSize, bool isUsingHugePages)
+    : buckets(buckets), bucketMask(bucketCount - 1), allocationSize(allocationSize), isUsingHugePages(isUsingHugePages) {}
+
+TranspositionTable::TranspositionTable(TranspositionTable &&other) noexcept
+    : buckets(std::exchange(other.buckets, nullptr)),
+      bucketMask(std::exchange(other.bucketMask, 0)),
+      allocationSize(std::exchange(other.allocationSize, 0)),
+      isUsingHugePages(std::exchange(other.isUsingHugePages, false)),
+      generation(other.generation) {}
+
+TranspositionTable &TranspositionTable::operator=(TranspositionTable &&other) noexcept
+{
+    if (this != &other) {
+        free_buckets(buckets, allocationSize);
+        buckets = std::exchange(other.buckets, nullptr);
+        bucketMask = std::exchange(other.bucketMask, 0);
+        allocationSize = std::exchange(other.allocationSize, 0);
+        isUsingHugePages = std::exchange(other.isUsingHugePages, false);
+        generation = other.generation;
+    }
+    return *this;
+}
+
+TranspositionTable::~TranspositionTable()
+{
+    free_buckets(buckets, allocationSize);
+}
+
+std::optional<TableEntry> TranspositionTable::probe(uint64_t key, TableStats &stats) const
+{
+    ++stats.probes;
+    const Bucket &bucket = buckets[key & bucketMask];
+
+    bool isBucketFull = true;
+    for (const Entry &entry : bucket.entries) {
+        const uint64_t check = entry.check.load(std::memory_order_relaxed);
+        const uint64_t packedStats = entry.stats.load(std::memory_order_relaxed);
+        const uint64_t info = entry.info.load(std::memory_order_relaxed);
+        if (!(info & kOccupiedBit)) {
+            isBucketFull = false;
+            continue;
+        }
+        if ((check ^ packedStats ^ info) != key)
+            continue;
+
+        ++stats.hits;
+        return TableEntry{
+            .visits = static_cast<uint32_t>(packedStats),
+            .value = std::bit_cast<float>(static_cast<uint32_t>(packedStats >> 32)),
+            .bestAction = static_cast<uint32_t>(info),
+            .depth = get_depth(info)
+        };
+    }
+
+    if (isBucketFull)
+        ++stats.probeCollisions;
+    return std::nullopt;
+}
+
+void TranspositionTable::store(uint64_t key, const TableEntry &entry, TableStats &stats)
+{
+    ++stats.stores;
+    Bucket &bucket = buckets[key & bucketMask];
+
+    Entry *target = nullptr;
+    int targetScore = 0;
+    bool isEvicting = false;
+    for (Entry &candidate : bucket.entries) {
+        const uint64_t info = candidate.info.load(std::memory_order_relaxed);
+        const uint64_t candidateKey = candidate.check.load(std::memory_order_relaxed) ^
+            candidate.stats.load(std::memory_order_relaxed) ^ info;
+        if (!(info & kOccupiedBit) || candidateKey == key) {
+            target = &candidate;
+            isEvicting = false;
+            break;
+        }
+
+        const int score = get_replacement_score(info, generation);
+        if (target == nullptr || score < targetScore) {
+            target = &candidate;
+            targetScore = score;
+            isEvicting = true;
+        }
+    }
+
+    if (isEvicting)
+        ++stats.replacements;
+
+    // The check word goes last, a reader that catches the data words half written fails the key check
+    const uint64_t packedStats = pack_stats(entry);
+    const uint64_t info = pack_info(entry, generation);
+    target->stats.store(packedStats, std::memory_order_relaxed);
+    target->info.store(info, std::memory_order_relaxed);
+    target->check.store(key ^ packedStats ^ info, std::memory_order_relaxed);
+}
+
+void TranspositionTable::clear()
+{
+    for (size_t bucket = 0; bucket <= bucketMask; ++bucket) {
+        for (Entry &entry : buckets[bucket].entries) {
+            entry.check.store(0, std::memory_order_relaxed);
+            entry.stats.store(0, std::memory_order_relaxed);
+            entry.info.store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+double TranspositionTable::get_fill_rate() const
+{
+    const size_t sampledBuckets = std::min(kFillSampleBuckets, get_bucket_count());
+    size_t filled = 0;
+    for (size_t bucket = 0; bucket < sampledBuckets; ++bucket) {
+        for (const Entry &entry : buckets[bucket].entries) {
+            const uint64_t info = entry.info.load(std::memory_order_relaxed);
+            filled += (info & kOccupiedBit) && get_generation(info) == generation;
+        }
+    }
+    return double(filled) / double(sampledBuckets * kEntriesPerBucket);
+}
+} // transposition_table
+} // game_data